@@ -347,11 +347,6 @@ bool Oscilloscope::allowChange(const nds::state_t, const nds::state_t, const nds
 ////////////////////////////////////////////////////////////////////////////////
 void Oscilloscope::acquireSinusoidalWave()
 {
-    // Let's allocate a vector that will contain the data that we will push to the
-    //  control system
-    ////////////////////////////////////////////////////////////////////////////////
-    std::vector<std::int32_t> outputData(m_acquisitionSinWave.getMaxElements());
-
     // A counter for the angle in the sin() operation
     ////////////////////////////////////////////////////////////////////////////////
     std::int64_t angle(0);
@@ -360,6 +355,12 @@ void Oscilloscope::acquireSinusoidalWave()
     ////////////////////////////////////////////////////////////////////////////////
     while(!m_bStopAcquisitionSinWave)
     {
+        // Lease a vector from the node's buffer pool: the pool allocates new vectors
+        //  only while the control system still holds all the previous ones
+        ////////////////////////////////////////////////////////////////////////////////
+        std::shared_ptr<std::vector<std::int32_t> > pOutputData(m_acquisitionSinWave.lease());
+        std::vector<std::int32_t>& outputData(*pOutputData);
+
         // Fill the vector with a sin wave
         ////////////////////////////////////////////////////////////////////////////////
         size_t maxAmplitude = m_sinWaveAmplitude.getValue(); // PVVariables are thread safe
@@ -368,9 +369,9 @@ void Oscilloscope::acquireSinusoidalWave()
             outputData[scanVector] = (double)maxAmplitude * sin((double)(angle++) / 10.0f);
         }
 
-        // Push the vector to the control system
+        // Push the vector to the control system without copying it
         ////////////////////////////////////////////////////////////////////////////////
-        m_acquisitionSinWave.push(m_acquisitionSinWave.getTimestamp(), outputData);
+        m_acquisitionSinWave.commit(m_acquisitionSinWave.getTimestamp(), pOutputData);
 
         // Rest for a while
         ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,134 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSARCHIVEREADER_H
+#define NDSARCHIVEREADER_H
+
+/**
+ * @file archiveReader.h
+ *
+ * @brief Defines the nds::ArchiveReader class, which reads the archive files
+ *        written by PVBaseIn::setArchive().
+ *
+ * Include nds.h instead of this one, since nds3.h takes care of including all the
+ * necessary header files (including this one).
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "nds3/definitions.h"
+
+namespace nds
+{
+
+class ArchiveReaderImpl;
+
+/**
+ * @ingroup datareadwrite
+ * @brief Reads the frames stored in an archive file by PVBaseIn::setArchive().
+ *
+ * The file is mapped read-only, so it can be read by another process while the
+ *  device is still writing into it. Each frame has a number, counted from the
+ *  creation of the file: the archive keeps the last getNumFrames() frames.
+ *
+ * Example:
+ * @code
+ * nds::ArchiveReader reader("/data/channel1.arc");
+ * std::vector<timespec> timestamps;
+ * std::vector<std::vector<std::int32_t> > frames;
+ * reader.readLast(100, &timestamps, &frames);
+ * @endcode
+ */
+class NDS3_API ArchiveReader
+{
+public:
+    /**
+     * @brief Opens an archive file.
+     *
+     * Throws ArchiveError if the file cannot be opened or is not an archive
+     *  file.
+     *
+     * @param fileName the name of the archive file
+     */
+    ArchiveReader(const std::string& fileName);
+
+    ~ArchiveReader();
+
+    /**
+     * @brief Returns the full name of the archived PV.
+     *
+     * @return the name of the PV that wrote the archive
+     */
+    std::string getPVName() const;
+
+    /**
+     * @brief Returns the data type of the archived PV.
+     *
+     * @return the data type of the archived values
+     */
+    dataType_t getDataType() const;
+
+    /**
+     * @brief Returns the number of elements reserved for each frame. Longer
+     *        values have been truncated.
+     *
+     * @return the maximum number of elements in a frame
+     */
+    size_t getMaxElements() const;
+
+    /**
+     * @brief Returns the number of frames that the archive can hold.
+     *
+     * @return the capacity of the archive, in frames
+     */
+    size_t getNumFrames() const;
+
+    /**
+     * @brief Returns the number of frames written since the creation of the
+     *        archive. The last ones may still be in progress.
+     *
+     * @return the number of the next frame that will be written
+     */
+    std::uint64_t getWrittenCount() const;
+
+    /**
+     * @brief Reads a frame.
+     *
+     * @tparam T         the data type of the archived PV. Throws ArchiveError
+     *                   if it doesn't match getDataType()
+     * @param frame      the frame number, between 0 and getWrittenCount() - 1
+     * @param pTimestamp filled with the timestamp of the frame
+     * @param pValue     filled with the value of the frame
+     * @return false if the frame is still being written or has been
+     *         overwritten by a newer one
+     */
+    template<typename T>
+    bool read(const std::uint64_t frame, timespec* pTimestamp, T* pValue) const;
+
+    /**
+     * @brief Reads the last complete frames, from the oldest to the newest.
+     *
+     * @tparam T          the data type of the archived PV
+     * @param maxFrames   maximum number of frames to read
+     * @param pTimestamps filled with the timestamps of the frames
+     * @param pValues     filled with the values of the frames
+     */
+    template<typename T>
+    void readLast(const size_t maxFrames, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const;
+
+private:
+    ArchiveReader(const ArchiveReader&);
+    ArchiveReader& operator=(const ArchiveReader&);
+
+    std::shared_ptr<ArchiveReaderImpl> m_pImplementation;
+};
+
+}
+#endif // NDSARCHIVEREADER_H
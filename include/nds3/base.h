@@ -145,9 +145,13 @@ public:
      *
      * - if a custom time function has been declared with setTimestampDelegate() then the
      *   delegate function is called, or...
-     * - if this is not the root node then the parent node's getTimestamp() is called, or...
+     * - if a clock has been selected with setTimestampClock() then the clock is read, or...
+     * - if this is not the root node then the parent node's delegate or clock is used, or...
      * - if this is the parent node then the local machine's UTC time is returned.
      *
+     * The timestamp source is resolved when the node is initialized and when a
+     *  parent node changes its source, so the call does not visit the parent nodes.
+     *
      * @return the current time
      */
     timespec getTimestamp() const;
@@ -156,14 +160,31 @@ public:
      * @ingroup timestamp
      * @brief Specify the delegate function to call to get the timestamp.
      *
-     * If this method is not called then an internal function is called, which traverses
-     * all the parent nodes until the node with no parent returns the local time or
-     * call its own delegate function if specified.
+     * If this method is not called then the node uses the delegate or the clock of the
+     * closest parent node that specifies one, or the local time if no parent does.
+     *
+     * The delegate is also used by the children nodes that don't specify their own
+     * timestamp source. Pass an empty function to use the parent's source again.
      *
      * @param timestampDelegate the delegate function to call to get the timestamp
      */
     void setTimestampDelegate(getTimestampPlugin_t timestampDelegate);
 
+    /**
+     * @ingroup timestamp
+     * @brief Select the built-in clock used to get the timestamp for this node
+     *        and its children.
+     *
+     * Replaces the delegate set with setTimestampDelegate(). Clocks that are not
+     *  supported by the operating system fall back to timestampClock_t::realtime.
+     *
+     * The clock can be changed while other threads call getTimestamp(): they
+     *  switch to the new clock on their next call.
+     *
+     * @param clock the clock to use
+     */
+    void setTimestampClock(const timestampClock_t clock);
+
     /**
      * @ingroup logging
      * @brief Retrieve a logging stream for the specified log level.
@@ -93,6 +93,97 @@ public:
      */
     void setStartTimestampDelegate(getTimestampPlugin_t timestampDelegate);
 
+    /**
+     * @brief Set the deadband applied to the acquired data before it is passed
+     *        to the control system.
+     *
+     * See PVBaseIn::setDeadband().
+     *
+     * @param type     the kind of deadband
+     * @param deadband the minimum change that must be passed to the control system
+     */
+    void setDeadband(const deadbandType_t type, const double deadband);
+
+    /**
+     * @brief Set the maximum number of acquired values per second passed to the
+     *        control system.
+     *
+     * See PVBaseIn::setMaxPublishRate().
+     *
+     * @param maxRate the maximum number of values per second, or 0 for no limit
+     */
+    void setMaxPublishRate(const double maxRate);
+
+    /**
+     * @brief Declares that several threads push acquired data into the node
+     *        concurrently.
+     *
+     * See PVBaseIn::setMultiProducer().
+     *
+     * @param bMultiProducer true if several threads push into the node
+     */
+    void setMultiProducer(const bool bMultiProducer);
+
+    /**
+     * @brief Lets the node raise the decimation of the acquired data when the
+     *        port cannot deliver it fast enough.
+     *
+     * See PVBaseIn::setAdaptiveDecimation(). The factor selected by the
+     *  Decimation PV is the lowest one; the factor currently applied is
+     *  published by the EffectiveDecimation PV.
+     *
+     * @param maxDecimation the highest decimation factor, or 0 to disable the
+     *                      adaptive decimation
+     */
+    void setAdaptiveDecimation(const std::uint32_t maxDecimation);
+
+    /**
+     * @brief Records the acquired data into a circular archive file, for
+     *        offline analysis.
+     *
+     * See PVBaseIn::setArchive(). Each frame has room for the maximum number
+     *  of elements declared in the constructor. The archive can also be
+     *  controlled with the command "archive" on the Data PV, once
+     *  setArchiveDirectory() enables it.
+     *
+     * @param fileName  the name of the archive file
+     * @param numFrames the number of frames kept in the file. 0 closes the archive
+     */
+    void setArchive(const std::string& fileName, const size_t numFrames);
+
+    /**
+     * @brief Selects the directory where the command "archive" creates the
+     *        archive files.
+     *
+     * See PVBaseIn::setArchiveDirectory().
+     *
+     * @param directory the directory for the archive files, or an empty string
+     *                  to reject the command (default)
+     */
+    void setArchiveDirectory(const std::string& directory);
+
+    /**
+     * @brief Add a Display PV that receives a downsampled copy of the acquired
+     *        data, sized for the operator displays.
+     *
+     * Each array pushed to the Data PV is reduced to at most targetSize
+     *  elements and pushed to the Display PV in the same thread. The Data PV
+     *  still receives the full resolution arrays.
+     *
+     * The first call adds the Display PV to the node and must happen before
+     *  the node is initialized. Later calls change the downsampling while the
+     *  acquisition runs. Scalar and string data is copied unchanged.
+     *
+     * Throws std::logic_error if targetSize is smaller than 3: the largest
+     *  triangle three buckets keeps the first and the last elements plus at
+     *  least one bucket, and the min/max envelope needs a pair per bucket.
+     *
+     * @param mode       the downsampling algorithm
+     * @param targetSize the maximum number of elements pushed to the Display PV,
+     *                   at least 3
+     */
+    void setDisplayDownsampling(const downsamplingMode_t mode, const size_t targetSize);
+
     /**
      * @ingroup datareadwrite
      * @brief Push acquired data to the control system.
@@ -105,6 +196,80 @@ public:
      */
     void push(const timespec& timestamp, const T& data);
 
+    /**
+     * @ingroup datareadwrite
+     * @brief Push a shared immutable buffer to the control system without copying it.
+     *
+     * The control system, the subscribed output PVs and the replication destinations
+     *  receive a reference to the same buffer. The buffer must not be modified after
+     *  the call.
+     *
+     * @param timestamp the timestamp for the data
+     * @param pData     pointer to the data to push to the control system
+     */
+    void push(const timespec& timestamp, const std::shared_ptr<const T>& pData);
+
+#ifndef SWIG
+    /**
+     * @ingroup datareadwrite
+     * @brief Push a transient buffer to the control system, transferring its
+     *        ownership to NDS.
+     *
+     * The data is moved into the buffer shared with the control system and the
+     *  subscribers, so it is never copied. data is left in a valid but
+     *  unspecified state.
+     *
+     * @param timestamp the timestamp for the data
+     * @param data      the data to push to the control system
+     */
+    void push(const timespec& timestamp, T&& data);
+#endif
+
+    /**
+     * @ingroup datareadwrite
+     * @brief Push acquired samples stored in a contiguous buffer, e.g. a DMA
+     *        buffer, to the control system.
+     *
+     * Available when T is a vector of E. The samples don't have to be copied
+     *  into a vector first and the buffer can be reused as soon as the
+     *  function returns.
+     *
+     * @tparam E        the type of the samples
+     * @param timestamp the timestamp for the data
+     * @param pData     pointer to the first sample
+     * @param count     number of samples in the buffer. An exception
+     *                  MaxElementsExceeded is thrown if it is bigger than
+     *                  getMaxElements()
+     */
+    template<typename E>
+    void push(const timespec& timestamp, const E* pData, size_t count);
+
+    /**
+     * @ingroup datareadwrite
+     * @brief Lease a writable buffer from the node's buffer pool.
+     *
+     * Array buffers are sized to getMaxElements(). Fill the buffer and push it
+     *  with commit(): the buffer returns to the pool once the control system and
+     *  all the subscribers have released it, so an acquisition loop that uses
+     *  lease() and commit() stops allocating memory once it reaches steady state.
+     *
+     * @return a writable buffer
+     */
+    std::shared_ptr<T> lease();
+
+    /**
+     * @ingroup datareadwrite
+     * @brief Push a buffer obtained from lease() to the control system.
+     *
+     * The buffer is shared with the control system and the subscribers without
+     *  being copied. pBuffer is reset by the call: the buffer must not be
+     *  modified after it has been committed.
+     *
+     * @param timestamp the timestamp for the data
+     * @param pBuffer   the buffer returned by lease()
+     */
+    void commit(const timespec& timestamp, std::shared_ptr<T>& pBuffer);
+
     /**
      * @brief Retrieve the desidered acquisition frequency, in Hertz.
      *
@@ -148,6 +313,16 @@ public:
      */
     size_t getDecimation();
 
+    /**
+     * @brief Retrieve the desidered decimation mode, applied to the acquired
+     *        data when the acquisition starts.
+     *
+     * See PVBaseIn::setDecimationMode().
+     *
+     * @return the decimation mode
+     */
+    decimationMode_t getDecimationMode();
+
     /**
      * @brief Retrieve the desidered sampling mode value.
      *
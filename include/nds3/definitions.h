@@ -26,6 +26,7 @@
 #include <list>
 #include <vector>
 #include <map>
+#include <utility>
 
 namespace nds
 {
@@ -72,6 +73,80 @@ enum class scanType_t
     interrupt ///< The device server pushes the value to the control system when it changes
 };
 
+/**
+ * @brief Specify what happens to a pushed value when the port's dispatch queue
+ *        is full.
+ *
+ * Applies only to the ports that deliver the values asynchronously (see
+ *  Port::setDispatchQueueSize()).
+ */
+enum class pushPolicy_t
+{
+    block,      ///< The pushing thread waits for a free slot. The values are never discarded
+    dropOldest, ///< The oldest queued value of a non-blocking PV is discarded. If the queue holds only
+                ///<  values that cannot be discarded, the value being pushed is discarded instead
+    dropNewest, ///< The value being pushed is discarded
+    keepLatest, ///< Only the latest pushed value waits for delivery, older ones are discarded. If the
+                ///<  queue is full the value waits outside of it, as with conflate
+    conflate    ///< Only the latest pushed value waits for delivery, outside the queue: the dispatcher
+                ///<  delivers it on its next pass and the pushing thread never waits
+};
+
+/**
+ * @brief Specify how the values pushed during a decimation interval are
+ *        combined into the value passed to the control system.
+ *
+ * Arrays are combined element by element. String PVs are always sampled.
+ */
+enum class decimationMode_t
+{
+    sample,   ///< Only the last value of the interval is passed. The other values are discarded
+    average,  ///< The average of the values pushed during the interval
+    minimum,  ///< The minimum of the values pushed during the interval
+    maximum,  ///< The maximum of the values pushed during the interval
+    peakHold  ///< The maximum of all the values pushed since the mode was selected
+};
+
+/**
+ * @brief Specify when a pushed value differs enough from the last value passed
+ *        to the control system to be passed too.
+ *
+ * Arrays pass the deadband when any of their elements passes it. String PVs
+ *  are not filtered.
+ */
+enum class deadbandType_t
+{
+    none,     ///< All the values are passed
+    absolute, ///< The difference must be bigger than the deadband
+    relative  ///< The difference must be bigger than the deadband multiplied by the last passed value
+};
+
+/**
+ * @brief Specify how an array is reduced to the size of a display.
+ */
+enum class downsamplingMode_t
+{
+    minMax, ///< The array is split in buckets, each bucket is replaced by its minimum and maximum values
+    lttb    ///< Largest triangle three buckets: one representative point is selected from each bucket
+};
+
+/**
+ * @ingroup timing
+ * @brief Specify the clock used by getTimestamp() when no timestamp delegate
+ *        has been set.
+ *
+ * All the clocks return the time from the UNIX epoch.
+ */
+enum class timestampClock_t
+{
+    realtime,       ///< The system time (CLOCK_REALTIME). This is the default clock
+    tai,            ///< International Atomic Time (CLOCK_TAI): not affected by leap seconds
+    monotonicRaw,   ///< CLOCK_MONOTONIC_RAW plus the offset to the system time measured when
+                    ///<  the clock is selected: never jumps, not slewed by NTP
+    realtimeCoarse  ///< The system time with the resolution of a scheduler tick
+                    ///<  (CLOCK_REALTIME_COARSE): much faster, for high rate pushes
+};
+
 
 /**
  * @ingroup logging
@@ -203,6 +278,15 @@ enum class outputPvType_t
  */
 typedef std::vector<std::string> parameters_t;
 
+/**
+ * @brief Ranges of array elements that changed since the previous value passed
+ *        to the control system.
+ *
+ * Each pair holds the index of the first changed element and the number of
+ *  consecutive changed elements. The ranges are sorted and do not overlap.
+ */
+typedef std::vector<std::pair<size_t, size_t> > changedRanges_t;
+
 /**
  * @brief Definition of a function called to execute a node's command.
  *
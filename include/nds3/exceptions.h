@@ -122,6 +122,32 @@ public:
 };
 
 
+/**
+ * @brief This exception is thrown when the device pushes more elements than
+ *        the maximum number of elements declared for the PV.
+ *
+ * See PVBase::setMaxElements().
+ */
+class NDS3_API MaxElementsExceeded: public NdsError
+{
+public:
+    MaxElementsExceeded(const std::string& what);
+};
+
+
+/**
+ * @brief This exception is thrown when an archive file cannot be created,
+ *        opened or read.
+ *
+ * See PVBaseIn::setArchive() and ArchiveReader.
+ */
+class NDS3_API ArchiveError: public NdsError
+{
+public:
+    ArchiveError(const std::string& what);
+};
+
+
 /**
  * @brief This is the base class for exceptions thrown by the NDS Factory.
  *        Usually it is thrown while allocating new control system structures.
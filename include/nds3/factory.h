@@ -138,6 +138,23 @@ public:
      */
     void subscribe(const std::string& pushFrom, const std::string& pushTo);
 
+    /**
+     * @brief Push the data from an input PV to an output PV, skipping values
+     *        on this link only.
+     *
+     * A slow receiver can get a reduced stream: the decimation and the rate limit
+     *  are applied to this link only and the skipped values are not written to
+     *  the output PV. Subscribing an already subscribed PV replaces the settings
+     *  of its link.
+     *
+     * @param pushFrom   the full name of the input PV from which the data must be pushed
+     * @param pushTo     the full name of the output PV to which the data must be pushed
+     * @param decimation the output PV receives one value every decimation values
+     * @param maxRate    maximum number of values per second written to the output PV.
+     *                   0 means no limit
+     */
+    void subscribe(const std::string& pushFrom, const std::string& pushTo, const std::uint32_t decimation, const double maxRate);
+
     /**
      * @brief Unsubscribe an output PV from the input PV.
      * @param pushTo the name of the receiving PV that must be unsubscribed
@@ -158,6 +175,21 @@ public:
      */
     void replicate(const std::string& replicateSource, const std::string& replicateDestination);
 
+    /**
+     * @brief Replicate an input PV to another input PV, skipping values on
+     *        this link only.
+     *
+     * The decimation and the rate limit are applied to this link only, before
+     *  the destination applies its own settings.
+     *
+     * @param replicateSource      the full name of the input PV from which the data is replicated
+     * @param replicateDestination the full name of the input PV to which the data must be copied
+     * @param decimation           the destination receives one value every decimation values
+     * @param maxRate              maximum number of values per second pushed to the destination.
+     *                             0 means no limit
+     */
+    void replicate(const std::string& replicateSource, const std::string& replicateDestination, const std::uint32_t decimation, const double maxRate);
+
     /**
      * @brief Stop the replication to the specified PV.
      *
@@ -0,0 +1,189 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSARCHIVEIMPL_H
+#define NDSARCHIVEIMPL_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <time.h>
+#include "nds3/definitions.h"
+
+namespace nds
+{
+
+/**
+ * @brief Layout of the header at the beginning of an archive file.
+ *
+ * The header is followed by the index (one archiveIndexEntry_t per frame) and
+ *  by the data area (maxElements * elementSize bytes per frame). All the
+ *  offsets are in bytes from the beginning of the file.
+ */
+struct archiveHeader_t
+{
+    char m_magic[8];                          ///< "NDS3ARC" followed by a zero
+    std::uint32_t m_version;                  ///< Version of the layout
+    std::uint32_t m_dataType;                 ///< The dataType_t of the archived PV
+    std::uint64_t m_elementSize;              ///< Bytes in each element
+    std::uint64_t m_maxElements;              ///< Elements reserved for each frame
+    std::uint64_t m_numFrames;                ///< Number of frames in the ring
+    std::uint64_t m_indexOffset;              ///< Offset of the index
+    std::uint64_t m_dataOffset;               ///< Offset of the data area
+    std::uint64_t m_fileSize;                 ///< Size of the file
+    char m_pvName[256];                       ///< Full name of the archived PV, zero terminated
+    std::atomic<std::uint64_t> m_claimedFrames; ///< Frames claimed by the writers so far
+};
+
+/**
+ * @brief Layout of an index entry. There is one entry per slot of the ring.
+ *
+ * m_sequence is 2 * frame + 1 while a writer stores the frame in the slot and
+ *  2 * frame + 2 when the frame is complete, so a reader can tell which frame
+ *  the slot holds and whether it was overwritten during the copy.
+ */
+struct archiveIndexEntry_t
+{
+    std::atomic<std::uint64_t> m_sequence;    ///< Frame held by the slot and its state
+    std::atomic<std::int64_t> m_seconds;      ///< Seconds of the frame timestamp
+    std::atomic<std::int64_t> m_nanoseconds;  ///< Nanoseconds of the frame timestamp
+    std::atomic<std::uint64_t> m_count;       ///< Number of elements in the frame
+};
+
+/**
+ * @brief Writes the values pushed into a PV into a circular archive file.
+ *
+ * The file is created with its final size and mapped in memory by the
+ *  constructor: recording a frame claims a slot with an atomic increment and
+ *  copies the value into the mapped memory, without locks and without system
+ *  calls. The kernel writes the modified pages to the disk in the background.
+ *
+ * When the ring is full the oldest frames are overwritten.
+ */
+class ArchiveWriterImpl
+{
+public:
+    /**
+     * @brief Creates the archive file and maps it in memory.
+     *
+     * The file is prepared under a temporary name and then renamed, so a
+     *  reader never sees a partially initialized file. An existing file with
+     *  the same name is replaced.
+     *
+     * @param fileName    name of the archive file
+     * @param pvName      name of the archived PV, stored in the header
+     * @param dataType    the data type of the archived PV
+     * @param numFrames   number of frames in the ring
+     * @param maxElements maximum number of elements in a frame. The extra
+     *                    elements are not archived
+     * @param elementSize the size of an element, in bytes
+     */
+    ArchiveWriterImpl(const std::string& fileName, const std::string& pvName, const dataType_t dataType, const size_t numFrames, const size_t maxElements, const size_t elementSize);
+
+    ~ArchiveWriterImpl();
+
+    /**
+     * @brief Stores a frame in the next slot of the ring.
+     *
+     * @param timestamp the timestamp of the value
+     * @param pData     pointer to the first element
+     * @param count     number of elements
+     */
+    void record(const timespec& timestamp, const void* pData, size_t count);
+
+    const std::string& getFileName() const;
+
+private:
+    ArchiveWriterImpl(const ArchiveWriterImpl&);
+    ArchiveWriterImpl& operator=(const ArchiveWriterImpl&);
+
+    std::string m_fileName;          ///< Name of the archive file
+    std::uint8_t* m_pFile;           ///< The mapped file
+    size_t m_fileSize;               ///< Size of the mapping
+    archiveHeader_t* m_pHeader;      ///< The header, at the beginning of m_pFile
+    archiveIndexEntry_t* m_pIndex;   ///< The index
+    std::uint8_t* m_pData;           ///< The data area
+    size_t m_numFrames;              ///< Number of frames in the ring
+    size_t m_maxElements;            ///< Elements reserved for each frame
+    size_t m_elementSize;            ///< Bytes in each element
+};
+
+/**
+ * @brief Reads the frames from an archive file, also while a writer is still
+ *        adding frames to it.
+ *
+ * The file is mapped read-only. Frames that a writer overwrites while they are
+ *  being copied are detected and skipped.
+ */
+class ArchiveReaderImpl
+{
+public:
+    /**
+     * @brief Opens and maps the archive file.
+     *
+     * Throws ArchiveError if the file cannot be opened or is not an archive.
+     *
+     * @param fileName name of the archive file
+     */
+    ArchiveReaderImpl(const std::string& fileName);
+
+    ~ArchiveReaderImpl();
+
+    std::string getPVName() const;
+
+    dataType_t getDataType() const;
+
+    size_t getMaxElements() const;
+
+    size_t getNumFrames() const;
+
+    std::uint64_t getClaimedFrames() const;
+
+    /**
+     * @brief Copies a frame.
+     *
+     * @tparam T         the type of the archived values. Throws ArchiveError if
+     *                   it doesn't match the type of the archived PV
+     * @param frame      the frame number, counted from the creation of the file
+     * @param pTimestamp filled with the timestamp of the frame
+     * @param pValue     filled with the value of the frame
+     * @return false if the frame has not been written yet or has been
+     *         overwritten
+     */
+    template<typename T>
+    bool read(const std::uint64_t frame, timespec* pTimestamp, T* pValue) const;
+
+    /**
+     * @brief Copies the last complete frames, from the oldest to the newest.
+     *
+     * @tparam T          the type of the archived values
+     * @param maxFrames   maximum number of frames to copy
+     * @param pTimestamps filled with the timestamps of the frames
+     * @param pValues     filled with the values of the frames
+     */
+    template<typename T>
+    void readLast(const size_t maxFrames, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const;
+
+private:
+    ArchiveReaderImpl(const ArchiveReaderImpl&);
+    ArchiveReaderImpl& operator=(const ArchiveReaderImpl&);
+
+    const std::uint8_t* m_pFile;          ///< The mapped file
+    size_t m_fileSize;                    ///< Size of the mapping
+    const archiveHeader_t* m_pHeader;     ///< The header, at the beginning of m_pFile
+    const archiveIndexEntry_t* m_pIndex;  ///< The index
+    const std::uint8_t* m_pData;          ///< The data area
+    size_t m_numFrames;                   ///< Number of frames in the ring
+    size_t m_maxElements;                 ///< Elements reserved for each frame
+    size_t m_elementSize;                 ///< Bytes in each element
+};
+
+}
+#endif // NDSARCHIVEIMPL_H
@@ -10,7 +10,9 @@
 #ifndef NDSBASEIMPL_H
 #define NDSBASEIMPL_H
 
+#include <atomic>
 #include <string>
+#include <vector>
 #include <map>
 #include <memory>
 #include <array>
@@ -112,16 +114,44 @@ public:
      * @brief Return the current time.
      *
      * If a delegate function has been defined with setTimestampDelegate() then call
-     *  the delegated function, otherwise call the parent node's getTimestamp().
-     * If the node has no parent then return the current time as reported by the
+     *  the delegated function, otherwise use the delegate or the clock of the
+     *  closest parent node that defines one.
+     * If no node defines them then return the current time as reported by the
      *  operating system.
      *
+     * The source is resolved by resolveTimestampSource(), so the parent nodes are
+     *  not visited on each call. The timestamp source can be changed while
+     *  other threads call this function.
+     *
      * @return the current time
      */
     timespec getTimestamp() const;
 
+    /**
+     * @brief Set the function that returns the timestamps for this node and its
+     *        children. Removes the clock selected with setTimestampClock().
+     *
+     * @param timestampDelegate the function to call, or an empty function to
+     *                          use the parent's timestamp source again
+     */
     void setTimestampDelegate(getTimestampPlugin_t timestampDelegate);
 
+    /**
+     * @brief Select the clock that returns the timestamps for this node and its
+     *        children. Removes the delegate set with setTimestampDelegate().
+     *
+     * @param clock the clock to use
+     */
+    void setTimestampClock(const timestampClock_t clock);
+
+    /**
+     * @brief Copy the timestamp source from this node or from its parent.
+     *
+     * Called during the initialization and when a timestamp source changes:
+     *  nodes also resolve the source of their children.
+     */
+    virtual void resolveTimestampSource();
+
     ThreadBaseImpl* runInThread(const std::string& name, threadFunction_t function);
 
     /**
@@ -185,7 +215,14 @@ public:
     virtual std::string buildFullExternalNameFromPort(const FactoryBaseImpl& controlSystem) const = 0;
 
 protected:
-    timespec getLocalTimestamp() const;
+    /**
+     * @brief Read one of the built-in clocks.
+     *
+     * @param clock        the clock to read
+     * @param clockOffset  nanoseconds added to CLOCK_MONOTONIC_RAW
+     * @return the current time
+     */
+    static timespec readTimestampClock(const timestampClock_t clock, const std::int64_t clockOffset);
 
     /**
      * @brief User command that set the log level
@@ -217,7 +254,32 @@ protected:
 
     FactoryBaseImpl* m_pFactory;
 
-    getTimestampPlugin_t m_timestampFunction;
+    getTimestampPlugin_t m_timestampFunction;   ///< Set by setTimestampDelegate(), empty if not set
+    bool m_bTimestampClock;                     ///< True if setTimestampClock() has been called
+    timestampClock_t m_timestampClock;          ///< Set by setTimestampClock()
+    std::int64_t m_timestampClockOffset;        ///< Offset for timestampClock_t::monotonicRaw, in nanoseconds
+
+    /**
+     * @brief Timestamp source resolved from this node or from the parents.
+     *
+     * Never modified after it has been published: a new source replaces the
+     *  whole object, so the threads calling getTimestamp() keep using the
+     *  previous one until they load the pointer again. The replaced sources
+     *  are released only when the node is destroyed.
+     */
+    struct timestampSource_t
+    {
+        timestampSource_t(): m_clock(timestampClock_t::realtime), m_clockOffset(0)
+        {
+        }
+
+        getTimestampPlugin_t m_function; ///< The delegate function, empty if a clock is used
+        timestampClock_t m_clock;        ///< The clock used when m_function is empty
+        std::int64_t m_clockOffset;      ///< Offset for timestampClock_t::monotonicRaw, in nanoseconds
+    };
+
+    std::atomic<const timestampSource_t*> m_pTimestampSource;  ///< The published source, one of m_timestampSources
+    std::vector<std::unique_ptr<const timestampSource_t> > m_timestampSources; ///< The sources published so far
 
     volatile logLevel_t m_logLevel;
 
@@ -0,0 +1,69 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSBUFFERPOOLIMPL_H
+#define NDSBUFFERPOOLIMPL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "nds3/definitions.h"
+
+namespace nds
+{
+
+/**
+ * @brief Pool of reusable data buffers.
+ *
+ * The pool keeps a reference to every buffer it has allocated. A buffer is
+ *  considered free when the pool holds the only remaining reference to it, i.e.
+ *  when the device, the control system and all the subscribers have released it.
+ *
+ * Once the pool contains enough buffers to cover all the buffers in flight,
+ *  lease() stops allocating memory.
+ */
+template<typename T>
+class BufferPoolImpl
+{
+public:
+    /**
+     * @brief Constructs an empty pool.
+     *
+     * @param maxElements number of elements allocated in each leased array buffer
+     */
+    BufferPoolImpl(size_t maxElements);
+
+    /**
+     * @brief Returns a free buffer, allocating a new one if all the buffers are
+     *        in use.
+     *
+     * Array buffers are resized to the pool's maxElements before being returned.
+     *
+     * @return a writable buffer. The buffer returns to the pool when all its
+     *         references have been released
+     */
+    std::shared_ptr<T> lease();
+
+    /**
+     * @brief Returns the number of buffers allocated by the pool.
+     *
+     * @return the number of buffers owned by the pool, free or in use
+     */
+    size_t getSize();
+
+private:
+    size_t m_maxElements;
+
+    std::mutex m_lockBuffers;                   ///< Protects m_buffers and m_nextBuffer
+    std::vector<std::shared_ptr<T> > m_buffers; ///< All the buffers allocated by the pool
+    size_t m_nextBuffer;                        ///< Where lease() starts looking for a free buffer
+};
+
+}
+#endif // NDSBUFFERPOOLIMPL_H
@@ -0,0 +1,62 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSCHANGEDETECTORIMPL_H
+#define NDSCHANGEDETECTORIMPL_H
+
+#include <cstdint>
+#include <vector>
+#include "nds3/definitions.h"
+
+namespace nds
+{
+
+/**
+ * @brief Finds the elements of an array that changed since the previous array,
+ *        for the differential push.
+ *
+ * The elements are compared bit by bit, so a NaN equals itself and 0.0 differs
+ *  from -0.0. The arrays are compared in blocks with memcmp(), which uses the
+ *  vector instructions of the CPU: only the blocks that differ are scanned
+ *  element by element.
+ *
+ * The detector is not thread safe: the PV serializes the calls.
+ */
+class ChangeDetectorImpl
+{
+public:
+    ChangeDetectorImpl();
+
+    /**
+     * @brief Forgets the previous array: the next one is not compared.
+     */
+    void reset();
+
+    /**
+     * @brief Compares an array with the previous one, then keeps a copy of it
+     *        for the next comparison.
+     *
+     * @tparam E             the type of the elements
+     * @param pData          pointer to the first element
+     * @param count          number of elements
+     * @param changedRanges  receives the changed elements
+     * @return true if changedRanges lists the changes, false if the whole array
+     *         must be pushed: there is no previous array, the size changed or
+     *         more than half of the elements changed
+     */
+    template<typename E>
+    bool update(const E* pData, size_t count, changedRanges_t& changedRanges);
+
+private:
+    bool m_bHasLastValue;                  ///< false until the first update()
+    std::vector<std::uint8_t> m_lastValue; ///< The bytes of the previous array
+};
+
+}
+#endif // NDSCHANGEDETECTORIMPL_H
@@ -11,8 +11,11 @@
 #define NDSDATAACQUISITIONIMPL_H
 
 #include <memory>
+#include <atomic>
 #include "nds3/definitions.h"
 #include "nds3/impl/nodeImpl.h"
+#include "nds3/impl/bufferPoolImpl.h"
+#include "nds3/impl/downsamplerImpl.h"
 
 namespace nds
 {
@@ -46,14 +49,61 @@ public:
      */
     void setStartTimestampDelegate(getTimestampPlugin_t timestampDelegate);
 
+    void setDeadband(const deadbandType_t type, const double deadband);
+
+    void setMaxPublishRate(const double maxRate);
+
+    void setMultiProducer(const bool bMultiProducer);
+
+    void setAdaptiveDecimation(const std::uint32_t maxDecimation);
+
+    void setArchive(const std::string& fileName, const size_t numFrames);
+
+    void setArchiveDirectory(const std::string& directory);
+
+    /**
+     * @brief Selects the downsampling applied to the data pushed to the Display PV.
+     *
+     * The first call adds the Display PV to the node, so it must happen before
+     *  the node is initialized. Later calls change the downsampling while the
+     *  acquisition runs.
+     *
+     * @param mode       the downsampling algorithm
+     * @param targetSize the maximum number of elements pushed to the Display PV
+     */
+    void setDisplayDownsampling(const downsamplingMode_t mode, const size_t targetSize);
+
     void push(const timespec& timestamp, const T& data);
 
+    void push(const timespec& timestamp, const std::shared_ptr<const T>& pData);
+
+    void push(const timespec& timestamp, T&& data);
+
+    template<typename E>
+    void push(const timespec& timestamp, const E* pData, size_t count);
+
+    /**
+     * @brief Returns a writable buffer from the node's buffer pool.
+     *
+     * @return a buffer sized to maxElements
+     */
+    std::shared_ptr<T> lease();
+
+    /**
+     * @brief Pushes a buffer obtained from lease() and hands it back to the pool.
+     *
+     * @param timestamp the timestamp for the data
+     * @param pBuffer   the leased buffer. Reset by the function
+     */
+    void commit(const timespec& timestamp, std::shared_ptr<T>& pBuffer);
+
     double getFrequencyHz();
     double getDurationSeconds();
     double getAmplitude();
     double getOffset();
     size_t getMaxElements();
     size_t getDecimation();
+    decimationMode_t getDecimationMode();
     size_t getSamplingMode();
     size_t getGround();
 
@@ -73,7 +123,6 @@ public:
      */
     void onStart();
 
-
 protected:
     /**
      * @brief In the state machine we set the start function to onStart(), so we
@@ -97,17 +146,60 @@ protected:
      */
     timespec m_startTime;
 
+    /**
+     * @brief Buffers returned by lease(). They become available again when the
+     *        control system and the subscribers release them.
+     */
+    BufferPoolImpl<T> m_bufferPool;
+
+    std::atomic<downsamplingMode_t> m_displayMode; ///< Selected by setDisplayDownsampling()
+    std::atomic<size_t> m_displaySize;             ///< Selected by setDisplayDownsampling()
+    DownsamplerImpl m_downsampler;                 ///< Used by the push functions
+
+    std::atomic<std::int32_t> m_effectiveDecimation; ///< Last value pushed to the EffectiveDecimation PV
+
     // PVs
     std::shared_ptr<PVVariableInImpl<T> > m_dataPV;
+    std::shared_ptr<PVVariableInImpl<T> > m_displayPV; ///< Created by setDisplayDownsampling()
     std::shared_ptr<PVVariableOutImpl<double> > m_frequencyPV;
     std::shared_ptr<PVVariableOutImpl<double> > m_durationPV;
     std::shared_ptr<PVVariableOutImpl<double> > m_amplitudePV;
     std::shared_ptr<PVVariableOutImpl<double> > m_offsetPV;
     std::shared_ptr<PVVariableOutImpl<std::int32_t> > m_decimationPV;
+    std::shared_ptr<PVVariableOutImpl<std::int32_t> > m_decimationModePV;
+    std::shared_ptr<PVVariableInImpl<std::int32_t> > m_effectiveDecimationPV;
     std::shared_ptr<PVVariableOutImpl<std::int32_t> > m_samplingmodePV;
     std::shared_ptr<PVVariableOutImpl<std::int32_t> > m_groundPV;
     std::shared_ptr<StateMachineImpl> m_stateMachine;
 
+private:
+    /**
+     * @brief Pushes the decimation factor applied to the Data PV to the
+     *        EffectiveDecimation PV, if it changed since the last push.
+     *
+     * @param timestamp the timestamp of the acquired data
+     */
+    void publishEffectiveDecimation(const timespec& timestamp);
+
+    /**
+     * @brief Scalars and strings are pushed to the Display PV unchanged.
+     */
+    template<typename V>
+    void pushDisplay(const timespec& timestamp, const V& data);
+
+    template<typename E>
+    void pushDisplay(const timespec& timestamp, const std::vector<E>& data);
+
+    /**
+     * @brief Downsamples an array and pushes the result to the Display PV.
+     *
+     * @param timestamp the timestamp of the data
+     * @param pData     pointer to the first element
+     * @param count     number of elements
+     */
+    template<typename E>
+    void pushDisplay(const timespec& timestamp, const E* pData, size_t count);
+
 
 
 };
@@ -0,0 +1,67 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSDEADBANDIMPL_H
+#define NDSDEADBANDIMPL_H
+
+#include <vector>
+#include "nds3/definitions.h"
+
+namespace nds
+{
+
+/**
+ * @brief Decides if a value differs enough from the last value passed to the
+ *        control system, as specified by a deadbandType_t.
+ *
+ * Arrays are compared element by element: an array passes the deadband when
+ *  any element passes it. The comparison scans the elements in blocks without
+ *  branches, so the compiler vectorizes it.
+ *
+ * The filter is not thread safe: it is used only by the thread that pushes
+ *  the data.
+ */
+class DeadbandImpl
+{
+public:
+    DeadbandImpl();
+
+    /**
+     * @brief Selects the deadband and forgets the last passed value: the next
+     *        value always passes.
+     *
+     * @param type     the kind of deadband
+     * @param deadband the deadband. For deadbandType_t::relative it is a fraction
+     *                 of the last passed value
+     */
+    void reset(const deadbandType_t type, const double deadband);
+
+    /**
+     * @brief Compares a value with the last passed one. If the value passes the
+     *        deadband then it becomes the new reference.
+     *
+     * A value with a different number of elements always passes.
+     *
+     * @tparam E      the type of the elements
+     * @param pData   pointer to the first element
+     * @param count   number of elements
+     * @return true if the value must be passed to the control system
+     */
+    template<typename E>
+    bool update(const E* pData, size_t count);
+
+private:
+    deadbandType_t m_type;           ///< Kind of comparison
+    double m_deadband;               ///< Absolute value or fraction of the last value
+    bool m_bHasLastValue;            ///< false until a value has passed the deadband
+    std::vector<double> m_lastValue; ///< The last value that passed the deadband
+};
+
+}
+#endif // NDSDEADBANDIMPL_H
@@ -0,0 +1,85 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSDECIMATORIMPL_H
+#define NDSDECIMATORIMPL_H
+
+#include <cstdint>
+#include <vector>
+#include "nds3/definitions.h"
+
+namespace nds
+{
+
+/**
+ * @brief Combines element by element the values pushed during a decimation
+ *        interval, as specified by a decimationMode_t.
+ *
+ * The accumulator is stored in double precision for all the element types:
+ *  the sums of 32 bit integers cannot overflow and the minimum and maximum
+ *  values are exact. The kernels are plain loops over contiguous memory that
+ *  the compiler vectorizes.
+ *
+ * The decimator is not thread safe: it is used only by the thread that
+ *  pushes the data.
+ */
+class DecimatorImpl
+{
+public:
+    DecimatorImpl();
+
+    /**
+     * @brief Selects the combination to apply and discards the accumulated values.
+     *
+     * @param mode the combination to apply
+     */
+    void reset(const decimationMode_t mode);
+
+    decimationMode_t getMode() const;
+
+    /**
+     * @brief Combines a value with the ones already accumulated.
+     *
+     * If the number of elements differs from the accumulated ones then the
+     *  accumulation restarts from the new value.
+     *
+     * @tparam E      the type of the elements
+     * @param pData   pointer to the first element
+     * @param count   number of elements
+     */
+    template<typename E>
+    void accumulate(const E* pData, size_t count);
+
+    /**
+     * @brief Returns the number of elements written by getResult().
+     *
+     * @return the number of accumulated elements
+     */
+    size_t getSize() const;
+
+    /**
+     * @brief Writes the combined values and starts a new interval.
+     *
+     * In peakHold mode the maximum values are kept for the next intervals.
+     *
+     * @tparam E     the type of the elements
+     * @param pData  pointer to a buffer of getSize() elements. Integer averages
+     *               are rounded to the nearest value
+     */
+    template<typename E>
+    void getResult(E* pData);
+
+private:
+    decimationMode_t m_mode;            ///< Combination applied by accumulate()
+    std::vector<double> m_accumulator;  ///< Sums, minimum or maximum values
+    std::uint32_t m_numValues;          ///< Values combined in m_accumulator
+};
+
+}
+#endif // NDSDECIMATORIMPL_H
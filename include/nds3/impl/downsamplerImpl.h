@@ -0,0 +1,58 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSDOWNSAMPLERIMPL_H
+#define NDSDOWNSAMPLERIMPL_H
+
+#include <vector>
+#include "nds3/definitions.h"
+
+namespace nds
+{
+
+/**
+ * @brief Reduces an array to a small number of elements that preserve its
+ *        shape on a display, as specified by a downsamplingMode_t.
+ *
+ * The minimum and maximum values and the triangle areas are computed in
+ *  fixed size blocks by branch-free loops that the compiler vectorizes.
+ *
+ * The downsampler keeps no state between two arrays, so several threads can
+ *  use it concurrently.
+ */
+class DownsamplerImpl
+{
+public:
+    /**
+     * @brief Writes the downsampled array.
+     *
+     * Arrays that are not bigger than the target size are copied unchanged.
+     *
+     * @tparam E         the type of the elements
+     * @param mode       the downsampling algorithm
+     * @param targetSize the maximum number of elements written to output, at
+     *                   least 3. The minMax mode writes an even number of
+     *                   elements
+     * @param pData      pointer to the first element of the array
+     * @param count      number of elements in the array
+     * @param output     receives the downsampled elements
+     */
+    template<typename E>
+    void downsample(const downsamplingMode_t mode, const size_t targetSize, const E* pData, size_t count, std::vector<E>& output);
+
+private:
+    template<typename E>
+    void minMax(const size_t targetSize, const E* pData, size_t count, std::vector<E>& output);
+
+    template<typename E>
+    void largestTriangle(const size_t targetSize, const E* pData, size_t count, std::vector<E>& output);
+};
+
+}
+#endif // NDSDOWNSAMPLERIMPL_H
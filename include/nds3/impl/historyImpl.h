@@ -0,0 +1,118 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSHISTORYIMPL_H
+#define NDSHISTORYIMPL_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <time.h>
+
+namespace nds
+{
+
+/**
+ * @brief Keeps the last values pushed into a PV, with their timestamps.
+ *
+ * The values are stored in a ring of fixed capacity, allocated by reset():
+ *  the elements of all the values live in a single slab with room for the
+ *  maximum number of elements in each slot, so recording a value costs one
+ *  memcpy and no allocations. When the ring is full the oldest value is
+ *  overwritten.
+ *
+ * The history is thread safe: values can be recorded by several threads
+ *  while others query them. A query holds the lock only while it selects the
+ *  slots; the elements are copied after the lock is released and a sequence
+ *  number per slot discards the values overwritten during the copy, so a
+ *  large query doesn't delay record().
+ */
+class HistoryImpl
+{
+public:
+    HistoryImpl();
+
+    /**
+     * @brief Allocates the ring and discards the recorded values.
+     *
+     * @param depth       the number of values kept. 0 releases the memory
+     * @param maxElements maximum number of elements in a value. The extra
+     *                    elements are not recorded
+     * @param elementSize the size of an element, in bytes
+     */
+    void reset(const size_t depth, const size_t maxElements, const size_t elementSize);
+
+    /**
+     * @brief Returns the number of values that the ring can keep.
+     *
+     * @return the depth specified in reset()
+     */
+    size_t getDepth() const;
+
+    /**
+     * @brief Records a value, replacing the oldest one when the ring is full.
+     *
+     * @param timestamp the timestamp of the value
+     * @param pData     pointer to the first element
+     * @param count     number of elements
+     */
+    void record(const timespec& timestamp, const void* pData, size_t count);
+
+    /**
+     * @brief Copies the recorded values with a timestamp in a range, from the
+     *        oldest to the newest.
+     *
+     * @tparam T           the type of the values: std::int32_t, double, a
+     *                     vector of the elements or std::string
+     * @param from         the oldest timestamp to return
+     * @param to           the newest timestamp to return
+     * @param maxValues    maximum number of values to return: the newest ones
+     *                     are returned
+     * @param pTimestamps  filled with the timestamps of the values
+     * @param pValues      filled with the values
+     */
+    template<typename T>
+    void get(const timespec& from, const timespec& to, size_t maxValues, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const;
+
+private:
+    /**
+     * @brief A recorded value: the elements are stored in the slab.
+     */
+    struct entry_t
+    {
+        timespec m_timestamp;                 ///< Timestamp of the value
+        size_t m_count;                       ///< Number of elements in the slab
+        std::atomic<std::uint64_t> m_sequence; ///< Odd while record() copies the elements into the slot
+    };
+
+    /**
+     * @brief The memory allocated by reset(). A query keeps it alive while it
+     *        copies the elements, also if reset() replaces it meanwhile.
+     */
+    struct storage_t
+    {
+        storage_t(const size_t depth, const size_t slotSize);
+
+        std::vector<std::uint8_t> m_slab; ///< The elements of all the values
+        std::vector<entry_t> m_entries;   ///< One entry per slot of the ring
+    };
+
+    size_t m_maxElements;                 ///< Elements reserved in the slab for each value
+    size_t m_elementSize;                 ///< Bytes in each element
+    std::shared_ptr<storage_t> m_pStorage; ///< The ring, 0 if the depth is 0
+    size_t m_nextEntry;                   ///< The slot that receives the next value
+    size_t m_numEntries;                  ///< Number of recorded values
+
+    mutable std::mutex m_lock;            ///< Protects all the members and the entries, but not the slab
+};
+
+}
+#endif // NDSHISTORYIMPL_H
@@ -12,7 +12,9 @@
 
 #include <list>
 #include <memory>
+#include <vector>
 #include "nds3/impl/pvBaseImpl.h"
+#include "nds3/impl/pushRecordImpl.h"
 
 namespace nds
 {
@@ -61,6 +63,101 @@ public:
     virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::vector<std::int32_t> & value) = 0;
     virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::vector<double> & value) = 0;
     virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::string & value) = 0;
+
+    /**
+     * @brief Push a reference counted immutable value to the control system.
+     *
+     * The same buffer may be shared with the subscribed PVs and with the
+     *  replication destinations: the interface may keep a reference to it
+     *  instead of copying the data.
+     *
+     * The default implementation calls the push() overload that takes the
+     *  value by reference.
+     *
+     * @param pv        the PV that is pushing the value
+     * @param timestamp the value's timestamp
+     * @param pValue    pointer to the value. Must not be null
+     */
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::int32_t>& pValue);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const double>& pValue);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::vector<std::int8_t> >& pValue);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::vector<std::uint8_t> >& pValue);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::vector<std::int32_t> >& pValue);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::vector<double> >& pValue);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::string>& pValue);
+
+    /**
+     * @brief Push an array stored in a contiguous buffer owned by the caller.
+     *
+     * The buffer is valid only until the function returns: interfaces that can
+     *  copy the elements straight into the control system records should
+     *  override these functions.
+     *
+     * The default implementation copies the elements into a vector and calls the
+     *  push() overload that takes the vector by reference.
+     *
+     * @param pv        the PV that is pushing the value
+     * @param timestamp the value's timestamp
+     * @param pData     pointer to the first element
+     * @param count     number of elements in the buffer
+     */
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::int8_t* pData, size_t count);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::uint8_t* pData, size_t count);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::int32_t* pData, size_t count);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const double* pData, size_t count);
+
+    /**
+     * @brief Returns true if the interface can transfer only the changed
+     *        elements of an array.
+     *
+     * When it returns false the PVs with differential push enabled push
+     *  the whole arrays and skip the comparison with the previous value.
+     *
+     * The default implementation returns false.
+     *
+     * @return true if the push() overloads that take the changed ranges are
+     *         implemented
+     */
+    virtual bool supportsChangedRanges() const;
+
+    /**
+     * @brief Push an array of which only some elements changed since the
+     *        previous value pushed by the same PV.
+     *
+     * Called only for the PVs with differential push enabled, when
+     *  supportsChangedRanges() returns true. The buffer contains the whole
+     *  array: the interface may transfer only the elements in the ranges.
+     *
+     * The default implementation pushes the whole array.
+     *
+     * @param pv            the PV that is pushing the value
+     * @param timestamp     the value's timestamp
+     * @param pData         pointer to the first element of the whole array
+     * @param count         number of elements in the array
+     * @param changedRanges the elements that differ from the previous value. May
+     *                      be empty if no element changed
+     */
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::int8_t* pData, size_t count, const changedRanges_t& changedRanges);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::uint8_t* pData, size_t count, const changedRanges_t& changedRanges);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::int32_t* pData, size_t count, const changedRanges_t& changedRanges);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const double* pData, size_t count, const changedRanges_t& changedRanges);
+
+    /**
+     * @brief Push several values to the control system in one call.
+     *
+     * Called with all the values collected by a PushBatch or dequeued at once by
+     *  the port's dispatcher thread: the interface may post them to the control
+     *  system with a single lock or notification.
+     *
+     * The default implementation pushes the records one by one via push().
+     *
+     * Each record carries the sequence number assigned by its PV: see
+     *  PushRecordImpl::getSequence(). This is the only delivery path that
+     *  exposes the sequence numbers: the push() overloads don't receive them.
+     *
+     * @param records the values to push, in the order in which they have been pushed
+     */
+    virtual void pushBatch(const std::vector<PushRecordImpl>& records);
 };
 
 }
@@ -0,0 +1,70 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSLINKFILTERIMPL_H
+#define NDSLINKFILTERIMPL_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace nds
+{
+
+/**
+ * @brief Selects the values forwarded through a subscription or a replication
+ *        link, so a slow receiver does not receive the full rate stream.
+ *
+ * A value passes when it completes the decimation interval and, if a maximum
+ *  rate has been specified, when enough time has elapsed since the last
+ *  passed value. The values that do not pass are skipped: no value is held.
+ *
+ * The filter is not thread safe: it is used only by the thread that pushes
+ *  the data.
+ */
+class LinkFilterImpl
+{
+public:
+    /**
+     * @brief Constructs the filter.
+     *
+     * @param decimation forward one value every decimation values. 0 and 1
+     *                   forward all the values
+     * @param maxRate    maximum number of values forwarded per second.
+     *                   0 means no limit
+     */
+    LinkFilterImpl(const std::uint32_t decimation, const double maxRate);
+
+    /**
+     * @brief Returns true if a filter with the specified settings would skip
+     *        any value.
+     *
+     * Links that forward all the values do not need a filter.
+     *
+     * @param decimation the decimation factor
+     * @param maxRate    the maximum rate
+     * @return true if a filter is needed
+     */
+    static bool isNeeded(const std::uint32_t decimation, const double maxRate);
+
+    /**
+     * @brief Counts a new value and decides if it must be forwarded.
+     *
+     * @return true if the value must be forwarded to the receiver
+     */
+    bool pass();
+
+private:
+    std::uint32_t m_decimation;      ///< Decimation factor
+    std::uint32_t m_decimationCount; ///< Values to skip before the next one passes
+    std::chrono::nanoseconds m_interval;  ///< Minimum interval between two passed values
+    std::chrono::steady_clock::time_point m_nextPassTime; ///< When the next value can pass
+};
+
+}
+#endif // NDSLINKFILTERIMPL_H
@@ -71,18 +71,21 @@ public:
      * @param pushFrom  name of the PV from which we want to receive the values
      * @param pReceiver PV that will receive the values coming from the input PV
      *                  (both pushes and write operations)
+     * @param decimation the receiver gets one value every decimation values
+     * @param maxRate   maximum number of values per second written to the
+     *                  receiver. 0 means no limit
      */
-    void subscribe(const std::string& pushFrom, PVBaseOutImpl* pReceiver);
+    void subscribe(const std::string& pushFrom, PVBaseOutImpl* pReceiver, const std::uint32_t decimation = 1, const double maxRate = 0);
 
-    void subscribe(const std::string& pushFrom, const std::string& pushTo);
+    void subscribe(const std::string& pushFrom, const std::string& pushTo, const std::uint32_t decimation = 1, const double maxRate = 0);
 
     void unsubscribe(PVBaseOutImpl* pReceiver);
 
     void unsubscribe(const std::string& pushTo);
 
-    void replicate(const std::string& replicateSource, PVBaseInImpl* pDestination);
+    void replicate(const std::string& replicateSource, PVBaseInImpl* pDestination, const std::uint32_t decimation = 1, const double maxRate = 0);
 
-    void replicate(const std::string& replicateSource, const std::string& replicateDestination);
+    void replicate(const std::string& replicateSource, const std::string& replicateDestination, const std::uint32_t decimation = 1, const double maxRate = 0);
 
     void stopReplicationTo(PVBaseInImpl* pDestination);
 
@@ -46,6 +46,8 @@ public:
 
     virtual void deinitialize();
 
+    virtual void resolveTimestampSource();
+
     virtual state_t getLocalState() const;
 
     virtual void getGlobalState(timespec* pTimestamp, state_t* pState) const;
@@ -10,6 +10,12 @@
 #ifndef NDSPORTIMPL_H
 #define NDSPORTIMPL_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <vector>
 #include "nds3/impl/nodeImpl.h"
 
 namespace nds
@@ -18,6 +24,10 @@ namespace nds
 class FactoryBaseImpl;
 class InterfaceBaseImpl;
 class PVBaseImpl;
+class PVBaseInImpl;
+class PushQueueImpl;
+class PushRecordImpl;
+class ThreadBaseImpl;
 
 
 /**
@@ -42,6 +52,32 @@ public:
 
     virtual void deinitialize();
 
+    /**
+     * @brief Enables the asynchronous delivery of the pushed values.
+     *
+     * When the queue size is not zero the values pushed by the PVs are stored in
+     *  a bounded lock-free queue and delivered to the control system by a
+     *  dedicated dispatcher thread: the thread that pushes the value pays only
+     *  the cost of the enqueue operation. When the queue is full the PV's push
+     *  policy decides whether the pushing thread waits for a free slot or a value
+     *  is discarded (see PVBaseInImpl::setPushPolicy()).
+     *
+     * Must be called before the port is initialized.
+     *
+     * @param queueSize the number of pushed values that the queue can hold (rounded
+     *                  up to the next power of 2), or 0 to deliver the values
+     *                  synchronously from the pushing thread (default)
+     */
+    void setDispatchQueueSize(size_t queueSize);
+
+    /**
+     * @brief Returns the size of the asynchronous dispatch queue.
+     *
+     * @return the queue size set with setDispatchQueueSize(), or 0 if the values
+     *         are delivered synchronously
+     */
+    size_t getDispatchQueueSize() const;
+
     /**
      * @brief Return a pointer to this object.
      * @return a pointer to this object
@@ -53,15 +89,228 @@ public:
 
     void deregisterPV(std::shared_ptr<PVBaseImpl> pv);
 
+    /**
+     * @brief Push a value to the control system, directly or via the dispatch queue.
+     *
+     * @tparam T the data type
+     * @param pv        the PV that is pushing the value
+     * @param timestamp the value's timestamp
+     * @param value     the value
+     */
+    template<typename T>
+    void push(PVBaseInImpl& pv, const timespec& timestamp, const T& value);
+
+    /**
+     * @brief Push a shared immutable value to the control system without copying it.
+     *
+     * @tparam T the data type
+     * @param pv        the PV that is pushing the value
+     * @param timestamp the value's timestamp
+     * @param pValue    pointer to the value
+     */
     template<typename T>
-    void push(std::shared_ptr<PVBaseImpl> pv, const timespec& timestamp, const T& value);
+    void push(PVBaseInImpl& pv, const timespec& timestamp, const std::shared_ptr<const T>& pValue);
+
+    /**
+     * @brief Push an array stored in a contiguous buffer owned by the caller.
+     *
+     * When the value is delivered synchronously the buffer is handed directly to
+     *  the interface, otherwise the elements are copied into a shared buffer
+     *  before the function returns.
+     *
+     * @tparam T the type of the array's elements
+     * @param pv        the PV that is pushing the value
+     * @param timestamp the value's timestamp
+     * @param pData     pointer to the first element
+     * @param count     number of elements in the buffer
+     */
+    template<typename T>
+    void push(PVBaseInImpl& pv, const timespec& timestamp, const T* pData, size_t count);
+
+    /**
+     * @brief Push the values collected by a PushBatchImpl.
+     *
+     * The values are delivered with a single call to InterfaceBaseImpl::pushBatch(),
+     *  or moved into the dispatch queue if the port delivers the values asynchronously.
+     *  In the first case the exceptions thrown by the control system are
+     *  propagated to the caller.
+     *
+     * @param records the values to push. The records may be left empty
+     */
+    void pushBatch(std::vector<PushRecordImpl>& records);
+
+    /**
+     * @brief Push a value held by a PV, directly or via the dispatch queue.
+     *
+     * @param record the value to push. May be left empty
+     */
+    void push(PushRecordImpl& record);
+
+    /**
+     * @brief Returns true if the pushed values go through the dispatch queue,
+     *        which accepts values from several threads without locks.
+     *
+     * @return true if the values are delivered by the dispatcher thread
+     */
+    bool isDispatching() const;
+
+    /**
+     * @brief Returns how full the dispatch queue is.
+     *
+     * @return the fraction of the queue occupied by records waiting for the
+     *         dispatcher, from 0 to 1. Always 0 when the values are delivered
+     *         synchronously
+     */
+    double getDispatchLoad() const;
+
+    /**
+     * @brief Schedules a call to PVBaseInImpl::flushRateLimited() from the
+     *        port's flush thread.
+     *
+     * The flush thread is started by the first call.
+     *
+     * @param pv        the PV that holds a value
+     * @param flushTime when the PV must be flushed
+     * @return false if the port is being deinitialized: the caller must push
+     *         the held value itself
+     */
+    bool scheduleFlush(PVBaseInImpl& pv, const std::chrono::steady_clock::time_point& flushTime);
+
+    /**
+     * @brief Removes the flushes scheduled for a PV and waits for the completion
+     *        of a flush in progress.
+     *
+     * @param pv the PV that must not be flushed anymore
+     */
+    void cancelFlush(PVBaseInImpl& pv);
 
     virtual std::string buildFullNameFromPort(const FactoryBaseImpl& controlSystem) const;
     virtual std::string buildFullExternalNameFromPort(const FactoryBaseImpl& controlSystem) const;
 
 private:
+    /**
+     * @brief Moves a record into the dispatch queue applying the PV's push policy,
+     *        then wakes up the dispatcher thread if it is idle.
+     *
+     * @param record the record to enqueue
+     */
+    void enqueue(PushRecordImpl& record);
+
+    /**
+     * @brief Adds a conflating PV to the list of the PVs that hold a value for
+     *        the dispatcher, then wakes up the dispatcher thread if it is idle.
+     *
+     * @param pv the PV that stored a value in its empty slot
+     */
+    void markChanged(PVBaseInImpl& pv);
+
+    /**
+     * @brief Appends the values held by the changed conflating PVs to a batch.
+     *
+     * @param changedPVs a vector owned by the caller, used to swap the list.
+     *                   Left empty
+     * @param batch      receives the values
+     */
+    void takeChanged(std::vector<PVBaseInImpl*>& changedPVs, std::vector<PushRecordImpl>& batch);
+
+    /**
+     * @brief Wakes up the dispatcher thread if it is waiting for records.
+     *
+     * Called after a record has been added to the queue or a PV has been
+     *  listed as changed. If the dispatcher has been stopped meanwhile then
+     *  the records are delivered by the calling thread.
+     */
+    void notifyDispatcher();
+
+    /**
+     * @brief Delivers the queued records and the values of the changed PVs
+     *        from the calling thread.
+     */
+    void drainQueue();
+
+    /**
+     * @brief Delivers a dequeued record to the control system.
+     *        Exceptions are caught and logged.
+     *
+     * @param record the record to deliver. Placeholders of keep-latest PVs are
+     *               replaced by the value stored in the PV
+     */
+    void deliver(PushRecordImpl& record);
+
+    /**
+     * @brief Delivers several records with one call to the control system.
+     *        The exceptions thrown by the control system are propagated.
+     *
+     * @param records the records to deliver. Must not contain placeholders
+     */
+    void sendBatch(const std::vector<PushRecordImpl>& records);
+
+    /**
+     * @brief Delivers several records with one call to the control system.
+     *        Exceptions are caught and logged.
+     *
+     * @param records the records to deliver. Must not contain placeholders
+     */
+    void deliverBatch(const std::vector<PushRecordImpl>& records);
+
+    /**
+     * @brief Waits until the dispatcher frees a slot in the queue or a timeout
+     *        expires.
+     *
+     * @return false if the dispatcher has been stopped
+     */
+    bool waitForSlot();
+
+    /**
+     * @brief Executed by the dispatcher thread: delivers the queued records
+     *        until stopDispatcher() is called.
+     */
+    void dispatchThread();
+
+    void startDispatcher(FactoryBaseImpl& controlSystem);
+
+    /**
+     * @brief Stops the dispatcher thread and delivers the records left in the queue.
+     */
+    void stopDispatcher();
+
+    /**
+     * @brief Executed by the flush thread: flushes the PVs passed to
+     *        scheduleFlush() when their time comes, until stopFlusher() is called.
+     */
+    void flushThread();
+
+    /**
+     * @brief Stops the flush thread and flushes the PVs that are still holding
+     *        a value.
+     */
+    void stopFlusher();
+
     std::unique_ptr<InterfaceBaseImpl> m_pInterface;
 
+    size_t m_dispatchQueueSize;                      ///< 0 when the values are pushed synchronously
+    std::unique_ptr<PushQueueImpl> m_pDispatchQueue; ///< Records waiting for the dispatcher thread
+    std::unique_ptr<ThreadBaseImpl> m_pDispatchThread;
+    std::atomic<bool> m_bDispatching;                ///< True while pushed values go through the queue
+    std::atomic<bool> m_bStopDispatcher;             ///< Tells the dispatcher thread to exit
+    std::atomic<bool> m_bDispatcherWaiting;          ///< True while the dispatcher waits for records
+    std::atomic<size_t> m_waitingProducers;          ///< Threads waiting for a free slot in the queue
+    std::mutex m_lockDispatcher;                     ///< Used with the condition variables below
+    std::condition_variable m_recordsAvailable;      ///< Wakes up the dispatcher thread
+    std::condition_variable m_slotsAvailable;        ///< Wakes up the threads waiting for a free slot
+
+    std::mutex m_lockChanged;                        ///< Protects m_changedPVs
+    std::vector<PVBaseInImpl*> m_changedPVs;         ///< Conflating PVs holding a value. A PV appears at most once
+    std::atomic<bool> m_bHasChangedPVs;              ///< false when m_changedPVs is empty: spares the lock to the dispatcher
+
+    typedef std::multimap<std::chrono::steady_clock::time_point, PVBaseInImpl*> flushSchedule_t;
+    std::unique_ptr<ThreadBaseImpl> m_pFlushThread;  ///< Started by the first scheduleFlush()
+    flushSchedule_t m_flushSchedule;                 ///< PVs to flush, sorted by flush time
+    bool m_bStopFlusher;                             ///< Tells the flush thread to exit. Protected by m_lockFlush
+    std::mutex m_lockFlush;                          ///< Protects m_flushSchedule and m_bStopFlusher
+    std::mutex m_lockFlushing;                       ///< Held while the flush thread flushes a PV
+    std::condition_variable m_flushScheduled;        ///< Wakes up the flush thread
+
     typedef std::map<int, std::shared_ptr<PVBaseImpl> > tRecords;
     tRecords m_records;
 };
@@ -0,0 +1,91 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSPUSHBATCHIMPL_H
+#define NDSPUSHBATCHIMPL_H
+
+#include <utility>
+#include <vector>
+#include "nds3/definitions.h"
+#include "nds3/impl/pushRecordImpl.h"
+
+namespace nds
+{
+
+class PortImpl;
+
+/**
+ * @brief Collects the values pushed by the calling thread and delivers them
+ *        to the ports in one batch per port.
+ *
+ * While the object exists the ports store the values pushed by the thread that
+ *  created it instead of delivering them. The values are delivered by flush()
+ *  and by the destructor. The destructor cannot throw and logs the errors of
+ *  the control system instead.
+ *
+ * If the thread is already collecting values in another batch then the
+ *  object is inactive and the values are collected by the outer batch.
+ */
+class PushBatchImpl
+{
+public:
+    PushBatchImpl();
+
+    /**
+     * @brief Delivers the collected values and stops collecting.
+     */
+    ~PushBatchImpl();
+
+    /**
+     * @brief Returns the batch that collects the values pushed by the calling
+     *        thread.
+     *
+     * @return the active batch, or 0 if the values must be delivered immediately
+     */
+    static PushBatchImpl* getCurrent();
+
+    /**
+     * @brief Stores a value pushed by a PV.
+     *
+     * @param port   the port that will deliver the value
+     * @param record the value to store. Left empty by the function
+     */
+    void add(PortImpl& port, PushRecordImpl& record);
+
+    /**
+     * @brief Delivers the values collected so far. The batch keeps collecting.
+     *
+     * The values of a synchronous port are delivered by the calling thread:
+     *  the first exception thrown by the control system is rethrown after all
+     *  the ports have been served, as a push outside of the batch would throw.
+     */
+    void flush();
+
+private:
+    PushBatchImpl(const PushBatchImpl&);
+    PushBatchImpl& operator=(const PushBatchImpl&);
+
+    /**
+     * @brief Delivers the values collected so far to all the ports.
+     *
+     * @param bThrow true to rethrow the first exception thrown by a port,
+     *               false to log the exceptions
+     */
+    void deliver(const bool bThrow);
+
+    bool m_bActive; ///< False if the batch is nested in another one
+
+    typedef std::vector<std::pair<PortImpl*, std::vector<PushRecordImpl> > > portRecords_t;
+    portRecords_t m_portRecords; ///< Collected values, one list per port
+
+    static thread_local PushBatchImpl* m_pCurrentBatch;
+};
+
+}
+#endif // NDSPUSHBATCHIMPL_H
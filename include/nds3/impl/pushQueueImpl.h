@@ -0,0 +1,113 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSPUSHQUEUEIMPL_H
+#define NDSPUSHQUEUEIMPL_H
+
+#include <atomic>
+#include <memory>
+#include "nds3/definitions.h"
+#include "nds3/impl/pushRecordImpl.h"
+
+namespace nds
+{
+
+/**
+ * @brief Bounded lock-free queue of push records.
+ *
+ * Any number of threads can push and pop records concurrently. Each slot
+ *  carries a sequence number that tells the producers and the consumers
+ *  whether the slot is free or holds a published record, so that the only
+ *  contended operations are the increments of the enqueue and dequeue
+ *  positions.
+ */
+class PushQueueImpl
+{
+public:
+    /**
+     * @brief Constructs the queue.
+     *
+     * @param capacity the minimum number of records that the queue can hold.
+     *                 Rounded up to the next power of 2
+     */
+    PushQueueImpl(size_t capacity);
+
+    /**
+     * @brief Moves a record into the queue.
+     *
+     * @param record     the record to enqueue. Left empty if the function succeeds
+     * @param bEvictable true if the record may be removed by tryEvict()
+     * @return true if the record has been enqueued, false if the queue is full
+     */
+    bool tryPush(PushRecordImpl& record, const bool bEvictable = false);
+
+    /**
+     * @brief Moves the oldest record out of the queue.
+     *
+     * @param record receives the dequeued record
+     * @return true if a record has been dequeued, false if the queue is empty
+     */
+    bool tryPop(PushRecordImpl& record);
+
+    /**
+     * @brief Moves the oldest record out of the queue, but only if it has been
+     *        enqueued as evictable.
+     *
+     * @param record receives the evicted record
+     * @return true if a record has been evicted, false if the queue is empty or
+     *         the oldest record is not evictable
+     */
+    bool tryEvict(PushRecordImpl& record);
+
+    /**
+     * @brief Returns true if no record has been enqueued since the last pop.
+     *
+     * The result is only a snapshot when other threads access the queue.
+     *
+     * @return true if the queue is empty
+     */
+    bool isEmpty() const;
+
+    size_t getCapacity() const;
+
+    /**
+     * @brief Returns the number of records waiting in the queue.
+     *
+     * The result is only a snapshot when other threads access the queue.
+     *
+     * @return the number of queued records, at most getCapacity()
+     */
+    size_t getSize() const;
+
+private:
+    static const size_t m_cacheLineSize = 64;
+
+    struct cell_t
+    {
+        std::atomic<size_t> m_sequence;
+        std::atomic<bool> m_bEvictable;
+        PushRecordImpl m_record;
+    };
+
+    bool tryPop(PushRecordImpl& record, const bool bOnlyEvictable);
+
+    const size_t m_positionMask;
+    std::unique_ptr<cell_t[]> m_cells;
+
+    // Producers and consumers update different cache lines
+    ///////////////////////////////////////////////////////
+    char m_padding0[m_cacheLineSize];
+    std::atomic<size_t> m_enqueuePosition;
+    char m_padding1[m_cacheLineSize];
+    std::atomic<size_t> m_dequeuePosition;
+    char m_padding2[m_cacheLineSize];
+};
+
+}
+#endif // NDSPUSHQUEUEIMPL_H
@@ -0,0 +1,166 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSPUSHRECORDIMPL_H
+#define NDSPUSHRECORDIMPL_H
+
+#include <cstdint>
+#include <memory>
+#include "nds3/definitions.h"
+
+namespace nds
+{
+
+class PVBaseInImpl;
+class InterfaceBaseImpl;
+
+/**
+ * @brief A value pushed by an input PV, stored together with its timestamp and
+ *        the PV that pushed it.
+ *
+ * Scalar values are stored in the record, arrays and strings are referenced
+ *  through a shared immutable buffer. The record can be stored in a queue and
+ *  delivered later to the control system via dispatch().
+ */
+class NDS3_API PushRecordImpl
+{
+public:
+    /**
+     * @brief Constructs an empty record.
+     */
+    PushRecordImpl();
+
+    /**
+     * @brief Stores a copy of the value.
+     *
+     * @tparam T the data type
+     * @param pv        the PV that pushes the value
+     * @param timestamp the value's timestamp
+     * @param value     the value
+     */
+    template<typename T>
+    void set(PVBaseInImpl& pv, const timespec& timestamp, const T& value);
+
+    /**
+     * @brief Stores a reference to a shared immutable value.
+     *
+     * @tparam T the data type
+     * @param pv        the PV that pushes the value
+     * @param timestamp the value's timestamp
+     * @param pValue    pointer to the value
+     */
+    template<typename T>
+    void set(PVBaseInImpl& pv, const timespec& timestamp, const std::shared_ptr<const T>& pValue);
+
+    /**
+     * @brief Turns the record into a placeholder for the latest value pushed by
+     *        a keep-latest PV.
+     *
+     * The value is stored in the PV and retrieved when the placeholder is
+     *  dequeued, so a PV has at most one value waiting for delivery.
+     *
+     * @param pv the PV that holds the latest value
+     */
+    void setLatestToken(PVBaseInImpl& pv);
+
+    /**
+     * @brief Returns true if the record is a placeholder set by setLatestToken().
+     *
+     * @return true if the value must be retrieved from the PV
+     */
+    bool isLatestToken() const;
+
+    /**
+     * @brief Releases the referenced buffer (if any) and empties the record.
+     */
+    void clear();
+
+    /**
+     * @brief Pushes the stored value to the control system interface.
+     *
+     * @param interface the interface that receives the value
+     */
+    void dispatch(InterfaceBaseImpl& interface) const;
+
+    /**
+     * @brief Returns the PV that pushed the value.
+     *
+     * @return the PV that pushed the value, or 0 if the record is empty
+     */
+    PVBaseInImpl* getPV() const;
+
+    const timespec& getTimestamp() const;
+
+    /**
+     * @brief Stores the sequence number assigned by the PV when the value
+     *        entered the port.
+     *
+     * @param sequence the sequence number returned by PVBaseInImpl::countEnqueued()
+     */
+    void setSequence(const std::uint64_t sequence);
+
+    /**
+     * @brief Returns the sequence number of the value.
+     *
+     * The sequence numbers of a PV increase by one for each value handed to
+     *  the port: a missing number marks a value lost between the port and the
+     *  control system.
+     *
+     * @return the sequence number, or 0 if it has not been assigned
+     */
+    std::uint64_t getSequence() const;
+
+    dataType_t getDataType() const;
+
+    /**
+     * @brief Returns the stored value.
+     *
+     * @tparam T the data type. Must match the type returned by getDataType()
+     * @return the stored value
+     */
+    template<typename T>
+    const T& getValue() const;
+
+private:
+    /**
+     * @brief Pushes the stored array, or only its changes if the PV has the
+     *        differential push enabled.
+     *
+     * @tparam E        the type of the elements
+     * @param interface the interface that receives the array
+     */
+    template<typename E>
+    void dispatchArray(InterfaceBaseImpl& interface) const;
+
+    PVBaseInImpl* m_pPV;              ///< The PV that pushed the value
+    timespec m_timestamp;             ///< The value's timestamp
+    std::uint64_t m_sequence;         ///< Assigned by the PV when the value enters the port
+    dataType_t m_dataType;            ///< Selects the storage used for the value
+    bool m_bLatestToken;              ///< The value is held by the PV
+
+    union
+    {
+        std::int32_t m_int32Value;    ///< Used for dataType_t::dataInt32
+        double m_doubleValue;         ///< Used for dataType_t::dataFloat64
+    };
+
+    std::shared_ptr<const void> m_pValue; ///< Used for arrays and strings
+};
+
+// Scalars are stored in the record
+///////////////////////////////////
+template<> void PushRecordImpl::set<std::int32_t>(PVBaseInImpl& pv, const timespec& timestamp, const std::int32_t& value);
+template<> void PushRecordImpl::set<double>(PVBaseInImpl& pv, const timespec& timestamp, const double& value);
+template<> void PushRecordImpl::set<std::int32_t>(PVBaseInImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::int32_t>& pValue);
+template<> void PushRecordImpl::set<double>(PVBaseInImpl& pv, const timespec& timestamp, const std::shared_ptr<const double>& pValue);
+template<> const std::int32_t& PushRecordImpl::getValue<std::int32_t>() const;
+template<> const double& PushRecordImpl::getValue<double>() const;
+
+}
+#endif // NDSPUSHRECORDIMPL_H
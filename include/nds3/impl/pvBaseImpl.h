@@ -10,6 +10,7 @@
 #ifndef NDSPVBASEIMPL_H
 #define NDSPVBASEIMPL_H
 
+#include <atomic>
 #include <string>
 #include "nds3/definitions.h"
 #include "nds3/impl/baseImpl.h"
@@ -19,6 +20,18 @@ namespace nds
 
 class PVBase;
 
+/**
+ * @brief Type of the elements of the buffers that receive the values of a PV
+ *        in PVBaseImpl::read(timespec*, E*, size_t).
+ *
+ * Scalars are read as arrays of one element, strings as arrays of std::uint8_t.
+ *
+ * @tparam T the PV data type
+ */
+template<typename T> struct bufferElement_t { typedef T type; };
+template<typename E> struct bufferElement_t<std::vector<E> > { typedef E type; };
+template<> struct bufferElement_t<std::string> { typedef std::uint8_t type; };
+
 /**
  * @brief Base class for all the PVs.
  */
@@ -39,6 +52,17 @@ public:
      */
     virtual void deinitialize();
 
+    /**
+     * @brief Return the port resolved by initialize().
+     *
+     * Unlike getPort() it does not walk the parent nodes and does not touch any
+     *  reference count, so it can be called for each pushed value. The port is
+     *  owned by the node tree and outlives the PV's registration.
+     *
+     * @return the port that communicates with the control system
+     */
+    PortImpl& getCachedPort();
+
     /**
      * @brief Called when the control system wants to read the value.
      *
@@ -55,6 +79,29 @@ public:
     virtual void read(timespec* pTimestamp, std::vector<double>* pValue) const;
     virtual void read(timespec* pTimestamp, std::string* pValue) const;
 
+    /**
+     * @brief Called when the control system wants to read the value into a
+     *        buffer that it owns, for instance a record buffer sized by
+     *        getMaxElements().
+     *
+     * The elements are copied once and the buffer is never reallocated: the
+     *  elements that exceed the capacity are not copied. See bufferElement_t
+     *  for the type of the buffer used by each PV data type.
+     *
+     * The default implementation reads the value into a temporary vector,
+     *  the PVs that store their value copy it directly into the buffer.
+     *
+     * @param pTimestamp pointer to a variable that will be filled with the
+     *                   timestamp of the value
+     * @param pBuffer    the buffer that receives the elements
+     * @param capacity   the number of elements that fit into pBuffer
+     * @return the number of elements copied into pBuffer
+     */
+    virtual size_t read(timespec* pTimestamp, std::int8_t* pBuffer, size_t capacity) const;
+    virtual size_t read(timespec* pTimestamp, std::uint8_t* pBuffer, size_t capacity) const;
+    virtual size_t read(timespec* pTimestamp, std::int32_t* pBuffer, size_t capacity) const;
+    virtual size_t read(timespec* pTimestamp, double* pBuffer, size_t capacity) const;
+
     /**
      * @brief Called when the control system wants to write a value.
      *
@@ -204,6 +251,20 @@ public:
     }
 
 protected:
+    /**
+     * @brief Copies a value into a buffer owned by the control system.
+     *
+     * @param value    the value to copy
+     * @param pBuffer  the buffer that receives the elements
+     * @param capacity the number of elements that fit into pBuffer
+     * @return the number of elements copied into pBuffer
+     */
+    template<typename E>
+    static size_t copyToBuffer(const std::vector<E>& value, E* pBuffer, size_t capacity);
+    static size_t copyToBuffer(const std::string& value, std::uint8_t* pBuffer, size_t capacity);
+    template<typename E>
+    static size_t copyToBuffer(const E& value, E* pBuffer, size_t capacity);
+
     std::string m_description;          ///< The PV's description.
     std::string m_units;                ///< Engineering units
     scanType_t m_scanType;              ///< The PV's scan type.
@@ -211,6 +272,7 @@ protected:
     size_t m_maxElements;               ///< Maximum number of elements that can be stored in the PV.
     enumerationStrings_t m_enumeration; ///< List of strings used for enumeration.
     bool m_bProcessAtInit;              ///< True if the PV has to be processed during the device initialization.
+    std::atomic<PortImpl*> m_pCachedPort; ///< Set by initialize(), reset by deinitialize().
 };
 
 }
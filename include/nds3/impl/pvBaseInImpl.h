@@ -11,15 +11,27 @@
 #define NDSPVBASEINIMPL_H
 
 #include <string>
-#include <set>
+#include <map>
+#include <vector>
 #include <mutex>
+#include <memory>
+#include <atomic>
+#include <chrono>
 #include "nds3/definitions.h"
 #include "nds3/impl/baseImpl.h"
 #include "nds3/impl/pvBaseImpl.h"
+#include "nds3/impl/pushRecordImpl.h"
+#include "nds3/impl/decimatorImpl.h"
+#include "nds3/impl/deadbandImpl.h"
+#include "nds3/impl/changeDetectorImpl.h"
+#include "nds3/impl/linkFilterImpl.h"
+#include "nds3/impl/archiveImpl.h"
+#include "nds3/impl/historyImpl.h"
 
 namespace nds
 {
 
+class InterfaceBaseImpl;
 class PVBase;
 class PVBaseOutImpl;
 
@@ -58,19 +70,74 @@ public:
     template<typename T>
     void push(const timespec& timestamp, const T& value);
 
+    /**
+     * @brief Pushes a shared immutable value to the control system and to the
+     *        subscribed PVs.
+     *
+     * The buffer is not copied: the port, the subscribed PVs and the replication
+     *  destinations all receive a reference to the same value.
+     *
+     * @tparam T the data type
+     * @param timestamp    the timestamp related to the data
+     * @param pValue       pointer to the data to push. Must not be null
+     */
+    template<typename T>
+    void push(const timespec& timestamp, const std::shared_ptr<const T>& pValue);
+
+    /**
+     * @brief Pushes a transient value to the control system and to the
+     *        subscribed PVs, taking ownership of it.
+     *
+     * Arrays and strings are moved into the buffer shared by the port, the
+     *  subscribed PVs and the replication destinations; scalars are copied.
+     *
+     * @param timestamp    the timestamp related to the data
+     * @param value        the data to push. Left in a valid but unspecified state
+     */
+    void push(const timespec& timestamp, std::int32_t&& value);
+    void push(const timespec& timestamp, double&& value);
+    void push(const timespec& timestamp, std::vector<std::int8_t>&& value);
+    void push(const timespec& timestamp, std::vector<std::uint8_t>&& value);
+    void push(const timespec& timestamp, std::vector<std::int32_t>&& value);
+    void push(const timespec& timestamp, std::vector<double>&& value);
+    void push(const timespec& timestamp, std::string&& value);
+
+    /**
+     * @brief Pushes an array stored in a contiguous buffer owned by the caller.
+     *
+     * The buffer is not copied when the port delivers the value synchronously
+     *  and there are no subscribed or replication PVs.
+     *
+     * @tparam T the type of the array's elements
+     * @param timestamp    the timestamp related to the data
+     * @param pData        pointer to the first element
+     * @param count        number of elements in the buffer. An exception
+     *                     MaxElementsExceeded is thrown if it is bigger than
+     *                     getMaxElements()
+     */
+    template<typename T>
+    void push(const timespec& timestamp, const T* pData, size_t count);
+
     /**
      * @brief Subscribe an output PV to this PV.
      *
-     * The subscribed PV will receive all the data pushed or written into this
-     *  PV.
+     * The subscribed PV will receive the data pushed or written into this
+     *  PV, reduced by the optional decimation and rate limit of the link.
+     * Subscribing an already subscribed PV replaces the settings of the link.
      *
-     * @param pReceiver the PV that will receive al the data
+     * @param pReceiver  the PV that will receive the data
+     * @param decimation the receiver gets one value every decimation values
+     * @param maxRate    maximum number of values per second written to the
+     *                   receiver. 0 means no limit
      */
-    void subscribeReceiver(PVBaseOutImpl* pReceiver);
+    void subscribeReceiver(PVBaseOutImpl* pReceiver, const std::uint32_t decimation = 1, const double maxRate = 0);
 
     /**
      * @brief Unsubscribe an output PV from this PV.
      *
+     * Waits for the pushes that are delivering values to the receiver, but
+     *  not when called from a receiver's write(): see publishReceivers().
+     *
      * @param pReceiver the output PV to unsubscribe
      */
     void unsubscribeReceiver(PVBaseOutImpl* pReceiver);
@@ -79,12 +146,17 @@ public:
      * @brief Replicate the data written to this PV to another input PV.
      *
      * @param pDestination the PV into which the data must be copied
+     * @param decimation   the destination gets one value every decimation values
+     * @param maxRate      maximum number of values per second pushed to the
+     *                     destination. 0 means no limit
      */
-    void replicateTo(PVBaseInImpl* pDestination);
+    void replicateTo(PVBaseInImpl* pDestination, const std::uint32_t decimation = 1, const double maxRate = 0);
 
     /**
      * @brief Stop the replication of data to the specified destination PV.
      *
+     * Waits like unsubscribeReceiver().
+     *
      * @param pDestination the destination to unsubscribe from replication
      */
     void stopReplicationTo(PVBaseInImpl* pDestination);
@@ -98,6 +170,302 @@ public:
      */
     void setDecimation(const std::uint32_t decimation);
 
+    /**
+     * @brief Set how the values pushed during a decimation interval are combined.
+     *
+     * The new mode is applied by the next push(), which also starts a new
+     *  decimation interval.
+     *
+     * @param decimationMode the combination to apply
+     */
+    void setDecimationMode(const decimationMode_t decimationMode);
+
+    decimationMode_t getDecimationMode() const;
+
+    /**
+     * @brief Let the PV raise the decimation factor when the port's dispatch
+     *        queue fills up, and lower it again when the queue drains.
+     *
+     * The factor is evaluated at the end of each decimation interval: it is
+     *  doubled when the queue is more than half full and halved when the queue
+     *  is less than one eighth full. It never goes below the factor selected by
+     *  setDecimation() nor above maxDecimation.
+     *
+     * @param maxDecimation the highest decimation factor, or 0 to disable the
+     *                      adaptive decimation
+     */
+    void setAdaptiveDecimation(const std::uint32_t maxDecimation);
+
+    std::uint32_t getAdaptiveDecimation() const;
+
+    /**
+     * @brief Returns the decimation factor currently applied.
+     *
+     * @return the factor selected by setDecimation(), or the one chosen by the
+     *         adaptive decimation
+     */
+    std::uint32_t getEffectiveDecimation() const;
+
+    /**
+     * @brief Set the deadband applied to the values passed to the control system.
+     *
+     * The new deadband is applied by the next push(), which always passes its
+     *  value to the control system.
+     *
+     * @param type     the kind of deadband
+     * @param deadband the minimum change that must be passed. For
+     *                 deadbandType_t::relative it is a fraction of the last
+     *                 passed value
+     */
+    void setDeadband(const deadbandType_t type, const double deadband);
+
+    /**
+     * @brief Set the maximum number of values per second passed to the control
+     *        system.
+     *
+     * The values pushed too early are held by the PV: only the latest one is
+     *  kept and it is pushed by the port's flush thread when the interval
+     *  expires.
+     *
+     * @param maxRate the maximum number of values per second, or 0 to pass all
+     *                the values
+     */
+    void setMaxPublishRate(const double maxRate);
+
+    double getMaxPublishRate() const;
+
+    /**
+     * @brief Called by the port when the rate limiting interval expires: pushes
+     *        the held value, if any.
+     *
+     * @param port the port that receives the held value
+     */
+    void flushRateLimited(PortImpl& port);
+
+    /**
+     * @brief Set what happens to the pushed values when the port's dispatch queue
+     *        is full.
+     *
+     * @param pushPolicy the policy to apply to this PV's values
+     */
+    void setPushPolicy(const pushPolicy_t pushPolicy);
+
+    /**
+     * @brief Declares that several threads push values into this PV.
+     *
+     * @param bMultiProducer true if several threads may push concurrently
+     */
+    void setMultiProducer(const bool bMultiProducer);
+
+    bool isMultiProducer() const;
+
+    /**
+     * @brief Enables the differential push of the arrays: the interface receives
+     *        the ranges of the elements changed since the previous array.
+     *
+     * Enabling or disabling the differential push forgets the previous array.
+     *
+     * @param bDifferentialPush true to compare each array with the previous one
+     */
+    void setDifferentialPush(const bool bDifferentialPush);
+
+    bool isDifferentialPush() const;
+
+    /**
+     * @brief Called by the port to deliver an array: pushes only its changes if
+     *        the differential push is enabled and the interface supports it.
+     *
+     * The array is compared with the previous one delivered to the control
+     *  system, so values discarded on the way do not corrupt the changes.
+     *
+     * @param interface the interface that receives the array
+     * @param timestamp the array's timestamp
+     * @param pData     pointer to the first element
+     * @param count     number of elements
+     * @return false if the caller must push the whole array
+     */
+    template<typename E>
+    bool pushChanges(InterfaceBaseImpl& interface, const timespec& timestamp, const E* pData, size_t count);
+
+    /**
+     * @brief Keeps the last pushed values in a ring, so they can be retrieved
+     *        after an event (e.g. an interlock).
+     *
+     * The ring is allocated by this call with room for getMaxElements()
+     *  elements per value: the elements that exceed it are not recorded.
+     *  Changing the depth discards the recorded values.
+     *
+     * @param depth the number of values to keep. 0 disables the history
+     */
+    void setHistoryDepth(const size_t depth);
+
+    size_t getHistoryDepth() const;
+
+    /**
+     * @brief Returns the recorded values with a timestamp in a range, from the
+     *        oldest to the newest.
+     *
+     * @tparam T          the PV data type
+     * @param from        the oldest timestamp to return
+     * @param to          the newest timestamp to return
+     * @param maxValues   maximum number of values to return: the newest ones
+     *                    are returned
+     * @param pTimestamps filled with the timestamps of the values
+     * @param pValues     filled with the values
+     */
+    template<typename T>
+    void getHistory(const timespec& from, const timespec& to, size_t maxValues, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const;
+
+    /**
+     * @brief Writes the pushed values into a circular archive file.
+     *
+     * The file is created with room for getMaxElements() elements per frame
+     *  and mapped in memory: the push path loads the writer from an atomic
+     *  pointer and copies the values into the mapping without locking.
+     *
+     * A producer may still be recording into the file attached previously,
+     *  so the replaced files stay mapped until the PV is destroyed.
+     *
+     * @param fileName  the name of the archive file
+     * @param numFrames the number of frames in the file. 0 closes the archive
+     */
+    void setArchive(const std::string& fileName, const size_t numFrames);
+
+    /**
+     * @brief Selects the directory of the files created by the command
+     *        "archive". The command is rejected while no directory is set.
+     *
+     * @param directory the directory for the archive files, or an empty
+     *                  string to disable the command
+     */
+    void setArchiveDirectory(const std::string& directory);
+
+    pushPolicy_t getPushPolicy() const;
+
+    /**
+     * @brief Returns the number of values that have been handed to the port.
+     *
+     * @return the number of values handed to the port since the PV creation
+     */
+    std::uint64_t getEnqueuedCount() const;
+
+    /**
+     * @brief Returns the number of values that have been delivered to the
+     *        control system.
+     *
+     * @return the number of values delivered since the PV creation
+     */
+    std::uint64_t getDeliveredCount() const;
+
+    /**
+     * @brief Returns the number of values discarded because of the push policy.
+     *
+     * @return the number of values discarded since the PV creation
+     */
+    std::uint64_t getDroppedCount() const;
+
+    /**
+     * @brief Returns the number of values passed to push().
+     *
+     * @return the number of pushed values since the PV creation
+     */
+    std::uint64_t getPushedCount() const;
+
+    /**
+     * @brief Returns the number of values discarded or combined by the decimation.
+     *
+     * @return the number of decimated values since the PV creation
+     */
+    std::uint64_t getDecimatedCount() const;
+
+    /**
+     * @brief Returns the number of values discarded by the deadband.
+     *
+     * @return the number of filtered values since the PV creation
+     */
+    std::uint64_t getFilteredCount() const;
+
+    /**
+     * @brief Returns the number of values replaced by a newer one in the rate
+     *        limiter before they reached the port.
+     *
+     * @return the number of conflated values since the PV creation
+     */
+    std::uint64_t getConflatedCount() const;
+
+    /**
+     * @brief Returns the number of values not forwarded to a subscriber or to
+     *        a replication destination because of the link's decimation or
+     *        rate limit.
+     *
+     * @return the number of skipped links since the PV creation
+     */
+    std::uint64_t getLinkSkippedCount() const;
+
+    /**
+     * @brief Returns the number of sequence numbers that did not reach the
+     *        control system.
+     *
+     * A value delivered after a value with a higher sequence number is
+     *  removed from the gaps. The count is approximate while values of a
+     *  multi-producer PV are being delivered out of order.
+     *
+     * @return the number of missing sequence numbers since the PV creation
+     */
+    std::uint64_t getGapCount() const;
+
+    /**
+     * @brief Returns the highest sequence number delivered to the control system.
+     *
+     * Only the values delivered via InterfaceBaseImpl::pushBatch() carry their
+     *  sequence number, in the record. The push() overloads don't receive it:
+     *  while they run this is the sequence number of the delivered value only
+     *  if the PV has a single producer.
+     *
+     * @return the highest delivered sequence number, or 0 if no value was delivered
+     */
+    std::uint64_t getLastDeliveredSequence() const;
+
+    // Called by the port to update the counters
+    ////////////////////////////////////////////
+
+    /**
+     * @brief Counts a value handed to the port and assigns its sequence number.
+     *
+     * @return the sequence number of the value. The first value gets 1
+     */
+    std::uint64_t countEnqueued();
+    void countDelivered();
+    void countDropped();
+
+    /**
+     * @brief Called by the port right before a value is delivered to the
+     *        control system: detects the sequence numbers that were skipped.
+     *
+     * @param sequence the sequence number returned by countEnqueued()
+     */
+    void startDelivery(const std::uint64_t sequence);
+
+    /**
+     * @brief Stores the latest value of a keep-latest or conflating PV until
+     *        the dispatcher retrieves it with takeLatest().
+     *
+     * A value still waiting in the slot is discarded and counted as dropped.
+     *
+     * @param record the record to store. Left empty by the function
+     * @return true if the slot was empty, i.e. if a placeholder for the value
+     *         must be enqueued or the PV must be marked as changed
+     */
+    bool storeLatest(PushRecordImpl& record);
+
+    /**
+     * @brief Retrieves the value stored by storeLatest().
+     *
+     * @param record receives the stored value
+     * @return true if a value was stored, false if the slot is empty
+     */
+    bool takeLatest(PushRecordImpl& record);
+
     /**
      * @brief Specifies an input PV from which the data must be copied.
      *
@@ -106,8 +474,11 @@ public:
      *
      * @param sourceInputPVName the full name of the input PV from which the data
      *                           must be copied
+     * @param decimation         this PV receives one value every decimation values
+     * @param maxRate            maximum number of values per second pushed to this
+     *                           PV. 0 means no limit
      */
-    void replicateFrom(const std::string& sourceInputPVName);
+    void replicateFrom(const std::string& sourceInputPVName, const std::uint32_t decimation = 1, const double maxRate = 0);
 
     virtual dataDirection_t getDataDirection() const;
 
@@ -120,33 +491,318 @@ protected:
     inputPvType_t m_pvType;
 
     /**
-     * @brief List of subscribed PVs.
+     * @brief List of subscribed PVs and the filters of their links.
+     *
+     * The filter is empty when the receiver gets all the values.
      */
-    typedef std::set<PVBaseOutImpl*> subscribersList_t;
+    typedef std::map<PVBaseOutImpl*, std::shared_ptr<LinkFilterImpl> > subscribersList_t;
 
     /**
-     * @brief List of subscribed PVs.
+     * @brief List of destination input PVs and the filters of their links.
+     *
+     * The filter is empty when the destination gets all the values.
      */
-    subscribersList_t m_subscriberOutputPVs;
+    typedef std::map<PVBaseInImpl*, std::shared_ptr<LinkFilterImpl> > destinationList_t;
 
     /**
-     * @brief List of destination input PVs.
+     * @brief The PVs that receive the pushed values.
+     *
+     * A published list is never modified: subscribeReceiver(), replicateTo() and
+     *  the functions that remove a receiver publish a modified copy, so push()
+     *  can iterate a list without holding m_lockSubscribersList. Note that
+     *  std::atomic_load() of a shared_ptr may use a small internal lock of
+     *  the standard library.
      */
-    typedef std::set<PVBaseInImpl*> destinationList_t;
+    struct receivers_t
+    {
+        subscribersList_t m_subscriberOutputPVs;        ///< Subscribed output PVs
+        destinationList_t m_replicationDestinationPVs;  ///< Input PVs to which the data must be pushed or written
+    };
 
     /**
-     * @brief List of PVs to which the data must be pushed or written
+     * @brief Returns the list of receivers currently published.
+     *
+     * The returned list stays valid while the caller holds the pointer, even if
+     *  a receiver is added or removed in the meantime.
+     *
+     * @return the published list, or an empty pointer if there are no receivers
      */
-    destinationList_t m_replicationDestinationPVs;
+    std::shared_ptr<const receivers_t> getReceivers() const;
 
-    std::mutex m_lockSubscribersList; ///< Lock the access to m_subscriberOutputPVs.
+    /**
+     * @brief Decides if a value must be forwarded through a link and counts
+     *        the values that are skipped.
+     *
+     * @param pFilter the filter of the link, empty if the link forwards all the values
+     * @return true if the value must be forwarded to the receiver
+     */
+    bool passLink(const std::shared_ptr<LinkFilterImpl>& pFilter);
 
-    std::uint32_t m_decimationFactor;  ///< Decimation factor.
-    std::uint32_t m_decimationCount;   ///< Keeps track of the received data/vs data pushed to the control system.
+    /**
+     * @brief Marks the calling thread as delivering a value to the receivers
+     *        for the lifetime of the object.
+     *
+     * Every loop that writes or pushes a value into the receivers must create
+     *  one: a receiver removed by the same thread while it receives the value
+     *  does not wait for the delivery to finish. See publishReceivers().
+     */
+    class ReceiversDeliveryScope
+    {
+    public:
+        ReceiversDeliveryScope();
+        ~ReceiversDeliveryScope();
+    };
+
+    std::shared_ptr<const receivers_t> m_pReceivers; ///< Published receivers. Access only via std::atomic_load/std::atomic_store
+    std::atomic<bool> m_bHasReceivers;               ///< false when m_pReceivers is empty: spares the snapshot to push()
+
+    std::mutex m_lockSubscribersList; ///< Serializes the modifications of m_pReceivers. push() does not use it.
+
+    std::atomic<bool> m_bMultiProducer; ///< Selected by setMultiProducer()
+    std::mutex m_lockProducers;         ///< Serializes the producers of a multi-producer PV when a stateful stage is active
+
+    std::atomic<std::uint32_t> m_decimationFactor;  ///< Decimation factor.
+    std::atomic<std::uint32_t> m_decimationCount;   ///< Keeps track of the received data/vs data pushed to the control system.
+    std::atomic<std::uint32_t> m_effectiveDecimation;   ///< Factor applied to the next decimation interval
+    std::atomic<std::uint32_t> m_maxAdaptiveDecimation; ///< Selected by setAdaptiveDecimation(). 0 when disabled
+
+    std::atomic<decimationMode_t> m_decimationMode; ///< Selected by setDecimationMode()
+    std::atomic<bool> m_bResetDecimator;            ///< The decimation settings changed since the last push
+    DecimatorImpl m_decimator;                      ///< Combines the decimated values. Used only by push()
+
+    std::atomic<deadbandType_t> m_deadbandType;     ///< Selected by setDeadband()
+    std::atomic<double> m_deadband;                 ///< Selected by setDeadband()
+    std::atomic<bool> m_bResetDeadband;             ///< The deadband settings changed since the last push
+    DeadbandImpl m_deadbandFilter;                  ///< Compares the values with the last passed one. Used only by push()
+
+    std::atomic<std::int64_t> m_publishInterval;    ///< Minimum interval between two values passed to the port, in nanoseconds
+    std::mutex m_lockRateLimit;                     ///< Protects the members below
+    std::chrono::steady_clock::time_point m_nextPublishTime; ///< When the next value can be passed to the port
+    bool m_bFlushScheduled;                         ///< m_rateLimitedRecord will be pushed by the port's flush thread
+    PushRecordImpl m_rateLimitedRecord;             ///< The latest value held by the rate limiter
+
+    std::atomic<pushPolicy_t> m_pushPolicy;      ///< What to do when the port's dispatch queue is full
+    std::atomic<std::uint64_t> m_enqueuedCount;  ///< Values handed to the port
+    std::atomic<std::uint64_t> m_deliveredCount; ///< Values delivered to the control system
+    std::atomic<std::uint64_t> m_droppedCount;   ///< Values discarded because of the push policy
+
+    std::atomic<std::uint64_t> m_pushedCount;       ///< Values passed to push()
+    std::atomic<std::uint64_t> m_decimatedCount;    ///< Values discarded or combined by the decimation
+    std::atomic<std::uint64_t> m_filteredCount;     ///< Values discarded by the deadband
+    std::atomic<std::uint64_t> m_conflatedCount;    ///< Values replaced in the rate limiter
+    std::atomic<std::uint64_t> m_linkSkippedCount;  ///< Values not forwarded through a filtered link
+    std::atomic<std::uint64_t> m_gapCount;          ///< Sequence numbers that did not reach the control system
+    std::atomic<std::uint64_t> m_lastDeliveredSequence; ///< Highest sequence number delivered
+
+    std::atomic<bool> m_bDifferentialPush; ///< Selected by setDifferentialPush()
+    std::mutex m_lockChanges;              ///< Serializes the deliveries of arrays when m_bDifferentialPush is set
+    ChangeDetectorImpl m_changeDetector;   ///< Holds the previous delivered array. Protected by m_lockChanges
+    changedRanges_t m_changedRanges;       ///< Reused by pushChanges(). Protected by m_lockChanges
+
+    std::atomic<bool> m_bHistory;     ///< True when m_history has a depth
+    HistoryImpl m_history;            ///< The last pushed values
+
+    std::atomic<ArchiveWriterImpl*> m_pArchive;     ///< The archive file that receives the pushed values, or 0
+    std::mutex m_lockArchive;                       ///< Protects m_archiveWriters and m_archiveDirectory
+    std::vector<std::unique_ptr<ArchiveWriterImpl> > m_archiveWriters; ///< Own the current and the replaced archive files
+    std::string m_archiveDirectory;                 ///< Directory of the files created by the command "archive"
+
+    std::mutex m_lockLatest;          ///< Protects m_latestRecord.
+    PushRecordImpl m_latestRecord;    ///< Latest value of a keep-latest or conflating PV, waiting for the dispatcher
 
 private:
+    /**
+     * @brief Write a shared value into the subscribed PVs and push it to the
+     *        replication destinations.
+     *
+     * @param receivers the list of receivers returned by getReceivers()
+     * @param timestamp the timestamp related to the data
+     * @param pValue    pointer to the data shared by all the receivers
+     */
+    template<typename T>
+    void pushToReceivers(const receivers_t& receivers, const timespec& timestamp, const std::shared_ptr<const T>& pValue);
+
+    /**
+     * @brief Publishes a modified list of receivers.
+     *
+     * When a receiver has been removed the function waits until no push()
+     *  is still using the previous list, so usually the removed receiver does
+     *  not receive any more data after the function returns. The wait is
+     *  skipped when the calling thread is delivering a value to a receiver
+     *  (e.g. a receiver's write() unsubscribes it) and lasts at most one
+     *  second: a producer descheduled while it delivers a value may still
+     *  pass it to the removed receiver afterwards.
+     *
+     * m_lockSubscribersList must be locked.
+     *
+     * @param pReceivers       the new list of receivers
+     * @param bRemovedReceiver true if the new list lacks a receiver that was in
+     *                         the previous one
+     */
+    void publishReceivers(const std::shared_ptr<const receivers_t>& pReceivers, const bool bRemovedReceiver);
+
+    /**
+     * @brief Allocates the filter for a subscription or replication link.
+     *
+     * @param decimation the decimation factor of the link
+     * @param maxRate    the maximum rate of the link, 0 for no limit
+     * @return the filter, or an empty pointer if the link forwards all the values
+     */
+    static std::shared_ptr<LinkFilterImpl> makeLinkFilter(const std::uint32_t decimation, const double maxRate);
+
+    /**
+     * @brief Combines a value with the other ones pushed during the decimation
+     *        interval and pushes the result to the port at the end of the interval.
+     *
+     * Used instead of the plain decimation when the decimation mode is not
+     *  decimationMode_t::sample.
+     *
+     * @param port      the port that receives the combined value
+     * @param timestamp the timestamp related to the data
+     * @param value     the data to combine
+     */
+    template<typename T>
+    void pushDecimated(PortImpl& port, const timespec& timestamp, const T& value);
+
+    template<typename E>
+    void pushDecimated(PortImpl& port, const timespec& timestamp, const std::vector<E>& value);
+
+    template<typename E>
+    void pushDecimated(PortImpl& port, const timespec& timestamp, const E* pData, size_t count);
+
+    void pushDecimated(PortImpl& port, const timespec& timestamp, const std::string& value);
+
+    /**
+     * @brief Passes a value to the port, applying the rate limit.
+     *
+     * @param port      the port that receives the value
+     * @param timestamp the timestamp related to the data
+     * @param value     the value, or a shared pointer to the value
+     */
+    template<typename T>
+    void publish(PortImpl& port, const timespec& timestamp, const T& value);
+
+    template<typename E>
+    void publish(PortImpl& port, const timespec& timestamp, const E* pData, size_t count);
+
+    /**
+     * @brief Passes a value to the port if the rate limiting interval has expired,
+     *        otherwise holds it until the port flushes it.
+     *
+     * @param port      the port that receives the value
+     * @param timestamp the timestamp related to the data
+     * @param value     the value, or a shared pointer to the value
+     */
+    template<typename T>
+    void pushRateLimited(PortImpl& port, const timespec& timestamp, const T& value);
+
+    /**
+     * @brief Checks the deadband before a value is passed to the port.
+     *
+     * @param value the value that is about to be passed to the port
+     * @return true if the value must be passed to the port
+     */
+    template<typename T>
+    bool isOutsideDeadband(const T& value);
+
+    template<typename E>
+    bool isOutsideDeadband(const std::vector<E>& value);
+
+    template<typename E>
+    bool isOutsideDeadband(const E* pData, size_t count);
+
+    bool isOutsideDeadband(const std::string& value);
+
+    /**
+     * @brief Records a pushed value in the history and in the archive file.
+     *
+     * @param timestamp the timestamp related to the data
+     * @param value     the pushed value
+     */
+    template<typename T>
+    void recordValue(const timespec& timestamp, const T& value);
+
+    template<typename E>
+    void recordValue(const timespec& timestamp, const std::vector<E>& value);
+
+    void recordValue(const timespec& timestamp, const std::string& value);
+
+    void recordElements(const timespec& timestamp, const void* pData, size_t count);
+
+    /**
+     * @brief Formats the recorded values for the command "history".
+     *
+     * @tparam T        the PV data type
+     * @param from      the oldest timestamp to return
+     * @param to        the newest timestamp to return
+     * @param maxValues maximum number of values to return
+     * @return one string per value: the timestamp followed by the elements
+     */
+    template<typename T>
+    parameters_t formatHistory(const timespec& from, const timespec& to, size_t maxValues) const;
+
+    /**
+     * @brief Counts a pushed value against the decimation factor.
+     *
+     * @return true if the value completes the decimation interval
+     */
+    bool countDecimation();
+
+    /**
+     * @brief Increments a counter updated by the producers.
+     *
+     * @param counter the counter to increment
+     */
+    void countProducerEvent(std::atomic<std::uint64_t>& counter);
+
+    /**
+     * @brief Adapts the effective decimation factor to the load of the port's
+     *        dispatch queue. Called at the end of each decimation interval.
+     */
+    void adaptDecimation();
+
+    /**
+     * @brief Decides if a producer of a multi-producer PV must take the
+     *        serialized path, and locks m_lockProducers if so.
+     *
+     * Values go through the lock-free path only when no stateful stage is
+     *  active and the port delivers them via its dispatch queue.
+     *
+     * @param port          the PV's port
+     * @param lockProducers locked when the function returns true
+     * @return true if the value must be pushed with m_lockProducers locked
+     */
+    bool serializeProducer(PortImpl& port, std::unique_lock<std::mutex>& lockProducers);
+
+    /**
+     * @brief Applies the decimation settings changed since the last push.
+     *
+     * @return false if no value must be passed to the control system
+     */
+    bool prepareDecimator();
+
+    /**
+     * @brief Moves an array or a string into a shared buffer and pushes it.
+     *
+     * @param timestamp the timestamp related to the data
+     * @param value     the data to move
+     */
+    template<typename T>
+    void pushOwned(const timespec& timestamp, T& value);
+
     parameters_t commandReplicate(const parameters_t& parameters);
     parameters_t commandDecimation(const parameters_t& parameters);
+    parameters_t commandDecimationMode(const parameters_t& parameters);
+    parameters_t commandAdaptiveDecimation(const parameters_t& parameters);
+    parameters_t commandDeadband(const parameters_t& parameters);
+    parameters_t commandDifferentialPush(const parameters_t& parameters);
+    parameters_t commandMaxPublishRate(const parameters_t& parameters);
+    parameters_t commandPushPolicy(const parameters_t& parameters);
+    parameters_t commandPushStatistics(const parameters_t& parameters);
+    parameters_t commandPushDiagnostics(const parameters_t& parameters);
+    parameters_t commandHistoryDepth(const parameters_t& parameters);
+    parameters_t commandHistory(const parameters_t& parameters);
+    parameters_t commandArchive(const parameters_t& parameters);
 
 };
 
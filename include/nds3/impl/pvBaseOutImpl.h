@@ -11,6 +11,7 @@
 #define NDSPVBASEOUTIMPL_H
 
 #include <string>
+#include <memory>
 #include "nds3/definitions.h"
 #include "nds3/impl/baseImpl.h"
 #include "nds3/impl/pvBaseImpl.h"
@@ -38,8 +39,11 @@ public:
      *
      * @param inputPVName the name of the input PV from which we want to receive
      *                    the values
+     * @param decimation  this PV receives one value every decimation values
+     * @param maxRate     maximum number of values per second written to this PV.
+     *                    0 means no limit
      */
-    void subscribeTo(const std::string& inputPVName);
+    void subscribeTo(const std::string& inputPVName, const std::uint32_t decimation = 1, const double maxRate = 0);
 
     virtual void initialize(FactoryBaseImpl& controlSystem);
 
@@ -61,6 +65,24 @@ public:
     virtual void write(const timespec& timestamp, const std::vector<double>& value);
     virtual void write(const timespec& timestamp, const std::string& value);
 
+    /**
+     * @brief Called when a subscribed input PV pushes a shared immutable value.
+     *
+     * The default implementation calls the write() overload that takes the
+     *  value by reference. PVs that store the value can override this and
+     *  keep a reference to the shared buffer instead of copying it.
+     *
+     * @param timestamp the value's timestamp
+     * @param pValue    pointer to the value. Must not be null
+     */
+    virtual void write(const timespec& timestamp, const std::shared_ptr<const std::int32_t>& pValue);
+    virtual void write(const timespec& timestamp, const std::shared_ptr<const double>& pValue);
+    virtual void write(const timespec& timestamp, const std::shared_ptr<const std::vector<std::int8_t> >& pValue);
+    virtual void write(const timespec& timestamp, const std::shared_ptr<const std::vector<std::uint8_t> >& pValue);
+    virtual void write(const timespec& timestamp, const std::shared_ptr<const std::vector<std::int32_t> >& pValue);
+    virtual void write(const timespec& timestamp, const std::shared_ptr<const std::vector<double> >& pValue);
+    virtual void write(const timespec& timestamp, const std::shared_ptr<const std::string>& pValue);
+
     virtual dataDirection_t getDataDirection() const;
 
     virtual std::string buildFullExternalName(const FactoryBaseImpl& controlSystem) const;
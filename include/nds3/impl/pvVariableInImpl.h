@@ -10,8 +10,9 @@
 #ifndef NDSPVVARIABLEINIMPL_H
 #define NDSPVVARIABLEINIMPL_H
 
-#include <mutex>
+#include <memory>
 #include "nds3/impl/pvBaseInImpl.h"
+#include "nds3/impl/seqlockImpl.h"
 
 namespace nds
 {
@@ -29,6 +30,14 @@ namespace nds
  *            - std::vector<std::int32_t>
  *            - std::vector<double>
  *            - std::string
+ *
+ * The std::int32_t and double values are stored in a SeqlockImpl, so the
+ *  control system reads never block the thread that sets the value.
+ *
+ * The other types are stored in an immutable snapshot, published with
+ *  std::atomic_store: a reader copies the value from the snapshot it loaded
+ *  while a writer fills and publishes a new one. A replaced snapshot that no
+ *  reader references is kept and filled by the next write.
  */
 template <typename T>
 class NDS3_API PVVariableInImpl: public PVBaseInImpl
@@ -49,6 +58,28 @@ public:
      */
     virtual void read(timespec* pTimestamp, T* pValue) const;
 
+    /**
+     * @brief Called by the control system to copy the stored value into a
+     *        buffer that it owns, without intermediate copies.
+     *
+     * @param pTimestamp pointer to a variable that will be filled with the stored timestamp
+     * @param pBuffer    the buffer that receives the elements
+     * @param capacity   the number of elements that fit into pBuffer
+     * @return the number of elements copied into pBuffer
+     */
+    virtual size_t read(timespec* pTimestamp, typename bufferElement_t<T>::type* pBuffer, size_t capacity) const;
+
+    /**
+     * @brief Returns a reference counted view of the stored value.
+     *
+     * The view is not modified by the following writes: each write publishes
+     *  a new value.
+     *
+     * @param pTimestamp pointer to a variable that will be filled with the stored timestamp
+     * @return the stored value
+     */
+    std::shared_ptr<const T> getSnapshot(timespec* pTimestamp) const;
+
     /**
      * @brief Return the PV data type
      *
@@ -77,13 +108,73 @@ public:
      */
     void setValue(const timespec& timestamp, const T& value);
 
+    /**
+     * @brief Move a value into the PV. The timestamp is set to the current time.
+     *
+     * @param value     value to move into the PV
+     */
+    void setValue(T&& value);
+
+    /**
+     * @brief Move a value and store its timestamp into the PV.
+     *
+     * The value is moved into a new snapshot, which the subscribed output
+     *  PVs share without copying it.
+     *
+     * @param timestamp timestamp related to the value
+     * @param value     value to move into the PV
+     */
+    void setValue(const timespec& timestamp, T&& value);
+
 private:
-    T m_value;
-    timespec m_timestamp;
+    /**
+     * @brief A version of the value with its timestamp.
+     */
+    struct snapshot_t
+    {
+        timespec m_timestamp;
+        T m_value;
+    };
+
+    /**
+     * @brief Stores the value and its timestamp, without pushing them to
+     *        the subscribers.
+     *
+     * @param timestamp timestamp related to the value
+     * @param value     value to store in the PV
+     * @return the published snapshot, or null for the scalars stored in
+     *         m_scalarValue
+     */
+    std::shared_ptr<const snapshot_t> storeValue(const timespec& timestamp, const T& value);
 
-    mutable std::mutex m_pvMutex;
+    /**
+     * @brief Returns a snapshot that is not referenced by anybody else,
+     *        reusing the spare one when available.
+     *
+     * @return a snapshot that the caller can fill
+     */
+    std::shared_ptr<snapshot_t> takeSpareSnapshot();
+
+    /**
+     * @brief Replaces the published snapshot. The replaced one becomes the
+     *        spare snapshot if no reader references it.
+     *
+     * @param pSnapshot the snapshot to publish. Must not be modified after
+     *                  the call
+     */
+    void publishSnapshot(const std::shared_ptr<snapshot_t>& pSnapshot);
+
+    std::shared_ptr<const snapshot_t> m_pSnapshot; ///< Published value. Access only via std::atomic_load/std::atomic_exchange
+    std::shared_ptr<snapshot_t> m_pSpareSnapshot;  ///< Reused by the next write. Access only via std::atomic_exchange/std::atomic_store
+
+    SeqlockImpl m_scalarValue; ///< Value and timestamp of the std::int32_t and double PVs
 
 };
 
+template<> void PVVariableInImpl<std::int32_t>::read(timespec* pTimestamp, std::int32_t* pValue) const;
+template<> void PVVariableInImpl<double>::read(timespec* pTimestamp, double* pValue) const;
+template<> std::shared_ptr<const PVVariableInImpl<std::int32_t>::snapshot_t> PVVariableInImpl<std::int32_t>::storeValue(const timespec& timestamp, const std::int32_t& value);
+template<> std::shared_ptr<const PVVariableInImpl<double>::snapshot_t> PVVariableInImpl<double>::storeValue(const timespec& timestamp, const double& value);
+
 }
 #endif // NDSPVVARIABLEINIMPL_H
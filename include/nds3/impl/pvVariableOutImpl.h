@@ -12,6 +12,7 @@
 
 #include <mutex>
 #include "nds3/impl/pvBaseOutImpl.h"
+#include "nds3/impl/seqlockImpl.h"
 
 namespace nds
 {
@@ -29,6 +30,14 @@ namespace nds
  *            - std::vector<std::int32_t>
  *            - std::vector<double>
  *            - std::string
+ *
+ * The std::int32_t and double values are stored in a SeqlockImpl: the
+ *  acquisition loops that poll them never block the control system writes.
+ *
+ * The other types are stored in immutable buffers: the mutex protects only
+ *  the exchange of the buffer pointer, while the values are copied outside
+ *  of it. A replaced buffer that no reader references is kept and filled by
+ *  the next write.
  */
 template <typename T>
 class PVVariableOutImpl: public PVBaseOutImpl
@@ -50,6 +59,17 @@ public:
      */
     virtual void read(timespec* pTimestamp, T* pValue) const;
 
+    /**
+     * @brief Called by the control system to copy the stored value into a
+     *        buffer that it owns, without intermediate copies.
+     *
+     * @param pTimestamp pointer to a variable that will be filled with the stored timestamp
+     * @param pBuffer    the buffer that receives the elements
+     * @param capacity   the number of elements that fit into pBuffer
+     * @return the number of elements copied into pBuffer
+     */
+    virtual size_t read(timespec* pTimestamp, typename bufferElement_t<T>::type* pBuffer, size_t capacity) const;
+
     /**
      * @brief Called when the control system wants to write a value into the PV.
      *
@@ -58,6 +78,25 @@ public:
      */
     virtual void write(const timespec& timestamp, const T& value);
 
+    /**
+     * @brief Called when a subscribed input PV pushes a shared value.
+     *
+     * The PV keeps a reference to the shared buffer instead of copying it.
+     *
+     * @param timestamp the timestamp to store in the PV
+     * @param pValue    pointer to the value to store in the PV
+     */
+    virtual void write(const timespec& timestamp, const std::shared_ptr<const T>& pValue);
+
+    /**
+     * @brief Moves a transient value into the PV.
+     *
+     * @param timestamp the timestamp to store in the PV
+     * @param value     the value to move into the PV. Left in a valid but
+     *                  unspecified state
+     */
+    void write(const timespec& timestamp, T&& value);
+
     /**
      * @brief Return the data type of the PV.
      * @return an enumeration representing the data type
@@ -79,14 +118,53 @@ public:
      */
     void getValue(timespec* pTime, T* pValue) const;
 
+    /**
+     * @brief Returns a reference counted view of the value stored in the PV.
+     *
+     * The view is not modified by the following writes: each write stores
+     *  a new buffer. For std::int32_t and double the view is a new copy of
+     *  the value: getValue() reads them without allocating memory.
+     *
+     * @param pTime  the timestamp stored in the PV
+     * @return the value stored in the PV
+     */
+    std::shared_ptr<const T> getSnapshot(timespec* pTime) const;
+
 private:
-    T m_value;            ///< Value stored in the PV
-    timespec m_timestamp; ///< Timestamp stored in the PV
+    /**
+     * @brief Returns a buffer that is not referenced by anybody else,
+     *        reusing the spare one when available.
+     *
+     * @return a buffer that the caller can fill
+     */
+    std::shared_ptr<T> takeSpareValue();
 
-    mutable std::mutex m_pvMutex; ///< Mutex used to synchronize the access to m_value and m_timestamp
+    /**
+     * @brief Replaces the stored buffer and its timestamp. The replaced
+     *        buffer becomes the spare one if nobody references it.
+     *
+     * @param timestamp the timestamp to store in the PV
+     * @param pValue    the buffer to store. Must not be modified after the call
+     * @param bOwnValue true if the buffer was allocated by this PV
+     */
+    void publishValue(const timespec& timestamp, const std::shared_ptr<const T>& pValue, bool bOwnValue);
+
+    std::shared_ptr<const T> m_pValue; ///< Value stored in the PV. May be shared with other PVs. Null for the scalars
+    bool m_bOwnValue;                  ///< True if m_pValue was allocated by this PV and can be reused
+    timespec m_timestamp;              ///< Timestamp stored in the PV
+    std::shared_ptr<T> m_pSpareValue;  ///< Buffer reused by the next write
+
+    mutable std::mutex m_pvMutex; ///< Mutex used to synchronize the access to m_pValue, m_timestamp and m_pSpareValue
+
+    SeqlockImpl m_scalarValue;         ///< Value and timestamp of the std::int32_t and double PVs
 
 };
 
+template<> void PVVariableOutImpl<std::int32_t>::write(const timespec& timestamp, const std::int32_t& value);
+template<> void PVVariableOutImpl<double>::write(const timespec& timestamp, const double& value);
+template<> void PVVariableOutImpl<std::int32_t>::getValue(timespec* pTime, std::int32_t* pValue) const;
+template<> void PVVariableOutImpl<double>::getValue(timespec* pTime, double* pValue) const;
+
 }
 #endif // NDSPVVARIABLEOUTIMPL_H
 
@@ -0,0 +1,64 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSSEQLOCKIMPL_H
+#define NDSSEQLOCKIMPL_H
+
+#include <atomic>
+#include <cstdint>
+#include <time.h>
+
+namespace nds
+{
+
+/**
+ * @brief Stores a scalar value and its timestamp so they can be read without
+ *        locking and without blocking the writers.
+ *
+ * A sequence number is odd while a writer is storing a new value: a reader
+ *  that sees an odd sequence, or a sequence that changed while it was
+ *  copying the value, copies it again. The writers serialize among
+ *  themselves on the sequence number, so no call ever enters the kernel.
+ *
+ * The supported types are std::int32_t and double.
+ */
+class SeqlockImpl
+{
+public:
+    SeqlockImpl();
+
+    /**
+     * @brief Stores a new value and its timestamp.
+     *
+     * @tparam T        the type of the value
+     * @param timestamp the timestamp to store
+     * @param value     the value to store
+     */
+    template<typename T>
+    void store(const timespec& timestamp, const T value);
+
+    /**
+     * @brief Copies the last stored value and its timestamp.
+     *
+     * @tparam T         the type of the value
+     * @param pTimestamp filled with the stored timestamp
+     * @param pValue     filled with the stored value
+     */
+    template<typename T>
+    void load(timespec* pTimestamp, T* pValue) const;
+
+private:
+    std::atomic<std::uint32_t> m_sequence;   ///< Odd while a writer is storing a value
+    std::atomic<std::uint64_t> m_value;      ///< Bits of the stored value
+    std::atomic<std::int64_t> m_seconds;     ///< Seconds of the stored timestamp
+    std::atomic<std::int64_t> m_nanoseconds; ///< Nanoseconds of the stored timestamp
+};
+
+}
+#endif // NDSSEQLOCKIMPL_H
@@ -35,6 +35,8 @@
 #include "nds3/factory.h"
 #include "nds3/stateMachine.h"
 #include "nds3/thread.h"
+#include "nds3/pushBatch.h"
+#include "nds3/archiveReader.h"
 #include "nds3/registerDevice.h"
 
 
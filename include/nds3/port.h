@@ -53,6 +53,23 @@ public:
      */
     Port(const std::string& name, const nodeType_t nodeType = nodeType_t::generic);
 
+    /**
+     * @brief Enables the asynchronous delivery of the values pushed by the port's PVs.
+     *
+     * When enabled, the values pushed by the PVs are stored in a bounded lock-free
+     *  queue and a dedicated thread delivers them to the control system: a slow
+     *  control system no longer stalls the threads that push the data.
+     * When the queue is full the push policy of the PV decides whether the pushing
+     *  thread waits for a free slot or a value is discarded (see PVBaseIn::setPushPolicy()).
+     *
+     * Must be called before the port is initialized.
+     *
+     * @param queueSize the number of values that the queue can hold (rounded up to
+     *                  the next power of 2), or 0 to push the values synchronously
+     *                  from the calling thread (default)
+     */
+    void setDispatchQueueSize(size_t queueSize);
+
 };
 
 }
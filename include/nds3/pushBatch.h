@@ -0,0 +1,95 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#ifndef NDSPUSHBATCH_H
+#define NDSPUSHBATCH_H
+
+/**
+ * @file pushBatch.h
+ *
+ * @brief Defines the nds::PushBatch class, which groups the values pushed by a
+ *        thread so that the control system receives them in one call.
+ *
+ * Include nds.h instead of this one, since nds3.h takes care of including all the
+ * necessary header files (including this one).
+ */
+
+#include <memory>
+#include "nds3/definitions.h"
+
+namespace nds
+{
+
+class PushBatchImpl;
+
+/**
+ * @ingroup datareadwrite
+ * @brief Collects the values pushed by the calling thread and delivers them to
+ *        the control system in one call per port.
+ *
+ * While a PushBatch object exists, the values that the thread which created it
+ *  pushes via PVBaseIn::push() or DataAcquisition::push() are held by the batch.
+ *  They are delivered when flush() is called or when the PushBatch is destroyed:
+ *  the control system receives all the values collected for each port in one
+ *  call and can post them with a single lock or notification.
+ *
+ * The subscribed output PVs and the replication destinations still receive the
+ *  values immediately.
+ *
+ * Example:
+ * @code
+ * {
+ *     nds::PushBatch batch;
+ *     for(size_t scanPVs(0); scanPVs != pvs.size(); ++scanPVs)
+ *     {
+ *         pvs[scanPVs].push(timestamp, values[scanPVs]);
+ *     }
+ * } // All the values are delivered here
+ * @endcode
+ *
+ * A PushBatch created while another one is active on the same thread does
+ *  nothing: the values are collected by the outer one.
+ */
+class NDS3_API PushBatch
+{
+public:
+    /**
+     * @brief Starts collecting the values pushed by the calling thread.
+     */
+    PushBatch();
+
+    /**
+     * @brief Delivers the collected values.
+     *
+     * The errors reported by the control system are logged: call flush()
+     *  before the destruction to receive them as exceptions.
+     */
+    ~PushBatch();
+
+    /**
+     * @brief Delivers the values collected so far and keeps collecting.
+     *
+     * A PushBatch kept alive for the whole acquisition loop and flushed at the end
+     *  of each cycle reuses its memory across the cycles.
+     *
+     * On the ports that deliver the values synchronously the exceptions thrown
+     *  by the control system are propagated, as by a push outside of the batch.
+     *  The values collected for the other ports are delivered anyway.
+     */
+    void flush();
+
+private:
+    PushBatch(const PushBatch&);
+    PushBatch& operator=(const PushBatch&);
+
+    std::shared_ptr<PushBatchImpl> m_pImplementation;
+};
+
+}
+#endif // NDSPUSHBATCH_H
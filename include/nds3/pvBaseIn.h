@@ -87,6 +87,66 @@ public:
     template<typename T>
     void push(const timespec& timestamp, const T& value);
 
+    /**
+     * @ingroup datareadwrite
+     * @brief Pushes a shared immutable value to the control system.
+     *
+     * Works like push(const timespec&, const T&), but the value is never copied:
+     *  the control system, the subscribed output PVs and the replication
+     *  destinations all receive a reference to the same buffer.
+     *
+     * The pushed buffer must not be modified after the call.
+     *
+     * @param timestamp    the new value's timestamp
+     * @param pValue       pointer to the value to push to the control system
+     */
+    template<typename T>
+    void push(const timespec& timestamp, const std::shared_ptr<const T>& pValue);
+
+#ifndef SWIG
+    /**
+     * @ingroup datareadwrite
+     * @brief Pushes a transient value to the control system, transferring its
+     *        ownership to NDS.
+     *
+     * Works like push(const timespec&, const T&), but arrays and strings are moved
+     *  into a shared buffer instead of being copied: the control system, the
+     *  subscribed output PVs and the replication destinations all receive a
+     *  reference to the moved buffer.
+     *
+     * The value is left in a valid but unspecified state.
+     *
+     * @param timestamp    the new value's timestamp
+     * @param value        the value to push to the control system
+     */
+    void push(const timespec& timestamp, std::int32_t&& value);
+    void push(const timespec& timestamp, double&& value);
+    void push(const timespec& timestamp, std::vector<std::int8_t>&& value);
+    void push(const timespec& timestamp, std::vector<std::uint8_t>&& value);
+    void push(const timespec& timestamp, std::vector<std::int32_t>&& value);
+    void push(const timespec& timestamp, std::vector<double>&& value);
+    void push(const timespec& timestamp, std::string&& value);
+#endif
+
+    /**
+     * @ingroup datareadwrite
+     * @brief Pushes an array stored in a contiguous buffer, e.g. a DMA buffer,
+     *        to the control system.
+     *
+     * Works like push(const timespec&, const T&) with T = std::vector<E>, but
+     *  the device does not need to copy the elements into a vector first.
+     *  The buffer can be reused as soon as the function returns.
+     *
+     * @tparam E           the type of the array's elements
+     * @param timestamp    the new value's timestamp
+     * @param pData        pointer to the first element
+     * @param count        number of elements in the buffer. An exception
+     *                     MaxElementsExceeded is thrown if it is bigger than
+     *                     the value set with setMaxElements()
+     */
+    template<typename E>
+    void push(const timespec& timestamp, const E* pData, size_t count);
+
     /**
      * @ingroup datareadwrite
      * @brief Specifies the decimation factor used when pushing data to the control system.
@@ -108,6 +168,319 @@ public:
      */
     void setDecimation(const std::uint32_t decimation);
 
+    /**
+     * @brief Specifies how the values pushed between two values passed to the
+     *        control system are combined.
+     *
+     * With the default mode decimationMode_t::sample the values skipped by the
+     *  decimation are discarded. The other modes pass to the control system the
+     *  element-wise average, minimum or maximum of the values pushed during the
+     *  decimation interval, or the maximum of all the values pushed since the
+     *  mode was selected.
+     *
+     * The subscribed output PVs and the replication destinations still receive
+     *  all the pushed values.
+     *
+     * The mode can also be changed by the control system with the command
+     *  "decimationMode".
+     *
+     * @param decimationMode the combination to apply
+     */
+    void setDecimationMode(const decimationMode_t decimationMode);
+
+    /**
+     * @brief Lets the PV raise the decimation factor while the port's dispatch
+     *        queue is filling up, and lower it again when the load falls.
+     *
+     * At the end of each decimation interval the factor is doubled if the
+     *  dispatch queue is more than half full, and halved if it is less than one
+     *  eighth full. The factor stays between the one set with setDecimation()
+     *  and maxDecimation. The ports that deliver the values synchronously have
+     *  no queue, so their PVs keep the factor set with setDecimation().
+     *
+     * The adaptive decimation can also be changed by the control system with
+     *  the command "adaptiveDecimation".
+     *
+     * @param maxDecimation the highest decimation factor, or 0 to disable the
+     *                      adaptive decimation (default)
+     */
+    void setAdaptiveDecimation(const std::uint32_t maxDecimation);
+
+    /**
+     * @brief Returns the decimation factor currently applied.
+     *
+     * @return the factor set with setDecimation(), or the one chosen by the
+     *         adaptive decimation
+     */
+    std::uint32_t getEffectiveDecimation() const;
+
+    /**
+     * @brief Specifies the minimum change that a value must have, compared with
+     *        the last value passed to the control system, to be passed too.
+     *
+     * The deadband is applied after the decimation: values that do not pass it
+     *  do not reach the control system, but the subscribed output PVs and the
+     *  replication destinations still receive them.
+     *
+     * Arrays are passed when any of their elements passes the deadband, or when
+     *  their size changes. The first value pushed after this call is always passed.
+     *
+     * The deadband can also be changed by the control system with the command
+     *  "deadband".
+     *
+     * @param type     the kind of deadband. The default is deadbandType_t::none
+     * @param deadband the minimum change. For deadbandType_t::relative it is a
+     *                 fraction of the last passed value (e.g. 0.01 for 1%)
+     */
+    void setDeadband(const deadbandType_t type, const double deadband);
+
+    /**
+     * @brief Limits the number of values per second passed to the control system,
+     *        regardless of the rate at which the values are pushed.
+     *
+     * When a value is pushed less than 1/maxRate seconds after the previous
+     *  value passed to the control system then the PV holds it instead of
+     *  passing it. Only the latest held value is kept, and it is passed to the
+     *  control system when the interval expires even if no other value is
+     *  pushed meanwhile.
+     *
+     * The limit is applied after the decimation and the deadband. The subscribed
+     *  output PVs and the replication destinations still receive all the values.
+     *
+     * The limit can also be changed by the control system with the command
+     *  "maxPublishRate".
+     *
+     * @param maxRate the maximum number of values per second, or 0 to pass all
+     *                the values (default)
+     */
+    void setMaxPublishRate(const double maxRate);
+
+    /**
+     * @brief Specifies what happens to the pushed values when the port delivers
+     *        them asynchronously and its dispatch queue is full.
+     *
+     * The default policy is pushPolicy_t::block, which guarantees the delivery of
+     *  all the pushed values. See Port::setDispatchQueueSize().
+     *
+     * pushPolicy_t::conflate suits the interrupt PVs that change faster than the
+     *  control system can follow, e.g. position readbacks: each dispatcher pass
+     *  delivers at most one value per PV, so the load on the control system
+     *  depends on the number of PVs and not on their update rate.
+     *
+     * The policy can also be changed by the control system with the command
+     *  "pushPolicy".
+     *
+     * @param pushPolicy the policy for this PV
+     */
+    void setPushPolicy(const pushPolicy_t pushPolicy);
+
+    /**
+     * @brief Declares that several threads push values into this PV
+     *        concurrently.
+     *
+     * By default a PV expects a single pushing thread. In multi-producer mode
+     *  the decimation is counted atomically and, when the PV's port delivers the
+     *  values via its dispatch queue (see Port::setDispatchQueueSize()) and no
+     *  decimation mode, deadband or receiver is active, the producers push
+     *  without locks. Otherwise the producers are serialized by a lock in the PV.
+     *
+     * The values pushed by one thread reach the control system in the order in
+     *  which they were pushed. The values pushed by different threads are
+     *  interleaved in the order in which they enter the dispatch queue, so
+     *  their timestamps may not be monotonic.
+     *
+     * Receivers can be added while the producers push: every value pushed
+     *  after the subscription or the replication has been set up reaches the
+     *  new receiver, as in the single producer mode.
+     *
+     * @param bMultiProducer true if several threads push into this PV
+     */
+    void setMultiProducer(const bool bMultiProducer);
+
+    /**
+     * @brief Enables the differential push of arrays that change only in a few
+     *        elements, e.g. lookup tables or status arrays.
+     *
+     * Each array delivered to the control system is compared with the previous
+     *  one and the interface receives the ranges of the changed elements, so
+     *  it can transfer only them. The whole array is pushed when the interface
+     *  does not support the changed ranges, when the size changes or when more
+     *  than half of the elements changed.
+     *
+     * The differential push can also be changed by the control system with the
+     *  command "differentialPush".
+     *
+     * @param bDifferentialPush true to push only the changes (default false)
+     */
+    void setDifferentialPush(const bool bDifferentialPush);
+
+    /**
+     * @brief Keeps the last pushed values in memory, so they can be retrieved
+     *        after an event (e.g. an interlock).
+     *
+     * The memory for the values is allocated by this call with room for
+     *  getMaxElements() elements per value: recording a value does not
+     *  allocate memory. Call setMaxElements() first.
+     *
+     * The history can also be enabled by the control system with the command
+     *  "historyDepth" and read with the command "history".
+     *
+     * @param depth the number of values to keep. 0 disables the history (default)
+     */
+    void setHistoryDepth(const size_t depth);
+
+    /**
+     * @brief Retrieves the recorded values with a timestamp in a range, from
+     *        the oldest to the newest.
+     *
+     * @tparam T          the PV data type
+     * @param from        the oldest timestamp to return
+     * @param to          the newest timestamp to return
+     * @param pTimestamps filled with the timestamps of the values
+     * @param pValues     filled with the values
+     */
+    template<typename T>
+    void getHistory(const timespec& from, const timespec& to, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const;
+
+    /**
+     * @brief Retrieves the last recorded values, from the oldest to the newest.
+     *
+     * @tparam T          the PV data type
+     * @param numValues   the number of values to retrieve
+     * @param pTimestamps filled with the timestamps of the values
+     * @param pValues     filled with the values
+     */
+    template<typename T>
+    void getHistory(const size_t numValues, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const;
+
+    /**
+     * @brief Records the pushed values into a circular archive file, for
+     *        offline analysis.
+     *
+     * The file is created with its final size, with room for numFrames values
+     *  of getMaxElements() elements each (call setMaxElements() first), and
+     *  mapped in memory. Each push copies the value and its timestamp into the
+     *  mapping without locking and without system calls: the operating system
+     *  writes the data to the disk in the background. When the file is full
+     *  the oldest frames are overwritten.
+     *
+     * The file can be read with ArchiveReader, also by another process while
+     *  the PV is still writing into it. An existing file with the same name is
+     *  replaced. The file attached previously to the PV is not deleted and,
+     *  since a producer may still be recording into it, stays mapped until
+     *  the PV is destroyed: this call is meant for occasional reconfiguration.
+     *
+     * The archive can also be controlled by the control system with the
+     *  command "archive", after the device enables it with
+     *  setArchiveDirectory().
+     *
+     * Throws ArchiveError if the file cannot be created.
+     *
+     * @param fileName  the name of the archive file
+     * @param numFrames the number of values kept in the file. 0 closes the archive
+     */
+    void setArchive(const std::string& fileName, const size_t numFrames);
+
+    /**
+     * @brief Lets the control system start and stop the archive with the
+     *        command "archive".
+     *
+     * The command accepts only a plain file name, without '/' or "..", and
+     *  creates the file in the specified directory: the control system cannot
+     *  replace files outside of it. The command is rejected until a directory
+     *  is set.
+     *
+     * @param directory the directory for the archive files created by the
+     *                  control system, or an empty string to reject the
+     *                  command (default)
+     */
+    void setArchiveDirectory(const std::string& directory);
+
+    /**
+     * @brief Returns the number of values pushed to the control system, including
+     *        the ones still waiting in the dispatch queue.
+     *
+     * The counters are also returned by the command "pushStatistics".
+     *
+     * @return the number of values handed to the port
+     */
+    std::uint64_t getEnqueuedCount() const;
+
+    /**
+     * @brief Returns the number of values delivered to the control system.
+     *
+     * @return the number of delivered values
+     */
+    std::uint64_t getDeliveredCount() const;
+
+    /**
+     * @brief Returns the number of values discarded because of the push policy.
+     *
+     * @return the number of discarded values
+     */
+    std::uint64_t getDroppedCount() const;
+
+    /**
+     * @brief Returns the number of values passed to push().
+     *
+     * Together with the counters below it tells at which stage the pushed
+     *  values are discarded. All the counters are also returned by the command
+     *  "pushDiagnostics".
+     *
+     * @return the number of pushed values
+     */
+    std::uint64_t getPushedCount() const;
+
+    /**
+     * @brief Returns the number of values discarded or combined by the decimation.
+     *
+     * @return the number of decimated values
+     */
+    std::uint64_t getDecimatedCount() const;
+
+    /**
+     * @brief Returns the number of values discarded by the deadband.
+     *
+     * @return the number of filtered values
+     */
+    std::uint64_t getFilteredCount() const;
+
+    /**
+     * @brief Returns the number of values replaced by a newer one because of the
+     *        maximum publish rate.
+     *
+     * @return the number of conflated values
+     */
+    std::uint64_t getConflatedCount() const;
+
+    /**
+     * @brief Returns the number of values not forwarded to a subscriber or to
+     *        a replication destination because of the link's decimation or
+     *        maximum rate.
+     *
+     * @return the number of skipped values
+     */
+    std::uint64_t getLinkSkippedCount() const;
+
+    /**
+     * @brief Returns the number of values lost between the port and the
+     *        control system.
+     *
+     * Each value handed to the port gets a sequence number, one higher than
+     *  the previous one. The gaps are the sequence numbers that did not reach
+     *  the control system.
+     *
+     * @return the number of missing sequence numbers
+     */
+    std::uint64_t getGapCount() const;
+
+    /**
+     * @brief Returns the highest sequence number delivered to the control system.
+     *
+     * @return the highest delivered sequence number, or 0 if no value was delivered
+     */
+    std::uint64_t getLastDeliveredSequence() const;
+
     /**
      * @brief Replicate the data from another input PV which may be located on any other
      *         device running in the same NDS process.
@@ -121,6 +494,18 @@ public:
      */
     void replicateFrom(const std::string& sourceInputPVName);
 
+    /**
+     * @brief Replicate the data from another input PV, skipping values on
+     *        this link only.
+     *
+     * @param sourceInputPVName the name of the input PV from which we want to
+     *                          receive the values
+     * @param decimation        this PV receives one value every decimation values
+     * @param maxRate           maximum number of values per second pushed to this PV.
+     *                          0 means no limit
+     */
+    void replicateFrom(const std::string& sourceInputPVName, const std::uint32_t decimation, const double maxRate);
+
 };
 
 }
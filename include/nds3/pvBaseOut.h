@@ -90,6 +90,17 @@ public:
      */
     void subscribeTo(const std::string& inputPVName);
 
+    /**
+     * @brief Subscribe the PV to an input PV, skipping values on this link only.
+     *
+     * @param inputPVName the name of the input PV from which we want to
+     *                     receive the values
+     * @param decimation  this PV receives one value every decimation values
+     * @param maxRate     maximum number of values per second written to this PV.
+     *                    0 means no limit
+     */
+    void subscribeTo(const std::string& inputPVName, const std::uint32_t decimation, const double maxRate);
+
 };
 
 }
@@ -96,6 +96,45 @@ public:
      * @param value     the value to write into the variable
      */
     void setValue(const timespec& timestamp, const T& value);
+
+#ifndef SWIG
+    /**
+     * @ingroup datareadwrite
+     * @brief Move a transient value into the variable.
+     *
+     * Works like setValue(const T&), but the variable takes ownership of the
+     *  value. value is left in a valid but unspecified state.
+     *
+     * @param value the value to move into the variable. The timestamp will
+     *              be taken via the getTimestamp() method.
+     */
+    void setValue(T&& value);
+
+    /**
+     * @ingroup datareadwrite
+     * @brief Move a transient value into the variable.
+     *
+     * Works like setValue(const timespec&, const T&), but the variable takes
+     *  ownership of the value. value is left in a valid but unspecified state.
+     *
+     * @param timestamp the timestamp to assign to the variable
+     * @param value     the value to move into the variable
+     */
+    void setValue(const timespec& timestamp, T&& value);
+
+    /**
+     * @ingroup datareadwrite
+     * @brief Retrieve a reference counted view of the variable's value.
+     *
+     * The value is not copied and the view is not modified by the following
+     *  calls to setValue(), which store the new values in other buffers.
+     *
+     * @param pTimestamp pointer to a timespec structure that will be filled
+     *                   with the variable's timestamp
+     * @return the variable's value
+     */
+    std::shared_ptr<const T> getSnapshot(timespec* pTimestamp) const;
+#endif
 };
 
 }
@@ -82,6 +82,23 @@ public:
      * @param pValue pointer to a variable that will be filled with the PV's value
      */
     void getValue(timespec* pTime, T* pValue) const;
+
+#ifndef SWIG
+    /**
+     * @ingroup datareadwrite
+     * @brief Retrieve a reference counted view of the value stored in the PV.
+     *
+     * The value is not copied and the view is not modified by the following
+     *  writes, which store the new values in other buffers.
+     *
+     * The std::int32_t and double values are copied into a new view: use
+     *  getValue() to read them without allocating memory.
+     *
+     * @param pTime  pointer to a timespec structure that will be filled with the PV's timestamp
+     * @return the PV's value
+     */
+    std::shared_ptr<const T> getSnapshot(timespec* pTime) const;
+#endif
 };
 
 }
@@ -0,0 +1,366 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "nds3/exceptions.h"
+#include "nds3/impl/archiveImpl.h"
+#include "nds3/impl/pvBaseImpl.h"
+
+namespace nds
+{
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The archive files are shared between processes and need lock-free 64 bit atomics");
+
+namespace
+{
+
+const char archiveMagic[8] = {'N', 'D', 'S', '3', 'A', 'R', 'C', 0};
+const std::uint32_t archiveVersion(1);
+
+/*
+ * Round an offset up to a multiple of the cache line size
+ *
+ *****/
+std::uint64_t alignOffset(const std::uint64_t offset)
+{
+    return (offset + 63) & ~(std::uint64_t)63;
+}
+
+std::string describeError(const std::string& action, const std::string& fileName)
+{
+    std::ostringstream errorMessage;
+    errorMessage << "Cannot " << action << " the archive file " << fileName << ": " << ::strerror(errno);
+    return errorMessage.str();
+}
+
+/*
+ * Build a value from the elements stored in the data area
+ *
+ *****/
+template<typename T>
+void assignValue(T* pValue, const std::uint8_t* pData, size_t /* count */)
+{
+    ::memcpy(pValue, pData, sizeof(T));
+}
+
+template<typename E>
+void assignValue(std::vector<E>* pValue, const std::uint8_t* pData, size_t count)
+{
+    pValue->resize(count);
+    if(count != 0)
+    {
+        ::memcpy(pValue->data(), pData, count * sizeof(E));
+    }
+}
+
+void assignValue(std::string* pValue, const std::uint8_t* pData, size_t count)
+{
+    pValue->assign((const char*)pData, count);
+}
+
+}
+
+ArchiveWriterImpl::ArchiveWriterImpl(const std::string& fileName, const std::string& pvName, const dataType_t dataType, const size_t numFrames, const size_t maxElements, const size_t elementSize):
+    m_fileName(fileName), m_numFrames(numFrames), m_maxElements(maxElements), m_elementSize(elementSize)
+{
+    if(numFrames == 0)
+    {
+        throw ArchiveError("The archive file " + fileName + " must hold at least one frame");
+    }
+
+    const std::uint64_t indexOffset(alignOffset(sizeof(archiveHeader_t)));
+    const std::uint64_t dataOffset(alignOffset(indexOffset + numFrames * sizeof(archiveIndexEntry_t)));
+    m_fileSize = dataOffset + numFrames * maxElements * elementSize;
+
+    // Allocate the blocks now, so the writes into the mapping never fail
+    //  for lack of disk space
+    /////////////////////////////////////////////////////////////////////
+    const std::string temporaryName(fileName + ".tmp");
+    int file(::open(temporaryName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+    if(file < 0)
+    {
+        throw ArchiveError(describeError("create", temporaryName));
+    }
+    if(::ftruncate(file, (off_t)m_fileSize) != 0)
+    {
+        const std::string errorMessage(describeError("resize", temporaryName));
+        ::close(file);
+        ::unlink(temporaryName.c_str());
+        throw ArchiveError(errorMessage);
+    }
+    const int allocateResult(::posix_fallocate(file, 0, (off_t)m_fileSize));
+    if(allocateResult != 0 && allocateResult != EINVAL && allocateResult != EOPNOTSUPP)
+    {
+        errno = allocateResult;
+        const std::string errorMessage(describeError("allocate", temporaryName));
+        ::close(file);
+        ::unlink(temporaryName.c_str());
+        throw ArchiveError(errorMessage);
+    }
+
+    void* pFile(::mmap(0, m_fileSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, file, 0));
+    ::close(file);
+    if(pFile == MAP_FAILED)
+    {
+        const std::string errorMessage(describeError("map", temporaryName));
+        ::unlink(temporaryName.c_str());
+        throw ArchiveError(errorMessage);
+    }
+    m_pFile = (std::uint8_t*)pFile;
+
+    // The file is filled with zeros: the index entries report no frame
+    ////////////////////////////////////////////////////////////////////
+    m_pHeader = new(m_pFile) archiveHeader_t;
+    m_pIndex = (archiveIndexEntry_t*)(m_pFile + indexOffset);
+    for(size_t scanEntries(0); scanEntries != numFrames; ++scanEntries)
+    {
+        new(&m_pIndex[scanEntries]) archiveIndexEntry_t;
+    }
+    m_pData = m_pFile + dataOffset;
+
+    ::memcpy(m_pHeader->m_magic, archiveMagic, sizeof(archiveMagic));
+    m_pHeader->m_version = archiveVersion;
+    m_pHeader->m_dataType = (std::uint32_t)dataType;
+    m_pHeader->m_elementSize = elementSize;
+    m_pHeader->m_maxElements = maxElements;
+    m_pHeader->m_numFrames = numFrames;
+    m_pHeader->m_indexOffset = indexOffset;
+    m_pHeader->m_dataOffset = dataOffset;
+    m_pHeader->m_fileSize = m_fileSize;
+    pvName.copy(m_pHeader->m_pvName, sizeof(m_pHeader->m_pvName) - 1);
+    m_pHeader->m_claimedFrames.store(0, std::memory_order_release);
+
+    if(::rename(temporaryName.c_str(), fileName.c_str()) != 0)
+    {
+        const std::string errorMessage(describeError("rename", temporaryName));
+        ::munmap(m_pFile, m_fileSize);
+        ::unlink(temporaryName.c_str());
+        throw ArchiveError(errorMessage);
+    }
+}
+
+ArchiveWriterImpl::~ArchiveWriterImpl()
+{
+    ::munmap(m_pFile, m_fileSize);
+}
+
+/*
+ * Each frame gets its own slot: a slot is taken over from the previous frame
+ *  by moving its sequence number to odd. A writer lapped by the ring finds a
+ *  newer frame in its slot and drops its own frame
+ *
+ *****/
+void ArchiveWriterImpl::record(const timespec& timestamp, const void* pData, size_t count)
+{
+    const std::uint64_t frame(m_pHeader->m_claimedFrames.fetch_add(1, std::memory_order_relaxed));
+    const size_t slot((size_t)(frame % m_numFrames));
+    archiveIndexEntry_t& entry(m_pIndex[slot]);
+
+    std::uint64_t sequence(entry.m_sequence.load(std::memory_order_relaxed));
+    for(;;)
+    {
+        if(sequence > 2 * frame)
+        {
+            return;
+        }
+        if((sequence & 1) != 0)
+        {
+            std::this_thread::yield();
+            sequence = entry.m_sequence.load(std::memory_order_relaxed);
+            continue;
+        }
+        if(entry.m_sequence.compare_exchange_weak(sequence, 2 * frame + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const size_t storeCount(count < m_maxElements ? count : m_maxElements);
+    if(storeCount != 0)
+    {
+        ::memcpy(m_pData + slot * m_maxElements * m_elementSize, pData, storeCount * m_elementSize);
+    }
+    entry.m_seconds.store((std::int64_t)timestamp.tv_sec, std::memory_order_relaxed);
+    entry.m_nanoseconds.store((std::int64_t)timestamp.tv_nsec, std::memory_order_relaxed);
+    entry.m_count.store(storeCount, std::memory_order_relaxed);
+
+    entry.m_sequence.store(2 * frame + 2, std::memory_order_release);
+}
+
+const std::string& ArchiveWriterImpl::getFileName() const
+{
+    return m_fileName;
+}
+
+ArchiveReaderImpl::ArchiveReaderImpl(const std::string& fileName)
+{
+    int file(::open(fileName.c_str(), O_RDONLY));
+    if(file < 0)
+    {
+        throw ArchiveError(describeError("open", fileName));
+    }
+    struct stat fileStatus;
+    if(::fstat(file, &fileStatus) != 0)
+    {
+        const std::string errorMessage(describeError("inspect", fileName));
+        ::close(file);
+        throw ArchiveError(errorMessage);
+    }
+    m_fileSize = (size_t)fileStatus.st_size;
+    if(m_fileSize < sizeof(archiveHeader_t))
+    {
+        ::close(file);
+        throw ArchiveError("The file " + fileName + " is not an archive file");
+    }
+
+    void* pFile(::mmap(0, m_fileSize, PROT_READ, MAP_SHARED, file, 0));
+    ::close(file);
+    if(pFile == MAP_FAILED)
+    {
+        throw ArchiveError(describeError("map", fileName));
+    }
+    m_pFile = (const std::uint8_t*)pFile;
+    m_pHeader = (const archiveHeader_t*)m_pFile;
+
+    // Check that the layout declared in the header fits into the file
+    ///////////////////////////////////////////////////////////////////
+    const archiveHeader_t& header(*m_pHeader);
+    if(::memcmp(header.m_magic, archiveMagic, sizeof(archiveMagic)) != 0 ||
+            header.m_version != archiveVersion ||
+            header.m_fileSize != m_fileSize ||
+            header.m_numFrames == 0 ||
+            header.m_indexOffset < sizeof(archiveHeader_t) ||
+            header.m_dataOffset < header.m_indexOffset + header.m_numFrames * sizeof(archiveIndexEntry_t) ||
+            header.m_dataOffset + header.m_numFrames * header.m_maxElements * header.m_elementSize > m_fileSize)
+    {
+        ::munmap((void*)m_pFile, m_fileSize);
+        throw ArchiveError("The file " + fileName + " is not an archive file or has an unsupported version");
+    }
+
+    m_pIndex = (const archiveIndexEntry_t*)(m_pFile + header.m_indexOffset);
+    m_pData = m_pFile + header.m_dataOffset;
+    m_numFrames = (size_t)header.m_numFrames;
+    m_maxElements = (size_t)header.m_maxElements;
+    m_elementSize = (size_t)header.m_elementSize;
+}
+
+ArchiveReaderImpl::~ArchiveReaderImpl()
+{
+    ::munmap((void*)m_pFile, m_fileSize);
+}
+
+std::string ArchiveReaderImpl::getPVName() const
+{
+    return std::string(m_pHeader->m_pvName, ::strnlen(m_pHeader->m_pvName, sizeof(m_pHeader->m_pvName)));
+}
+
+dataType_t ArchiveReaderImpl::getDataType() const
+{
+    return (dataType_t)m_pHeader->m_dataType;
+}
+
+size_t ArchiveReaderImpl::getMaxElements() const
+{
+    return m_maxElements;
+}
+
+size_t ArchiveReaderImpl::getNumFrames() const
+{
+    return m_numFrames;
+}
+
+std::uint64_t ArchiveReaderImpl::getClaimedFrames() const
+{
+    return m_pHeader->m_claimedFrames.load(std::memory_order_acquire);
+}
+
+/*
+ * The frame is valid only if its slot holds the same completed frame before
+ *  and after the copy
+ *
+ *****/
+template<typename T>
+bool ArchiveReaderImpl::read(const std::uint64_t frame, timespec* pTimestamp, T* pValue) const
+{
+    if(PVBaseImpl::getDataTypeForCPPType<T>() != getDataType())
+    {
+        throw ArchiveError("The requested type does not match the data type of the archived PV " + getPVName());
+    }
+
+    const size_t slot((size_t)(frame % m_numFrames));
+    const archiveIndexEntry_t& entry(m_pIndex[slot]);
+
+    const std::uint64_t sequence(entry.m_sequence.load(std::memory_order_acquire));
+    if(sequence != 2 * frame + 2)
+    {
+        return false;
+    }
+
+    const std::uint64_t count(entry.m_count.load(std::memory_order_relaxed));
+    pTimestamp->tv_sec = (time_t)entry.m_seconds.load(std::memory_order_relaxed);
+    pTimestamp->tv_nsec = (long)entry.m_nanoseconds.load(std::memory_order_relaxed);
+    assignValue(pValue, m_pData + slot * m_maxElements * m_elementSize, count < m_maxElements ? (size_t)count : m_maxElements);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return entry.m_sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+template<typename T>
+void ArchiveReaderImpl::readLast(const size_t maxFrames, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const
+{
+    pTimestamps->clear();
+    pValues->clear();
+
+    // Scan from the newest frame: the frames still being written and the
+    //  ones overwritten during the copy are skipped
+    //////////////////////////////////////////////////////////////////////
+    const std::uint64_t claimedFrames(getClaimedFrames());
+    const std::uint64_t firstFrame(claimedFrames > m_numFrames ? claimedFrames - m_numFrames : 0);
+    timespec timestamp;
+    T value;
+    for(std::uint64_t scanFrames(claimedFrames); scanFrames != firstFrame && pValues->size() != maxFrames; --scanFrames)
+    {
+        if(read(scanFrames - 1, &timestamp, &value))
+        {
+            pTimestamps->push_back(timestamp);
+            pValues->push_back(value);
+        }
+    }
+
+    std::reverse(pTimestamps->begin(), pTimestamps->end());
+    std::reverse(pValues->begin(), pValues->end());
+}
+
+template bool ArchiveReaderImpl::read<std::int32_t>(const std::uint64_t, timespec*, std::int32_t*) const;
+template bool ArchiveReaderImpl::read<double>(const std::uint64_t, timespec*, double*) const;
+template bool ArchiveReaderImpl::read<std::vector<std::int8_t> >(const std::uint64_t, timespec*, std::vector<std::int8_t>*) const;
+template bool ArchiveReaderImpl::read<std::vector<std::uint8_t> >(const std::uint64_t, timespec*, std::vector<std::uint8_t>*) const;
+template bool ArchiveReaderImpl::read<std::vector<std::int32_t> >(const std::uint64_t, timespec*, std::vector<std::int32_t>*) const;
+template bool ArchiveReaderImpl::read<std::vector<double> >(const std::uint64_t, timespec*, std::vector<double>*) const;
+template bool ArchiveReaderImpl::read<std::string>(const std::uint64_t, timespec*, std::string*) const;
+
+template void ArchiveReaderImpl::readLast<std::int32_t>(const size_t, std::vector<timespec>*, std::vector<std::int32_t>*) const;
+template void ArchiveReaderImpl::readLast<double>(const size_t, std::vector<timespec>*, std::vector<double>*) const;
+template void ArchiveReaderImpl::readLast<std::vector<std::int8_t> >(const size_t, std::vector<timespec>*, std::vector<std::vector<std::int8_t> >*) const;
+template void ArchiveReaderImpl::readLast<std::vector<std::uint8_t> >(const size_t, std::vector<timespec>*, std::vector<std::vector<std::uint8_t> >*) const;
+template void ArchiveReaderImpl::readLast<std::vector<std::int32_t> >(const size_t, std::vector<timespec>*, std::vector<std::vector<std::int32_t> >*) const;
+template void ArchiveReaderImpl::readLast<std::vector<double> >(const size_t, std::vector<timespec>*, std::vector<std::vector<double> >*) const;
+template void ArchiveReaderImpl::readLast<std::string>(const size_t, std::vector<timespec>*, std::vector<std::string>*) const;
+
+}
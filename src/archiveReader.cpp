@@ -0,0 +1,77 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include "nds3/archiveReader.h"
+#include "nds3/impl/archiveImpl.h"
+
+namespace nds
+{
+
+ArchiveReader::ArchiveReader(const std::string& fileName): m_pImplementation(std::make_shared<ArchiveReaderImpl>(fileName))
+{
+}
+
+ArchiveReader::~ArchiveReader()
+{
+}
+
+std::string ArchiveReader::getPVName() const
+{
+    return m_pImplementation->getPVName();
+}
+
+dataType_t ArchiveReader::getDataType() const
+{
+    return m_pImplementation->getDataType();
+}
+
+size_t ArchiveReader::getMaxElements() const
+{
+    return m_pImplementation->getMaxElements();
+}
+
+size_t ArchiveReader::getNumFrames() const
+{
+    return m_pImplementation->getNumFrames();
+}
+
+std::uint64_t ArchiveReader::getWrittenCount() const
+{
+    return m_pImplementation->getClaimedFrames();
+}
+
+template<typename T>
+bool ArchiveReader::read(const std::uint64_t frame, timespec* pTimestamp, T* pValue) const
+{
+    return m_pImplementation->read(frame, pTimestamp, pValue);
+}
+
+template<typename T>
+void ArchiveReader::readLast(const size_t maxFrames, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const
+{
+    m_pImplementation->readLast(maxFrames, pTimestamps, pValues);
+}
+
+template bool ArchiveReader::read<std::int32_t>(const std::uint64_t, timespec*, std::int32_t*) const;
+template bool ArchiveReader::read<double>(const std::uint64_t, timespec*, double*) const;
+template bool ArchiveReader::read<std::vector<std::int8_t> >(const std::uint64_t, timespec*, std::vector<std::int8_t>*) const;
+template bool ArchiveReader::read<std::vector<std::uint8_t> >(const std::uint64_t, timespec*, std::vector<std::uint8_t>*) const;
+template bool ArchiveReader::read<std::vector<std::int32_t> >(const std::uint64_t, timespec*, std::vector<std::int32_t>*) const;
+template bool ArchiveReader::read<std::vector<double> >(const std::uint64_t, timespec*, std::vector<double>*) const;
+template bool ArchiveReader::read<std::string>(const std::uint64_t, timespec*, std::string*) const;
+
+template void ArchiveReader::readLast<std::int32_t>(const size_t, std::vector<timespec>*, std::vector<std::int32_t>*) const;
+template void ArchiveReader::readLast<double>(const size_t, std::vector<timespec>*, std::vector<double>*) const;
+template void ArchiveReader::readLast<std::vector<std::int8_t> >(const size_t, std::vector<timespec>*, std::vector<std::vector<std::int8_t> >*) const;
+template void ArchiveReader::readLast<std::vector<std::uint8_t> >(const size_t, std::vector<timespec>*, std::vector<std::vector<std::uint8_t> >*) const;
+template void ArchiveReader::readLast<std::vector<std::int32_t> >(const size_t, std::vector<timespec>*, std::vector<std::vector<std::int32_t> >*) const;
+template void ArchiveReader::readLast<std::vector<double> >(const size_t, std::vector<timespec>*, std::vector<std::vector<double> >*) const;
+template void ArchiveReader::readLast<std::string>(const size_t, std::vector<timespec>*, std::vector<std::string>*) const;
+
+}
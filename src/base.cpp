@@ -90,6 +90,11 @@ void Base::setTimestampDelegate(getTimestampPlugin_t timestampDelegate)
     m_pImplementation->setTimestampDelegate(timestampDelegate);
 }
 
+void Base::setTimestampClock(const timestampClock_t clock)
+{
+    m_pImplementation->setTimestampClock(clock);
+}
+
 std::ostream& Base::getLogger(const logLevel_t logLevel)
 {
     return m_pImplementation->getLogger(logLevel);
@@ -19,9 +19,13 @@ namespace nds
 {
 
 BaseImpl::BaseImpl(const std::string& name): m_name(name), m_externalName(name), m_nodeLevel(0), m_pFactory(0),
-    m_timestampFunction(std::bind(&BaseImpl::getLocalTimestamp, this)),
+    m_bTimestampClock(false), m_timestampClock(timestampClock_t::realtime), m_timestampClockOffset(0),
+    m_pTimestampSource(0),
     m_logLevel(logLevel_t::warning), m_cachedFullName(name), m_cachedFullNameFromPort()
 {
+    m_timestampSources.emplace_back(new timestampSource_t());
+    m_pTimestampSource.store(m_timestampSources.back().get(), std::memory_order_release);
+
     // Register the commands for the log level
     //////////////////////////////////////////
     defineCommand("setLogLevelDebug", "", 0, std::bind(&BaseImpl::commandSetLogLevel, this, logLevel_t::debug, std::placeholders::_1));
@@ -142,6 +146,11 @@ void BaseImpl::initialize(FactoryBaseImpl &controlSystem)
     m_cachedFullExternalName = buildFullExternalName(controlSystem);
     m_cahcedFullExternalNameFromPort = buildFullExternalNameFromPort(controlSystem);
 
+    // The parent has been initialized: inherit its timestamp source.
+    // The children resolve their own source when they are initialized
+    ///////////////////////////////////////////////////////////////////
+    BaseImpl::resolveTimestampSource();
+
     // Remember where we can go get our logging streams
     ///////////////////////////////////////////////////
     m_logStreamGetter = controlSystem.getLogStreamGetter();
@@ -167,12 +176,75 @@ void BaseImpl::deinitialize()
 
 timespec BaseImpl::getTimestamp() const
 {
-    return m_timestampFunction();
+    const timestampSource_t* pTimestampSource(m_pTimestampSource.load(std::memory_order_acquire));
+    if(pTimestampSource->m_function)
+    {
+        return pTimestampSource->m_function();
+    }
+    return readTimestampClock(pTimestampSource->m_clock, pTimestampSource->m_clockOffset);
 }
 
 void BaseImpl::setTimestampDelegate(getTimestampPlugin_t timestampDelegate)
 {
     m_timestampFunction = timestampDelegate;
+    m_bTimestampClock = false;
+    resolveTimestampSource();
+}
+
+/*
+ * Select a built-in clock. The offset of the raw monotonic clock is measured
+ *  now and then kept constant, so the clock does not follow the NTP corrections
+ *
+ *****/
+void BaseImpl::setTimestampClock(const timestampClock_t clock)
+{
+    m_timestampFunction = getTimestampPlugin_t();
+    m_bTimestampClock = true;
+    m_timestampClock = clock;
+    m_timestampClockOffset = 0;
+
+    if(clock == timestampClock_t::monotonicRaw)
+    {
+        timespec realtime(readTimestampClock(timestampClock_t::realtime, 0));
+        timespec monotonic(readTimestampClock(timestampClock_t::monotonicRaw, 0));
+        m_timestampClockOffset = ((std::int64_t)realtime.tv_sec - (std::int64_t)monotonic.tv_sec) * 1000000000 +
+                ((std::int64_t)realtime.tv_nsec - (std::int64_t)monotonic.tv_nsec);
+    }
+
+    resolveTimestampSource();
+}
+
+/*
+ * The resolved source is published as a new immutable object, because
+ *  other threads may be calling getTimestamp() on this node. The parent's
+ *  source is copied: this node may outlive the parent and its sources
+ *
+ *****/
+void BaseImpl::resolveTimestampSource()
+{
+    std::unique_ptr<timestampSource_t> pTimestampSource(new timestampSource_t());
+    if(m_timestampFunction)
+    {
+        pTimestampSource->m_function = m_timestampFunction;
+    }
+    else if(m_bTimestampClock)
+    {
+        pTimestampSource->m_clock = m_timestampClock;
+        pTimestampSource->m_clockOffset = m_timestampClockOffset;
+    }
+    else
+    {
+        // Share the parent's source
+        ////////////////////////////
+        std::shared_ptr<NodeImpl> temporaryPointer = m_pParent.lock();
+        if(temporaryPointer != 0)
+        {
+            *pTimestampSource = *temporaryPointer->m_pTimestampSource.load(std::memory_order_acquire);
+        }
+    }
+
+    m_timestampSources.emplace_back(std::move(pTimestampSource));
+    m_pTimestampSource.store(m_timestampSources.back().get(), std::memory_order_release);
 }
 
 ThreadBaseImpl* BaseImpl::runInThread(const std::string &name, threadFunction_t function)
@@ -180,16 +252,37 @@ ThreadBaseImpl* BaseImpl::runInThread(const std::string &name, threadFunction_t
     return m_pFactory->runInThread(name, function);
 }
 
-timespec BaseImpl::getLocalTimestamp() const
+timespec BaseImpl::readTimestampClock(const timestampClock_t clock, const std::int64_t clockOffset)
 {
-    std::shared_ptr<NodeImpl> temporaryPointer = m_pParent.lock();
-    if(temporaryPointer != 0)
+    timespec timestamp;
+    switch(clock)
+    {
+#ifdef CLOCK_TAI
+    case timestampClock_t::tai:
+        clock_gettime(CLOCK_TAI, &timestamp);
+        return timestamp;
+#endif
+#ifdef CLOCK_MONOTONIC_RAW
+    case timestampClock_t::monotonicRaw:
     {
-        return temporaryPointer->getTimestamp();
+        clock_gettime(CLOCK_MONOTONIC_RAW, &timestamp);
+        std::int64_t nanoseconds((std::int64_t)timestamp.tv_sec * 1000000000 + timestamp.tv_nsec + clockOffset);
+        timestamp.tv_sec = (time_t)(nanoseconds / 1000000000);
+        timestamp.tv_nsec = (long)(nanoseconds % 1000000000);
+        return timestamp;
+    }
+#endif
+#ifdef CLOCK_REALTIME_COARSE
+    case timestampClock_t::realtimeCoarse:
+        clock_gettime(CLOCK_REALTIME_COARSE, &timestamp);
+        return timestamp;
+#endif
+    default:
+        // Clocks not supported by the system fall back to the system time
+        ///////////////////////////////////////////////////////////////////
+        clock_gettime(CLOCK_REALTIME, &timestamp);
+        return timestamp;
     }
-    timespec timestamp;
-    clock_gettime(CLOCK_REALTIME, &timestamp);
-    return timestamp;
 }
 
 std::ostream& BaseImpl::getLogger(const logLevel_t logLevel)
@@ -0,0 +1,104 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "nds3/impl/bufferPoolImpl.h"
+
+namespace nds
+{
+
+namespace
+{
+
+/*
+ * Prepare a buffer before handing it to the device
+ *
+ *****/
+template<typename T>
+void prepareBuffer(T&, size_t)
+{
+}
+
+template<typename E>
+void prepareBuffer(std::vector<E>& buffer, size_t maxElements)
+{
+    // Does not reallocate: the capacity is kept between leases
+    ///////////////////////////////////////////////////////////
+    buffer.resize(maxElements);
+}
+
+void prepareBuffer(std::string& buffer, size_t maxElements)
+{
+    buffer.reserve(maxElements);
+    buffer.clear();
+}
+
+}
+
+template<typename T>
+BufferPoolImpl<T>::BufferPoolImpl(size_t maxElements): m_maxElements(maxElements), m_nextBuffer(0)
+{
+}
+
+/*
+ * Look for a buffer referenced only by the pool
+ *
+ *****/
+template<typename T>
+std::shared_ptr<T> BufferPoolImpl<T>::lease()
+{
+    std::lock_guard<std::mutex> lock(m_lockBuffers);
+
+    const size_t numBuffers(m_buffers.size());
+    for(size_t scanBuffers(0); scanBuffers != numBuffers; ++scanBuffers)
+    {
+        size_t bufferIndex((m_nextBuffer + scanBuffers) % numBuffers);
+        std::shared_ptr<T>& pBuffer(m_buffers[bufferIndex]);
+
+        // Only the pool can copy its own references, and it does it while holding
+        //  m_lockBuffers: once the count drops to 1 it cannot grow behind our back.
+        ///////////////////////////////////////////////////////////////////////////
+        if(pBuffer.use_count() == 1)
+        {
+            // Make the last reader's accesses visible before the buffer is rewritten
+            /////////////////////////////////////////////////////////////////////////
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            m_nextBuffer = (bufferIndex + 1) % numBuffers;
+            prepareBuffer(*pBuffer, m_maxElements);
+            return pBuffer;
+        }
+    }
+
+    // All the buffers are in flight: grow the pool
+    ///////////////////////////////////////////////
+    std::shared_ptr<T> pNewBuffer(std::make_shared<T>());
+    prepareBuffer(*pNewBuffer, m_maxElements);
+    m_buffers.push_back(pNewBuffer);
+    return pNewBuffer;
+}
+
+template<typename T>
+size_t BufferPoolImpl<T>::getSize()
+{
+    std::lock_guard<std::mutex> lock(m_lockBuffers);
+    return m_buffers.size();
+}
+
+template class BufferPoolImpl<std::int32_t>;
+template class BufferPoolImpl<double>;
+template class BufferPoolImpl<std::vector<std::int8_t> >;
+template class BufferPoolImpl<std::vector<std::uint8_t> >;
+template class BufferPoolImpl<std::vector<std::int32_t> >;
+template class BufferPoolImpl<std::vector<double> >;
+template class BufferPoolImpl<std::string>;
+
+}
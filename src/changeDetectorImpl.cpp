@@ -0,0 +1,102 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include <cstring>
+#include "nds3/impl/changeDetectorImpl.h"
+
+namespace nds
+{
+
+namespace
+{
+
+/*
+ * Number of bytes compared at once: unchanged blocks cost one memcmp() call
+ *
+ *****/
+const size_t changeBlockBytes(256);
+
+}
+
+ChangeDetectorImpl::ChangeDetectorImpl(): m_bHasLastValue(false)
+{
+}
+
+void ChangeDetectorImpl::reset()
+{
+    m_bHasLastValue = false;
+    m_lastValue.clear();
+}
+
+/*
+ * Adjacent changed elements are merged into one range, also across the
+ *  blocks. The scan stops when more than half of the elements changed
+ *
+ *****/
+template<typename E>
+bool ChangeDetectorImpl::update(const E* pData, size_t count, changedRanges_t& changedRanges)
+{
+    changedRanges.clear();
+
+    const std::uint8_t* pBytes(reinterpret_cast<const std::uint8_t*>(pData));
+    const size_t byteSize(count * sizeof(E));
+    if(!m_bHasLastValue || m_lastValue.size() != byteSize)
+    {
+        m_lastValue.assign(pBytes, pBytes + byteSize);
+        m_bHasLastValue = true;
+        return false;
+    }
+
+    const size_t blockElements(changeBlockBytes / sizeof(E));
+    const size_t maxChangedElements(count / 2);
+    size_t changedElements(0);
+    E* pLastValue(reinterpret_cast<E*>(m_lastValue.data()));
+
+    for(size_t blockStart(0); blockStart < count; blockStart += blockElements)
+    {
+        const size_t blockCount(count - blockStart < blockElements ? count - blockStart : blockElements);
+        if(std::memcmp(pData + blockStart, pLastValue + blockStart, blockCount * sizeof(E)) == 0)
+        {
+            continue;
+        }
+
+        for(size_t scanElements(blockStart); scanElements != blockStart + blockCount; ++scanElements)
+        {
+            if(std::memcmp(pData + scanElements, pLastValue + scanElements, sizeof(E)) == 0)
+            {
+                continue;
+            }
+            if(!changedRanges.empty() && changedRanges.back().first + changedRanges.back().second == scanElements)
+            {
+                ++changedRanges.back().second;
+            }
+            else
+            {
+                changedRanges.push_back(std::make_pair(scanElements, (size_t)1));
+            }
+            ++changedElements;
+        }
+
+        if(changedElements > maxChangedElements)
+        {
+            m_lastValue.assign(pBytes, pBytes + byteSize);
+            changedRanges.clear();
+            return false;
+        }
+        std::memcpy(pLastValue + blockStart, pData + blockStart, blockCount * sizeof(E));
+    }
+    return true;
+}
+
+template bool ChangeDetectorImpl::update<std::int8_t>(const std::int8_t*, size_t, changedRanges_t&);
+template bool ChangeDetectorImpl::update<std::uint8_t>(const std::uint8_t*, size_t, changedRanges_t&);
+template bool ChangeDetectorImpl::update<std::int32_t>(const std::int32_t*, size_t, changedRanges_t&);
+template bool ChangeDetectorImpl::update<double>(const double*, size_t, changedRanges_t&);
+
+}
@@ -7,6 +7,7 @@
  * file included in the distribution.
  */
 
+#include <utility>
 #include "nds3/dataAcquisition.h"
 #include "nds3/impl/dataAcquisitionImpl.h"
 
@@ -63,10 +64,88 @@ void DataAcquisition<T>::setStartTimestampDelegate(getTimestampPlugin_t timestam
     std::static_pointer_cast<DataAcquisitionImpl<T> >(m_pImplementation)->setStartTimestampDelegate(timestampDelegate);
 }
 
+template <typename T>
+void DataAcquisition<T>::setDeadband(const deadbandType_t type, const double deadband)
+{
+    std::static_pointer_cast<DataAcquisitionImpl<T> >(m_pImplementation)->setDeadband(type, deadband);
+}
+
+template <typename T>
+void DataAcquisition<T>::setMaxPublishRate(const double maxRate)
+{
+    std::static_pointer_cast<DataAcquisitionImpl<T> >(m_pImplementation)->setMaxPublishRate(maxRate);
+}
+
+template <typename T>
+void DataAcquisition<T>::setMultiProducer(const bool bMultiProducer)
+{
+    std::static_pointer_cast<DataAcquisitionImpl<T> >(m_pImplementation)->setMultiProducer(bMultiProducer);
+}
+
+template <typename T>
+void DataAcquisition<T>::setAdaptiveDecimation(const std::uint32_t maxDecimation)
+{
+    std::static_pointer_cast<DataAcquisitionImpl<T> >(m_pImplementation)->setAdaptiveDecimation(maxDecimation);
+}
+
+template <typename T>
+void DataAcquisition<T>::setArchive(const std::string& fileName, const size_t numFrames)
+{
+    std::static_pointer_cast<DataAcquisitionImpl<T> >(m_pImplementation)->setArchive(fileName, numFrames);
+}
+
+template <typename T>
+void DataAcquisition<T>::setArchiveDirectory(const std::string& directory)
+{
+    std::static_pointer_cast<DataAcquisitionImpl<T> >(m_pImplementation)->setArchiveDirectory(directory);
+}
+
+template <typename T>
+void DataAcquisition<T>::setDisplayDownsampling(const downsamplingMode_t mode, const size_t targetSize)
+{
+    std::static_pointer_cast<DataAcquisitionImpl<T> >(m_pImplementation)->setDisplayDownsampling(mode, targetSize);
+}
+
+/*
+ * The push functions are called for each acquired frame: they don't copy
+ *  m_pImplementation to avoid the reference count updates
+ *
+ *****/
 template <typename T>
 void DataAcquisition<T>::push(const timespec& timestamp, const T& data)
 {
-    std::static_pointer_cast<DataAcquisitionImpl<T> >(m_pImplementation)->push(timestamp, data);
+    static_cast<DataAcquisitionImpl<T>*>(m_pImplementation.get())->push(timestamp, data);
+}
+
+template <typename T>
+void DataAcquisition<T>::push(const timespec& timestamp, const std::shared_ptr<const T>& pData)
+{
+    static_cast<DataAcquisitionImpl<T>*>(m_pImplementation.get())->push(timestamp, pData);
+}
+
+template <typename T>
+void DataAcquisition<T>::push(const timespec& timestamp, T&& data)
+{
+    static_cast<DataAcquisitionImpl<T>*>(m_pImplementation.get())->push(timestamp, std::move(data));
+}
+
+template <typename T>
+template <typename E>
+void DataAcquisition<T>::push(const timespec& timestamp, const E* pData, size_t count)
+{
+    static_cast<DataAcquisitionImpl<T>*>(m_pImplementation.get())->push(timestamp, pData, count);
+}
+
+template <typename T>
+std::shared_ptr<T> DataAcquisition<T>::lease()
+{
+    return static_cast<DataAcquisitionImpl<T>*>(m_pImplementation.get())->lease();
+}
+
+template <typename T>
+void DataAcquisition<T>::commit(const timespec& timestamp, std::shared_ptr<T>& pBuffer)
+{
+    static_cast<DataAcquisitionImpl<T>*>(m_pImplementation.get())->commit(timestamp, pBuffer);
 }
 
 template <typename T>
@@ -105,6 +184,12 @@ size_t DataAcquisition<T>::getDecimation()
     return std::static_pointer_cast<DataAcquisitionImpl<T> >(m_pImplementation)->getDecimation();
 }
 
+template <typename T>
+decimationMode_t DataAcquisition<T>::getDecimationMode()
+{
+    return std::static_pointer_cast<DataAcquisitionImpl<T> >(m_pImplementation)->getDecimationMode();
+}
+
 template <typename T>
 size_t DataAcquisition<T>::getSamplingMode()
 {
@@ -131,5 +216,10 @@ template class DataAcquisition<std::vector<std::int32_t> >;
 template class DataAcquisition<std::vector<double> >;
 template class DataAcquisition<std::string >;
 
+template void DataAcquisition<std::vector<std::int8_t> >::push<std::int8_t>(const timespec&, const std::int8_t*, size_t);
+template void DataAcquisition<std::vector<std::uint8_t> >::push<std::uint8_t>(const timespec&, const std::uint8_t*, size_t);
+template void DataAcquisition<std::vector<std::int32_t> >::push<std::int32_t>(const timespec&, const std::int32_t*, size_t);
+template void DataAcquisition<std::vector<double> >::push<double>(const timespec&, const double*, size_t);
+
 
 }
@@ -7,6 +7,8 @@
  * file included in the distribution.
  */
 
+#include <stdexcept>
+
 #include "nds3/definitions.h"
 #include "nds3/impl/dataAcquisitionImpl.h"
 #include "nds3/impl/stateMachineImpl.h"
@@ -28,13 +30,18 @@ DataAcquisitionImpl<T>::DataAcquisitionImpl(
         allowChange_t allowStateChangeFunction):
     NodeImpl(name, nodeType_t::dataSourceChannel),
     m_onStartDelegate(startFunction),
-    m_startTimestampFunction(std::bind(&BaseImpl::getTimestamp, this))
+    m_startTimestampFunction(std::bind(&BaseImpl::getTimestamp, this)),
+    m_bufferPool(maxElements),
+    m_displayMode(downsamplingMode_t::minMax),
+    m_displaySize(0),
+    m_effectiveDecimation(0)
 {
     // Add the children PVs
     m_dataPV.reset(new PVVariableInImpl<T>("Data"));
     m_dataPV->setMaxElements(maxElements);
     m_dataPV->setDescription("Acquired data");
     m_dataPV->setScanType(scanType_t::interrupt, 0);
+    m_dataPV->setPushPolicy(pushPolicy_t::dropOldest); // Bulk data: late frames are less useful than fresh ones
     addChild(m_dataPV);
 
     m_frequencyPV.reset(new PVVariableOutImpl<double>("Frequency"));
@@ -65,6 +72,26 @@ DataAcquisitionImpl<T>::DataAcquisitionImpl(
     m_decimationPV->write(getTimestamp(), (std::int32_t)1);
     addChild(m_decimationPV);
 
+    //add enumeration for decimation mode (same order as decimationMode_t)
+    enumerationStrings_t decimationModeEnumerationStrings;
+    decimationModeEnumerationStrings.push_back("Sample");
+    decimationModeEnumerationStrings.push_back("Average");
+    decimationModeEnumerationStrings.push_back("Minimum");
+    decimationModeEnumerationStrings.push_back("Maximum");
+    decimationModeEnumerationStrings.push_back("PeakHold");
+
+    m_decimationModePV.reset(new PVVariableOutImpl<std::int32_t>("DecimationMode"));
+    m_decimationModePV->setDescription("Decimation Mode");
+    m_decimationModePV->setScanType(scanType_t::passive, 0);
+    m_decimationModePV->setEnumeration(decimationModeEnumerationStrings);
+    m_decimationModePV->write(getTimestamp(), (std::int32_t)decimationMode_t::sample);
+    addChild(m_decimationModePV);
+
+    m_effectiveDecimationPV.reset(new PVVariableInImpl<std::int32_t>("EffectiveDecimation"));
+    m_effectiveDecimationPV->setDescription("Decimation applied to the acquired data");
+    m_effectiveDecimationPV->setScanType(scanType_t::interrupt, 0);
+    addChild(m_effectiveDecimationPV);
+
     //add enumeration for sampling mode
     enumerationStrings_t samplingModeEnumerationStrings;
     samplingModeEnumerationStrings.push_back("Single");
@@ -150,6 +177,19 @@ size_t DataAcquisitionImpl<T>::getDecimation()
     return (size_t)decimation;
 }
 
+template<typename T>
+decimationMode_t DataAcquisitionImpl<T>::getDecimationMode()
+{
+    std::int32_t decimationMode;
+    timespec timestamp;
+    m_decimationModePV->read(&timestamp, &decimationMode);
+    if(decimationMode < (std::int32_t)decimationMode_t::sample || decimationMode > (std::int32_t)decimationMode_t::peakHold)
+    {
+        return decimationMode_t::sample;
+    }
+    return (decimationMode_t)decimationMode;
+}
+
 template<typename T>
 size_t DataAcquisitionImpl<T>::getSamplingMode()
 {
@@ -180,10 +220,173 @@ void DataAcquisitionImpl<T>::setStartTimestampDelegate(getTimestampPlugin_t time
     m_startTimestampFunction = timestampDelegate;
 }
 
+template<typename T>
+void DataAcquisitionImpl<T>::setDeadband(const deadbandType_t type, const double deadband)
+{
+    m_dataPV->setDeadband(type, deadband);
+}
+
+template<typename T>
+void DataAcquisitionImpl<T>::setMaxPublishRate(const double maxRate)
+{
+    m_dataPV->setMaxPublishRate(maxRate);
+}
+
+template<typename T>
+void DataAcquisitionImpl<T>::setMultiProducer(const bool bMultiProducer)
+{
+    m_dataPV->setMultiProducer(bMultiProducer);
+    if(m_displayPV != 0)
+    {
+        m_displayPV->setMultiProducer(bMultiProducer);
+    }
+}
+
+template<typename T>
+void DataAcquisitionImpl<T>::setAdaptiveDecimation(const std::uint32_t maxDecimation)
+{
+    m_dataPV->setAdaptiveDecimation(maxDecimation);
+}
+
+template<typename T>
+void DataAcquisitionImpl<T>::setArchive(const std::string& fileName, const size_t numFrames)
+{
+    m_dataPV->setArchive(fileName, numFrames);
+}
+
+template<typename T>
+void DataAcquisitionImpl<T>::setArchiveDirectory(const std::string& directory)
+{
+    m_dataPV->setArchiveDirectory(directory);
+}
+
+template<typename T>
+void DataAcquisitionImpl<T>::setDisplayDownsampling(const downsamplingMode_t mode, const size_t targetSize)
+{
+    if(targetSize < 3)
+    {
+        throw std::logic_error("The display downsampling needs at least 3 elements");
+    }
+
+    m_displayMode.store(mode);
+    m_displaySize.store(targetSize);
+
+    if(m_displayPV == 0)
+    {
+        m_displayPV.reset(new PVVariableInImpl<T>("Display"));
+        m_displayPV->setMaxElements(m_dataPV->getMaxElements());
+        m_displayPV->setDescription("Downsampled data for the displays");
+        m_displayPV->setScanType(scanType_t::interrupt, 0);
+        m_displayPV->setPushPolicy(pushPolicy_t::dropOldest);
+        m_displayPV->setMultiProducer(m_dataPV->isMultiProducer());
+        addChild(m_displayPV);
+    }
+}
+
 template<typename T>
 void DataAcquisitionImpl<T>::push(const timespec& timestamp, const T& data)
 {
     m_dataPV->push(timestamp, data);
+    publishEffectiveDecimation(timestamp);
+    if(m_displayPV != 0)
+    {
+        pushDisplay(timestamp, data);
+    }
+}
+
+template<typename T>
+void DataAcquisitionImpl<T>::push(const timespec& timestamp, const std::shared_ptr<const T>& pData)
+{
+    m_dataPV->push(timestamp, pData);
+    publishEffectiveDecimation(timestamp);
+    if(m_displayPV != 0)
+    {
+        pushDisplay(timestamp, *pData);
+    }
+}
+
+template<typename T>
+void DataAcquisitionImpl<T>::push(const timespec& timestamp, T&& data)
+{
+    // Downsample before the data is moved away
+    ///////////////////////////////////////////
+    if(m_displayPV != 0)
+    {
+        pushDisplay(timestamp, data);
+    }
+    m_dataPV->push(timestamp, std::move(data));
+    publishEffectiveDecimation(timestamp);
+}
+
+template<typename T>
+template<typename E>
+void DataAcquisitionImpl<T>::push(const timespec& timestamp, const E* pData, size_t count)
+{
+    m_dataPV->push(timestamp, pData, count);
+    publishEffectiveDecimation(timestamp);
+    if(m_displayPV != 0)
+    {
+        pushDisplay(timestamp, pData, count);
+    }
+}
+
+/*
+ * The factor changes rarely: usually a push costs only an atomic load
+ *
+ *****/
+template<typename T>
+void DataAcquisitionImpl<T>::publishEffectiveDecimation(const timespec& timestamp)
+{
+    const std::int32_t decimation((std::int32_t)m_dataPV->getEffectiveDecimation());
+    if(m_effectiveDecimation.load(std::memory_order_relaxed) != decimation &&
+       m_effectiveDecimation.exchange(decimation) != decimation)
+    {
+        m_effectiveDecimationPV->setValue(timestamp, decimation);
+        m_effectiveDecimationPV->push(timestamp, decimation);
+    }
+}
+
+template<typename T>
+template<typename V>
+void DataAcquisitionImpl<T>::pushDisplay(const timespec& timestamp, const V& data)
+{
+    m_displayPV->push(timestamp, data);
+}
+
+template<typename T>
+template<typename E>
+void DataAcquisitionImpl<T>::pushDisplay(const timespec& timestamp, const std::vector<E>& data)
+{
+    pushDisplay(timestamp, data.data(), data.size());
+}
+
+/*
+ * The downsampled array is a new buffer: it is moved into the Display PV
+ *
+ *****/
+template<typename T>
+template<typename E>
+void DataAcquisitionImpl<T>::pushDisplay(const timespec& timestamp, const E* pData, size_t count)
+{
+    std::vector<E> display;
+    m_downsampler.downsample(m_displayMode.load(std::memory_order_relaxed), m_displaySize.load(std::memory_order_relaxed), pData, count, display);
+    m_displayPV->push(timestamp, std::move(display));
+}
+
+template<typename T>
+std::shared_ptr<T> DataAcquisitionImpl<T>::lease()
+{
+    return m_bufferPool.lease();
+}
+
+template<typename T>
+void DataAcquisitionImpl<T>::commit(const timespec& timestamp, std::shared_ptr<T>& pBuffer)
+{
+    // Give up the device's reference so the buffer can return to the pool as soon
+    //  as the control system and the subscribers release it
+    ////////////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<const T> pData(std::move(pBuffer));
+    push(timestamp, pData);
 }
 
 template<typename T>
@@ -191,6 +394,7 @@ void DataAcquisitionImpl<T>::onStart()
 {
     m_startTime = m_startTimestampFunction();
     m_dataPV->setDecimation((std::uint32_t)(m_decimationPV->getValue()));
+    m_dataPV->setDecimationMode(getDecimationMode());
     m_onStartDelegate();
 }
 
@@ -203,5 +407,10 @@ template class DataAcquisitionImpl<std::vector<std::int32_t> >;
 template class DataAcquisitionImpl<std::vector<double> >;
 template class DataAcquisitionImpl<std::string >;
 
+template void DataAcquisitionImpl<std::vector<std::int8_t> >::push<std::int8_t>(const timespec&, const std::int8_t*, size_t);
+template void DataAcquisitionImpl<std::vector<std::uint8_t> >::push<std::uint8_t>(const timespec&, const std::uint8_t*, size_t);
+template void DataAcquisitionImpl<std::vector<std::int32_t> >::push<std::int32_t>(const timespec&, const std::int32_t*, size_t);
+template void DataAcquisitionImpl<std::vector<double> >::push<double>(const timespec&, const double*, size_t);
+
 
 }
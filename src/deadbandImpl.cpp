@@ -0,0 +1,101 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include "nds3/impl/deadbandImpl.h"
+
+namespace nds
+{
+
+namespace
+{
+
+/*
+ * Number of elements compared between two checks of the result: large
+ *  enough for the vectorized loop, small enough to stop early on busy arrays
+ *
+ *****/
+const size_t deadbandBlockSize(256);
+
+}
+
+DeadbandImpl::DeadbandImpl(): m_type(deadbandType_t::none), m_deadband(0), m_bHasLastValue(false)
+{
+}
+
+void DeadbandImpl::reset(const deadbandType_t type, const double deadband)
+{
+    m_type = type;
+    m_deadband = deadband;
+    m_bHasLastValue = false;
+}
+
+/*
+ * Each block is converted to double precision, then compared without
+ *  branches. The comparisons are written as !(difference <= threshold) so
+ *  a NaN always passes the deadband
+ *
+ *****/
+template<typename E>
+bool DeadbandImpl::update(const E* pData, size_t count)
+{
+    if(m_type == deadbandType_t::none)
+    {
+        return true;
+    }
+
+    bool bPass(!m_bHasLastValue || count != m_lastValue.size());
+
+    double blockValues[deadbandBlockSize];
+    for(size_t blockStart(0); !bPass && blockStart < count; blockStart += deadbandBlockSize)
+    {
+        const size_t blockCount(count - blockStart < deadbandBlockSize ? count - blockStart : deadbandBlockSize);
+        const E* pBlockData(pData + blockStart);
+        const double* pLastValue(m_lastValue.data() + blockStart);
+
+        for(size_t scanElements(0); scanElements != blockCount; ++scanElements)
+        {
+            blockValues[scanElements] = (double)pBlockData[scanElements];
+        }
+
+        double passCount(0);
+        if(m_type == deadbandType_t::absolute)
+        {
+            for(size_t scanElements(0); scanElements != blockCount; ++scanElements)
+            {
+                const double difference(std::fabs(blockValues[scanElements] - pLastValue[scanElements]));
+                passCount += !(difference <= m_deadband) ? 1.0 : 0.0;
+            }
+        }
+        else
+        {
+            for(size_t scanElements(0); scanElements != blockCount; ++scanElements)
+            {
+                const double difference(std::fabs(blockValues[scanElements] - pLastValue[scanElements]));
+                passCount += !(difference <= m_deadband * std::fabs(pLastValue[scanElements])) ? 1.0 : 0.0;
+            }
+        }
+        bPass = passCount != 0;
+    }
+
+    if(bPass)
+    {
+        m_lastValue.assign(pData, pData + count);
+        m_bHasLastValue = true;
+    }
+    return bPass;
+}
+
+template bool DeadbandImpl::update<std::int8_t>(const std::int8_t*, size_t);
+template bool DeadbandImpl::update<std::uint8_t>(const std::uint8_t*, size_t);
+template bool DeadbandImpl::update<std::int32_t>(const std::int32_t*, size_t);
+template bool DeadbandImpl::update<double>(const double*, size_t);
+
+}
@@ -0,0 +1,126 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include <cmath>
+#include "nds3/impl/decimatorImpl.h"
+
+namespace nds
+{
+
+namespace
+{
+
+/*
+ * Round half away from zero. Written without branches so the loops that call
+ *  it are vectorized
+ *
+ *****/
+template<typename E>
+E toElement(const double value)
+{
+    return (E)(value + std::copysign(0.5, value));
+}
+
+template<>
+double toElement<double>(const double value)
+{
+    return value;
+}
+
+}
+
+DecimatorImpl::DecimatorImpl(): m_mode(decimationMode_t::sample), m_numValues(0)
+{
+}
+
+void DecimatorImpl::reset(const decimationMode_t mode)
+{
+    m_mode = mode;
+    m_numValues = 0;
+}
+
+decimationMode_t DecimatorImpl::getMode() const
+{
+    return m_mode;
+}
+
+template<typename E>
+void DecimatorImpl::accumulate(const E* pData, size_t count)
+{
+    if(m_numValues == 0 || count != m_accumulator.size() || m_mode == decimationMode_t::sample)
+    {
+        m_accumulator.assign(pData, pData + count);
+        m_numValues = 1;
+        return;
+    }
+
+    double* pAccumulator(m_accumulator.data());
+    switch(m_mode)
+    {
+    case decimationMode_t::average:
+        for(size_t scanElements(0); scanElements != count; ++scanElements)
+        {
+            pAccumulator[scanElements] += (double)pData[scanElements];
+        }
+        break;
+    case decimationMode_t::minimum:
+        for(size_t scanElements(0); scanElements != count; ++scanElements)
+        {
+            const double value((double)pData[scanElements]);
+            pAccumulator[scanElements] = value < pAccumulator[scanElements] ? value : pAccumulator[scanElements];
+        }
+        break;
+    case decimationMode_t::maximum:
+    case decimationMode_t::peakHold:
+        for(size_t scanElements(0); scanElements != count; ++scanElements)
+        {
+            const double value((double)pData[scanElements]);
+            pAccumulator[scanElements] = value > pAccumulator[scanElements] ? value : pAccumulator[scanElements];
+        }
+        break;
+    case decimationMode_t::sample:
+        break;
+    }
+    ++m_numValues;
+}
+
+size_t DecimatorImpl::getSize() const
+{
+    return m_accumulator.size();
+}
+
+template<typename E>
+void DecimatorImpl::getResult(E* pData)
+{
+    const size_t count(m_accumulator.size());
+    const double* pAccumulator(m_accumulator.data());
+    const double scale(m_mode == decimationMode_t::average && m_numValues != 0 ? 1.0 / (double)m_numValues : 1.0);
+
+    for(size_t scanElements(0); scanElements != count; ++scanElements)
+    {
+        pData[scanElements] = toElement<E>(pAccumulator[scanElements] * scale);
+    }
+
+    if(m_mode != decimationMode_t::peakHold)
+    {
+        m_numValues = 0;
+    }
+}
+
+template void DecimatorImpl::accumulate<std::int8_t>(const std::int8_t*, size_t);
+template void DecimatorImpl::accumulate<std::uint8_t>(const std::uint8_t*, size_t);
+template void DecimatorImpl::accumulate<std::int32_t>(const std::int32_t*, size_t);
+template void DecimatorImpl::accumulate<double>(const double*, size_t);
+
+template void DecimatorImpl::getResult<std::int8_t>(std::int8_t*);
+template void DecimatorImpl::getResult<std::uint8_t>(std::uint8_t*);
+template void DecimatorImpl::getResult<std::int32_t>(std::int32_t*);
+template void DecimatorImpl::getResult<double>(double*);
+
+}
@@ -0,0 +1,224 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include "nds3/impl/downsamplerImpl.h"
+
+namespace nds
+{
+
+namespace
+{
+
+/*
+ * Number of independent minimum, maximum and sum accumulators: the
+ *  reductions are vectorized across the lanes
+ *
+ *****/
+const size_t laneCount(8);
+
+/*
+ * Number of elements converted to double precision at once by the
+ *  largest triangle three buckets algorithm
+ *
+ *****/
+const size_t triangleBlockSize(256);
+
+/*
+ * Retrieve the minimum and the maximum values of a non-empty range
+ *
+ *****/
+template<typename E>
+void findMinMax(const E* pData, size_t count, E& minimum, E& maximum)
+{
+    E minLanes[laneCount];
+    E maxLanes[laneCount];
+    for(size_t scanLanes(0); scanLanes != laneCount; ++scanLanes)
+    {
+        minLanes[scanLanes] = pData[0];
+        maxLanes[scanLanes] = pData[0];
+    }
+
+    size_t scanElements(0);
+    for(; scanElements + laneCount <= count; scanElements += laneCount)
+    {
+        for(size_t scanLanes(0); scanLanes != laneCount; ++scanLanes)
+        {
+            const E value(pData[scanElements + scanLanes]);
+            minLanes[scanLanes] = value < minLanes[scanLanes] ? value : minLanes[scanLanes];
+            maxLanes[scanLanes] = value > maxLanes[scanLanes] ? value : maxLanes[scanLanes];
+        }
+    }
+    for(; scanElements != count; ++scanElements)
+    {
+        const E value(pData[scanElements]);
+        minLanes[0] = value < minLanes[0] ? value : minLanes[0];
+        maxLanes[0] = value > maxLanes[0] ? value : maxLanes[0];
+    }
+
+    minimum = minLanes[0];
+    maximum = maxLanes[0];
+    for(size_t scanLanes(1); scanLanes != laneCount; ++scanLanes)
+    {
+        minimum = minLanes[scanLanes] < minimum ? minLanes[scanLanes] : minimum;
+        maximum = maxLanes[scanLanes] > maximum ? maxLanes[scanLanes] : maximum;
+    }
+}
+
+/*
+ * Calculate the average of a non-empty range
+ *
+ *****/
+template<typename E>
+double average(const E* pData, size_t count)
+{
+    double sumLanes[laneCount] = {0};
+
+    size_t scanElements(0);
+    for(; scanElements + laneCount <= count; scanElements += laneCount)
+    {
+        for(size_t scanLanes(0); scanLanes != laneCount; ++scanLanes)
+        {
+            sumLanes[scanLanes] += (double)pData[scanElements + scanLanes];
+        }
+    }
+    for(; scanElements != count; ++scanElements)
+    {
+        sumLanes[0] += (double)pData[scanElements];
+    }
+
+    double sum(0);
+    for(size_t scanLanes(0); scanLanes != laneCount; ++scanLanes)
+    {
+        sum += sumLanes[scanLanes];
+    }
+    return sum / (double)count;
+}
+
+}
+
+template<typename E>
+void DownsamplerImpl::downsample(const downsamplingMode_t mode, const size_t targetSize, const E* pData, size_t count, std::vector<E>& output)
+{
+    if(count <= targetSize)
+    {
+        output.assign(pData, pData + count);
+        return;
+    }
+
+    switch(mode)
+    {
+    case downsamplingMode_t::minMax:
+        minMax(targetSize, pData, count, output);
+        break;
+    case downsamplingMode_t::lttb:
+        largestTriangle(targetSize, pData, count, output);
+        break;
+    }
+}
+
+/*
+ * Each bucket is replaced by its minimum followed by its maximum, so a
+ *  display drawing lines between the points fills the envelope
+ *
+ *****/
+template<typename E>
+void DownsamplerImpl::minMax(const size_t targetSize, const E* pData, size_t count, std::vector<E>& output)
+{
+    const size_t numBuckets(targetSize / 2);
+    output.resize(numBuckets * 2);
+
+    E* pOutput(output.data());
+    for(size_t bucket(0); bucket != numBuckets; ++bucket)
+    {
+        const size_t start(bucket * count / numBuckets);
+        const size_t end((bucket + 1) * count / numBuckets);
+        findMinMax(pData + start, end - start, pOutput[bucket * 2], pOutput[bucket * 2 + 1]);
+    }
+}
+
+/*
+ * The first and the last elements are always selected. From each bucket in
+ *  between the function selects the element that forms the largest triangle
+ *  with the element selected from the previous bucket and the average of the
+ *  next bucket. The areas are computed in blocks by a branch-free loop, then
+ *  scanned for the largest one.
+ *
+ * The selected elements are not equally spaced in the original array
+ *
+ *****/
+template<typename E>
+void DownsamplerImpl::largestTriangle(const size_t targetSize, const E* pData, size_t count, std::vector<E>& output)
+{
+    const size_t numBuckets(targetSize - 2);
+    output.resize(targetSize);
+    output[0] = pData[0];
+
+    double ramp[triangleBlockSize];
+    for(size_t scanElements(0); scanElements != triangleBlockSize; ++scanElements)
+    {
+        ramp[scanElements] = (double)scanElements;
+    }
+
+    double blockAreas[triangleBlockSize];
+    size_t selected(0);
+    for(size_t bucket(0); bucket != numBuckets; ++bucket)
+    {
+        const size_t start(1 + bucket * (count - 2) / numBuckets);
+        const size_t end(1 + (bucket + 1) * (count - 2) / numBuckets);
+        const size_t nextEnd(bucket + 1 == numBuckets ? count : 1 + (bucket + 2) * (count - 2) / numBuckets);
+
+        const double nextX((double)(end + nextEnd - 1) / 2.0);
+        const double nextY(average(pData + end, nextEnd - end));
+        const double selectedX((double)selected);
+        const double selectedY((double)pData[selected]);
+        const double deltaX(selectedX - nextX);
+        const double deltaY(nextY - selectedY);
+
+        double largestArea(-1);
+        size_t largestIndex(start);
+        for(size_t blockStart(start); blockStart < end; blockStart += triangleBlockSize)
+        {
+            const size_t blockCount(end - blockStart < triangleBlockSize ? end - blockStart : triangleBlockSize);
+            const E* pBlockData(pData + blockStart);
+            const double blockX((double)blockStart);
+
+            // The doubled area: only the comparison matters
+            ////////////////////////////////////////////////
+            for(size_t scanElements(0); scanElements != blockCount; ++scanElements)
+            {
+                const double x(blockX + ramp[scanElements]);
+                const double y((double)pBlockData[scanElements]);
+                blockAreas[scanElements] = std::fabs(deltaX * (y - selectedY) - (selectedX - x) * deltaY);
+            }
+
+            for(size_t scanElements(0); scanElements != blockCount; ++scanElements)
+            {
+                if(blockAreas[scanElements] > largestArea)
+                {
+                    largestArea = blockAreas[scanElements];
+                    largestIndex = blockStart + scanElements;
+                }
+            }
+        }
+
+        selected = largestIndex;
+        output[bucket + 1] = pData[selected];
+    }
+
+    output[targetSize - 1] = pData[count - 1];
+}
+
+template void DownsamplerImpl::downsample<std::int8_t>(const downsamplingMode_t, const size_t, const std::int8_t*, size_t, std::vector<std::int8_t>&);
+template void DownsamplerImpl::downsample<std::uint8_t>(const downsamplingMode_t, const size_t, const std::uint8_t*, size_t, std::vector<std::uint8_t>&);
+template void DownsamplerImpl::downsample<std::int32_t>(const downsamplingMode_t, const size_t, const std::int32_t*, size_t, std::vector<std::int32_t>&);
+template void DownsamplerImpl::downsample<double>(const downsamplingMode_t, const size_t, const double*, size_t, std::vector<double>&);
+
+}
@@ -40,6 +40,14 @@ NoPortDefinedError::NoPortDefinedError(const std::string &what): std::logic_erro
 {
 }
 
+MaxElementsExceeded::MaxElementsExceeded(const std::string &what): NdsError(what)
+{
+}
+
+ArchiveError::ArchiveError(const std::string &what): NdsError(what)
+{
+}
+
 FactoryError::FactoryError(const std::string &what): NdsError(what)
 {
 }
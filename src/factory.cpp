@@ -53,7 +53,12 @@ void Factory::destroyDevice(const std::string& deviceName)
 
 void Factory::subscribe(const std::string& pushFrom, const std::string& pushTo)
 {
-    NdsFactoryImpl::getInstance().subscribe(pushFrom, pushTo);
+    NdsFactoryImpl::getInstance().subscribe(pushFrom, pushTo, 1, 0);
+}
+
+void Factory::subscribe(const std::string& pushFrom, const std::string& pushTo, const std::uint32_t decimation, const double maxRate)
+{
+    NdsFactoryImpl::getInstance().subscribe(pushFrom, pushTo, decimation, maxRate);
 }
 
 void Factory::unsubscribe(const std::string& pushTo)
@@ -63,7 +68,12 @@ void Factory::unsubscribe(const std::string& pushTo)
 
 void Factory::replicate(const std::string &replicateSource, const std::string &replicateDestination)
 {
-    NdsFactoryImpl::getInstance().replicate(replicateSource, replicateDestination);
+    NdsFactoryImpl::getInstance().replicate(replicateSource, replicateDestination, 1, 0);
+}
+
+void Factory::replicate(const std::string &replicateSource, const std::string &replicateDestination, const std::uint32_t decimation, const double maxRate)
+{
+    NdsFactoryImpl::getInstance().replicate(replicateSource, replicateDestination, decimation, maxRate);
 }
 
 void Factory::stopReplicationTo(const std::string &destination)
@@ -0,0 +1,198 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include "nds3/impl/historyImpl.h"
+
+namespace nds
+{
+
+namespace
+{
+
+/*
+ * Return true if the timestamp a precedes the timestamp b
+ *
+ *****/
+bool isBefore(const timespec& a, const timespec& b)
+{
+    return a.tv_sec < b.tv_sec || (a.tv_sec == b.tv_sec && a.tv_nsec < b.tv_nsec);
+}
+
+/*
+ * Build a value from the elements stored in the slab
+ *
+ *****/
+template<typename T>
+void assignValue(T* pValue, const std::uint8_t* pData, size_t /* count */)
+{
+    ::memcpy(pValue, pData, sizeof(T));
+}
+
+template<typename E>
+void assignValue(std::vector<E>* pValue, const std::uint8_t* pData, size_t count)
+{
+    pValue->resize(count);
+    if(count != 0)
+    {
+        ::memcpy(pValue->data(), pData, count * sizeof(E));
+    }
+}
+
+void assignValue(std::string* pValue, const std::uint8_t* pData, size_t count)
+{
+    pValue->assign((const char*)pData, count);
+}
+
+}
+
+HistoryImpl::storage_t::storage_t(const size_t depth, const size_t slotSize): m_slab(depth * slotSize), m_entries(depth)
+{
+}
+
+HistoryImpl::HistoryImpl(): m_maxElements(0), m_elementSize(0), m_nextEntry(0), m_numEntries(0)
+{
+}
+
+void HistoryImpl::reset(const size_t depth, const size_t maxElements, const size_t elementSize)
+{
+    std::shared_ptr<storage_t> pStorage;
+    if(depth != 0)
+    {
+        pStorage = std::make_shared<storage_t>(depth, maxElements * elementSize);
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    m_maxElements = maxElements;
+    m_elementSize = elementSize;
+    m_pStorage.swap(pStorage);
+    m_nextEntry = 0;
+    m_numEntries = 0;
+}
+
+size_t HistoryImpl::getDepth() const
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_pStorage == 0 ? 0 : m_pStorage->m_entries.size();
+}
+
+/*
+ * The sequence number of the slot is odd while the elements are copied, so
+ *  a query copying the same slot outside the lock discards them
+ *
+ *****/
+void HistoryImpl::record(const timespec& timestamp, const void* pData, size_t count)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if(m_pStorage == 0)
+    {
+        return;
+    }
+    const size_t depth(m_pStorage->m_entries.size());
+
+    entry_t& entry(m_pStorage->m_entries[m_nextEntry]);
+    const std::uint64_t sequence(entry.m_sequence.load(std::memory_order_relaxed));
+    entry.m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const size_t storeCount(count < m_maxElements ? count : m_maxElements);
+    const size_t slotSize(m_maxElements * m_elementSize);
+    if(storeCount != 0)
+    {
+        ::memcpy(m_pStorage->m_slab.data() + m_nextEntry * slotSize, pData, storeCount * m_elementSize);
+    }
+
+    entry.m_timestamp = timestamp;
+    entry.m_count = storeCount;
+    entry.m_sequence.store(sequence + 2, std::memory_order_release);
+
+    m_nextEntry = (m_nextEntry + 1) % depth;
+    if(m_numEntries != depth)
+    {
+        ++m_numEntries;
+    }
+}
+
+/*
+ * Scan the ring from the newest value to the oldest one while holding the
+ *  lock, then copy the selected values in chronological order without it
+ *
+ *****/
+template<typename T>
+void HistoryImpl::get(const timespec& from, const timespec& to, size_t maxValues, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const
+{
+    pTimestamps->clear();
+    pValues->clear();
+
+    struct selected_t
+    {
+        size_t m_entry;
+        timespec m_timestamp;
+        size_t m_count;
+        std::uint64_t m_sequence;
+    };
+    std::vector<selected_t> selectedEntries;
+    std::shared_ptr<const storage_t> pStorage;
+    size_t slotSize;
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+
+        if(m_pStorage == 0)
+        {
+            return;
+        }
+        pStorage = m_pStorage;
+        slotSize = m_maxElements * m_elementSize;
+
+        const size_t depth(pStorage->m_entries.size());
+        selectedEntries.reserve(maxValues < m_numEntries ? maxValues : m_numEntries);
+        for(size_t scanEntries(0); scanEntries != m_numEntries && selectedEntries.size() != maxValues; ++scanEntries)
+        {
+            const size_t entryIndex((m_nextEntry + depth - 1 - scanEntries) % depth);
+            const entry_t& entry(pStorage->m_entries[entryIndex]);
+            if(!isBefore(entry.m_timestamp, from) && !isBefore(to, entry.m_timestamp))
+            {
+                const selected_t selected = {entryIndex, entry.m_timestamp, entry.m_count, entry.m_sequence.load(std::memory_order_relaxed)};
+                selectedEntries.push_back(selected);
+            }
+        }
+    }
+
+    // Discard the values overwritten by record() while they were copied
+    ////////////////////////////////////////////////////////////////////
+    pTimestamps->reserve(selectedEntries.size());
+    pValues->reserve(selectedEntries.size());
+    for(typename std::vector<selected_t>::const_reverse_iterator scanSelected(selectedEntries.rbegin()), endSelected(selectedEntries.rend()); scanSelected != endSelected; ++scanSelected)
+    {
+        T value;
+        assignValue(&value, pStorage->m_slab.data() + scanSelected->m_entry * slotSize, scanSelected->m_count);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(pStorage->m_entries[scanSelected->m_entry].m_sequence.load(std::memory_order_relaxed) != scanSelected->m_sequence)
+        {
+            continue;
+        }
+        pTimestamps->push_back(scanSelected->m_timestamp);
+        pValues->push_back(std::move(value));
+    }
+}
+
+template void HistoryImpl::get<std::int32_t>(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::int32_t>*) const;
+template void HistoryImpl::get<double>(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<double>*) const;
+template void HistoryImpl::get<std::vector<std::int8_t> >(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::vector<std::int8_t> >*) const;
+template void HistoryImpl::get<std::vector<std::uint8_t> >(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::vector<std::uint8_t> >*) const;
+template void HistoryImpl::get<std::vector<std::int32_t> >(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::vector<std::int32_t> >*) const;
+template void HistoryImpl::get<std::vector<double> >(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::vector<double> >*) const;
+template void HistoryImpl::get<std::string>(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::string>*) const;
+
+}
@@ -16,5 +16,95 @@ InterfaceBaseImpl::~InterfaceBaseImpl()
 {
 }
 
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::int32_t>& pValue)
+{
+    push(pv, timestamp, *pValue);
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const double>& pValue)
+{
+    push(pv, timestamp, *pValue);
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::vector<std::int8_t> >& pValue)
+{
+    push(pv, timestamp, *pValue);
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::vector<std::uint8_t> >& pValue)
+{
+    push(pv, timestamp, *pValue);
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::vector<std::int32_t> >& pValue)
+{
+    push(pv, timestamp, *pValue);
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::vector<double> >& pValue)
+{
+    push(pv, timestamp, *pValue);
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::string>& pValue)
+{
+    push(pv, timestamp, *pValue);
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::int8_t* pData, size_t count)
+{
+    push(pv, timestamp, std::vector<std::int8_t>(pData, pData + count));
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::uint8_t* pData, size_t count)
+{
+    push(pv, timestamp, std::vector<std::uint8_t>(pData, pData + count));
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::int32_t* pData, size_t count)
+{
+    push(pv, timestamp, std::vector<std::int32_t>(pData, pData + count));
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const double* pData, size_t count)
+{
+    push(pv, timestamp, std::vector<double>(pData, pData + count));
+}
+
+bool InterfaceBaseImpl::supportsChangedRanges() const
+{
+    return false;
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::int8_t* pData, size_t count, const changedRanges_t& /* changedRanges */)
+{
+    push(pv, timestamp, pData, count);
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::uint8_t* pData, size_t count, const changedRanges_t& /* changedRanges */)
+{
+    push(pv, timestamp, pData, count);
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::int32_t* pData, size_t count, const changedRanges_t& /* changedRanges */)
+{
+    push(pv, timestamp, pData, count);
+}
+
+void InterfaceBaseImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const double* pData, size_t count, const changedRanges_t& /* changedRanges */)
+{
+    push(pv, timestamp, pData, count);
+}
+
+void InterfaceBaseImpl::pushBatch(const std::vector<PushRecordImpl>& records)
+{
+    for(std::vector<PushRecordImpl>::const_iterator scanRecords(records.begin()), endRecords(records.end());
+        scanRecords != endRecords;
+        ++scanRecords)
+    {
+        scanRecords->dispatch(*this);
+    }
+}
+
 }
 
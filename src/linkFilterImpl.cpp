@@ -0,0 +1,49 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include "nds3/impl/linkFilterImpl.h"
+
+namespace nds
+{
+
+LinkFilterImpl::LinkFilterImpl(const std::uint32_t decimation, const double maxRate):
+    m_decimation(decimation == 0 ? 1 : decimation),
+    m_decimationCount(m_decimation),
+    m_interval(maxRate > 0 ? (std::int64_t)(1e9 / maxRate) : 0)
+{
+}
+
+bool LinkFilterImpl::isNeeded(const std::uint32_t decimation, const double maxRate)
+{
+    return decimation > 1 || maxRate > 0;
+}
+
+bool LinkFilterImpl::pass()
+{
+    if(--m_decimationCount != 0)
+    {
+        return false;
+    }
+    m_decimationCount = m_decimation;
+
+    if(m_interval.count() == 0)
+    {
+        return true;
+    }
+
+    const std::chrono::steady_clock::time_point now(std::chrono::steady_clock::now());
+    if(now < m_nextPassTime)
+    {
+        return false;
+    }
+    m_nextPassTime = now + m_interval;
+    return true;
+}
+
+}
@@ -247,7 +247,7 @@ void NdsFactoryImpl::deregisterOutputPV(PVBaseOutImpl *pReceiver)
     }
 }
 
-void NdsFactoryImpl::subscribe(const std::string &pushFrom, PVBaseOutImpl *pReceiver)
+void NdsFactoryImpl::subscribe(const std::string &pushFrom, PVBaseOutImpl *pReceiver, const std::uint32_t decimation, const double maxRate)
 {
     std::lock_guard<std::recursive_mutex> lockRegisteredPVs(m_lockRegisteredPVs);
 
@@ -274,10 +274,10 @@ void NdsFactoryImpl::subscribe(const std::string &pushFrom, PVBaseOutImpl *pRece
         throw MissingInputPV(errorMessage.str());
     }
 
-    findInput->second->subscribeReceiver(pReceiver);
+    findInput->second->subscribeReceiver(pReceiver, decimation, maxRate);
 }
 
-void NdsFactoryImpl::subscribe(const std::string& pushFrom, const std::string& pushTo)
+void NdsFactoryImpl::subscribe(const std::string& pushFrom, const std::string& pushTo, const std::uint32_t decimation, const double maxRate)
 {
     std::lock_guard<std::recursive_mutex> lockRegisteredPVs(m_lockRegisteredPVs);
 
@@ -288,7 +288,7 @@ void NdsFactoryImpl::subscribe(const std::string& pushFrom, const std::string& p
         errorMessage << "Cannot subscribe " << pushTo << " to " << pushFrom << " because the output PV cannot be located";
         throw MissingOutputPV(errorMessage.str());
     }
-    subscribe(pushFrom, findOutput->second);
+    subscribe(pushFrom, findOutput->second, decimation, maxRate);
 
 }
 
@@ -318,7 +318,7 @@ void NdsFactoryImpl::unsubscribe(const std::string &pushTo)
     unsubscribe(findOutput->second);
 }
 
-void NdsFactoryImpl::replicate(const std::string &replicateSource, const std::string &replicateDestination)
+void NdsFactoryImpl::replicate(const std::string &replicateSource, const std::string &replicateDestination, const std::uint32_t decimation, const double maxRate)
 {
     std::lock_guard<std::recursive_mutex> lockRegisteredPVs(m_lockRegisteredPVs);
 
@@ -329,10 +329,10 @@ void NdsFactoryImpl::replicate(const std::string &replicateSource, const std::st
         errorMessage << "Cannot replicate " << replicateSource << " to " << replicateDestination << " because the destination PV cannot be located";
         throw MissingDestinationPV(errorMessage.str());
     }
-    replicate(replicateSource, findDestination->second);
+    replicate(replicateSource, findDestination->second, decimation, maxRate);
 }
 
-void NdsFactoryImpl::replicate(const std::string &replicateSource, PVBaseInImpl *pDestination)
+void NdsFactoryImpl::replicate(const std::string &replicateSource, PVBaseInImpl *pDestination, const std::uint32_t decimation, const double maxRate)
 {
     std::lock_guard<std::recursive_mutex> lockRegisteredPVs(m_lockRegisteredPVs);
 
@@ -359,7 +359,7 @@ void NdsFactoryImpl::replicate(const std::string &replicateSource, PVBaseInImpl
         throw MissingInputPV(errorMessage.str());
     }
 
-    findInput->second->replicateTo(pDestination);
+    findInput->second->replicateTo(pDestination, decimation, maxRate);
 }
 
 void NdsFactoryImpl::stopReplicationTo(PVBaseInImpl *pDestination)
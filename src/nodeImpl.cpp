@@ -100,6 +100,15 @@ void NodeImpl::deinitialize()
     }
 }
 
+void NodeImpl::resolveTimestampSource()
+{
+    BaseImpl::resolveTimestampSource();
+    for(tChildren::iterator scanChildren(m_children.begin()), endScan(m_children.end()); scanChildren != endScan; ++scanChildren)
+    {
+        scanChildren->second->resolveTimestampSource();
+    }
+}
+
 state_t NodeImpl::getLocalState() const
 {
     if(m_pStateMachine.get() == 0)
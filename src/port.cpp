@@ -24,4 +24,9 @@ Port::Port(const std::string &name, const nodeType_t nodeType):
 {
 }
 
+void Port::setDispatchQueueSize(size_t queueSize)
+{
+    std::static_pointer_cast<PortImpl>(m_pImplementation)->setDispatchQueueSize(queueSize);
+}
+
 }
@@ -7,21 +7,72 @@
  * file included in the distribution.
  */
 
+#include <chrono>
+#include <stdexcept>
+
 #include "nds3/impl/portImpl.h"
 #include "nds3/impl/pvBaseImpl.h"
+#include "nds3/impl/pvBaseInImpl.h"
 #include "nds3/impl/factoryBaseImpl.h"
 #include "nds3/impl/interfaceBaseImpl.h"
+#include "nds3/impl/pushQueueImpl.h"
+#include "nds3/impl/pushBatchImpl.h"
+#include "nds3/impl/pushRecordImpl.h"
+#include "nds3/impl/threadBaseImpl.h"
 
 namespace nds
 {
 
+namespace
+{
+
+/*
+ * Deliver a value from the pushing thread. The arrays go through the PV, which
+ *  pushes only their changes when the differential push is enabled
+ *
+ *****/
+template<typename T>
+void pushToInterface(InterfaceBaseImpl& interface, PVBaseInImpl& pv, const timespec& timestamp, const T& value)
+{
+    interface.push(pv, timestamp, value);
+}
+
+template<typename E>
+void pushToInterface(InterfaceBaseImpl& interface, PVBaseInImpl& pv, const timespec& timestamp, const std::vector<E>& value)
+{
+    if(!pv.pushChanges(interface, timestamp, value.data(), value.size()))
+    {
+        interface.push(pv, timestamp, value);
+    }
+}
+
+template<typename T>
+void pushToInterface(InterfaceBaseImpl& interface, PVBaseInImpl& pv, const timespec& timestamp, const std::shared_ptr<const T>& pValue)
+{
+    interface.push(pv, timestamp, pValue);
+}
+
+template<typename E>
+void pushToInterface(InterfaceBaseImpl& interface, PVBaseInImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::vector<E> >& pValue)
+{
+    if(!pv.pushChanges(interface, timestamp, pValue->data(), pValue->size()))
+    {
+        interface.push(pv, timestamp, pValue);
+    }
+}
 
-PortImpl::PortImpl(const std::string& name, const nodeType_t nodeType): NodeImpl(name, nodeType)
+}
+
+PortImpl::PortImpl(const std::string& name, const nodeType_t nodeType): NodeImpl(name, nodeType),
+    m_dispatchQueueSize(0), m_bDispatching(false), m_bStopDispatcher(false), m_bDispatcherWaiting(false),
+    m_waitingProducers(0), m_bHasChangedPVs(false), m_bStopFlusher(true)
 {
 }
 
 PortImpl::~PortImpl()
 {
+    stopFlusher();
+    stopDispatcher();
 }
 
 
@@ -50,6 +101,14 @@ void PortImpl::initialize(FactoryBaseImpl& controlSystem)
     NodeImpl::initialize(controlSystem);
 
     m_pInterface->registrationTerminated();
+
+    if(m_dispatchQueueSize != 0)
+    {
+        startDispatcher(controlSystem);
+    }
+
+    std::lock_guard<std::mutex> lock(m_lockFlush);
+    m_bStopFlusher = false;
 }
 
 void PortImpl::deinitialize()
@@ -58,9 +117,533 @@ void PortImpl::deinitialize()
     {
         throw std::logic_error("deinitialize called on non initialized port");
     }
+
+    // Deliver the held and the queued values before the PVs are deregistered
+    /////////////////////////////////////////////////////////////////////////
+    stopFlusher();
+    stopDispatcher();
+
     NodeImpl::deinitialize();
 }
 
+void PortImpl::setDispatchQueueSize(size_t queueSize)
+{
+    if(m_pDispatchThread.get() != 0)
+    {
+        throw std::logic_error("The dispatch queue size cannot be changed while the port is initialized");
+    }
+    m_dispatchQueueSize = queueSize;
+}
+
+size_t PortImpl::getDispatchQueueSize() const
+{
+    return m_dispatchQueueSize;
+}
+
+void PortImpl::startDispatcher(FactoryBaseImpl& controlSystem)
+{
+    if(m_pDispatchThread.get() != 0)
+    {
+        return;
+    }
+
+    m_pDispatchQueue.reset(new PushQueueImpl(m_dispatchQueueSize));
+    m_bStopDispatcher.store(false);
+    m_bDispatching.store(true);
+    m_pDispatchThread.reset(controlSystem.runInThread(buildFullName(controlSystem) + "-dispatch",
+                                                      std::bind(&PortImpl::dispatchThread, this)));
+}
+
+/*
+ * The dispatcher delivers the queued records before exiting. Records
+ *  enqueued while the dispatcher was exiting are delivered from the
+ *  calling thread. A producer that still saw the dispatcher running
+ *  delivers its record itself: see notifyDispatcher().
+ *
+ *****/
+void PortImpl::stopDispatcher()
+{
+    if(m_pDispatchThread.get() == 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lockDispatcher);
+        m_bStopDispatcher.store(true);
+        m_recordsAvailable.notify_one();
+    }
+    m_pDispatchThread->join();
+    m_pDispatchThread.reset();
+
+    m_bDispatching.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    drainQueue();
+
+    // Release the producers that were waiting for a free slot
+    //////////////////////////////////////////////////////////
+    std::lock_guard<std::mutex> lock(m_lockDispatcher);
+    m_slotsAvailable.notify_all();
+}
+
+/*
+ * Enqueue a record for the dispatcher thread, applying the PV's push policy
+ *  when the queue is full
+ *
+ *****/
+void PortImpl::enqueue(PushRecordImpl& record)
+{
+    PVBaseInImpl& pv(*record.getPV());
+    const pushPolicy_t pushPolicy(pv.getPushPolicy());
+
+    // Conflating PVs store the value outside the queue and are listed as
+    //  changed only when their slot was empty
+    /////////////////////////////////////////////////////////////////////
+    if(pushPolicy == pushPolicy_t::conflate)
+    {
+        if(pv.storeLatest(record))
+        {
+            markChanged(pv);
+        }
+        return;
+    }
+
+    // Keep-latest PVs store the value and enqueue a placeholder only when
+    //  there isn't one waiting already
+    //////////////////////////////////////////////////////////////////////
+    if(pushPolicy == pushPolicy_t::keepLatest)
+    {
+        if(!pv.storeLatest(record))
+        {
+            return;
+        }
+        record.setLatestToken(pv);
+    }
+
+    // Only the values of the lossy PVs may be evicted by other producers.
+    // A placeholder is never evicted: the PV would never enqueue a new one
+    ///////////////////////////////////////////////////////////////////////
+    const bool bEvictable(pushPolicy == pushPolicy_t::dropOldest || pushPolicy == pushPolicy_t::dropNewest);
+
+    while(!m_pDispatchQueue->tryPush(record, bEvictable))
+    {
+        if(pushPolicy == pushPolicy_t::dropNewest)
+        {
+            pv.countDropped();
+            return;
+        }
+
+        if(pushPolicy != pushPolicy_t::block)
+        {
+            // Make room by discarding the oldest record, unless it belongs
+            //  to a PV that requires guaranteed delivery
+            ///////////////////////////////////////////////////////////////
+            PushRecordImpl evictedRecord;
+            if(m_pDispatchQueue->tryEvict(evictedRecord))
+            {
+                evictedRecord.getPV()->countDropped();
+                continue;
+            }
+
+            // The lossy PVs never wait for a slot. A drop-oldest PV loses
+            //  its own value; a keep-latest PV leaves the value in its slot
+            //  and lets the dispatcher pick it up with the conflated PVs
+            ////////////////////////////////////////////////////////////////
+            if(pushPolicy == pushPolicy_t::dropOldest)
+            {
+                pv.countDropped();
+                return;
+            }
+            if(pushPolicy == pushPolicy_t::keepLatest)
+            {
+                markChanged(pv);
+                return;
+            }
+        }
+
+        if(!waitForSlot())
+        {
+            // The dispatcher has been stopped meanwhile
+            ////////////////////////////////////////////
+            deliver(record);
+            return;
+        }
+    }
+
+    notifyDispatcher();
+}
+
+void PortImpl::markChanged(PVBaseInImpl& pv)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lockChanged);
+        m_changedPVs.push_back(&pv);
+        m_bHasChangedPVs.store(true, std::memory_order_relaxed);
+    }
+    notifyDispatcher();
+}
+
+/*
+ * The list is swapped with the caller's one, so the two vectors keep their
+ *  capacity and the producers do not allocate memory
+ *
+ *****/
+void PortImpl::takeChanged(std::vector<PVBaseInImpl*>& changedPVs, std::vector<PushRecordImpl>& batch)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lockChanged);
+        changedPVs.swap(m_changedPVs);
+        m_bHasChangedPVs.store(false, std::memory_order_relaxed);
+    }
+
+    PushRecordImpl record;
+    for(std::vector<PVBaseInImpl*>::const_iterator scanPVs(changedPVs.begin()), endPVs(changedPVs.end());
+        scanPVs != endPVs;
+        ++scanPVs)
+    {
+        if((*scanPVs)->takeLatest(record))
+        {
+            batch.push_back(std::move(record));
+            record.clear();
+        }
+    }
+    changedPVs.clear();
+}
+
+/*
+ * Deliver from the calling thread the records left in the queue and the
+ *  changed PVs. Several threads may drain the queue at the same time
+ *
+ *****/
+void PortImpl::drainQueue()
+{
+    PushRecordImpl record;
+    while(m_pDispatchQueue->tryPop(record))
+    {
+        deliver(record);
+    }
+
+    std::vector<PVBaseInImpl*> changedPVs;
+    std::vector<PushRecordImpl> records;
+    takeChanged(changedPVs, records);
+    if(!records.empty())
+    {
+        deliverBatch(records);
+    }
+}
+
+/*
+ * Wake up the dispatcher only if it is idle.
+ * Pairs with the fence in dispatchThread(): either we see the dispatcher
+ *  waiting or the dispatcher sees our record.
+ * Pairs with the fence in stopDispatcher(): either stopDispatcher() drains
+ *  the queue after our record was added or we see the dispatcher stopped
+ *  and deliver the record ourselves
+ *
+ *****/
+void PortImpl::notifyDispatcher()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(!m_bDispatching.load(std::memory_order_relaxed))
+    {
+        drainQueue();
+        return;
+    }
+    if(m_bDispatcherWaiting.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(m_lockDispatcher);
+        m_recordsAvailable.notify_one();
+    }
+}
+
+/*
+ * The timeout covers a notification sent before we started waiting
+ *
+ *****/
+bool PortImpl::waitForSlot()
+{
+    std::unique_lock<std::mutex> lock(m_lockDispatcher);
+    ++m_waitingProducers;
+    m_slotsAvailable.wait_for(lock, std::chrono::milliseconds(10));
+    --m_waitingProducers;
+
+    return m_bDispatching.load();
+}
+
+void PortImpl::deliver(PushRecordImpl& record)
+{
+    PVBaseInImpl& pv(*record.getPV());
+    if(record.isLatestToken() && !pv.takeLatest(record))
+    {
+        return;
+    }
+
+    try
+    {
+        pv.startDelivery(record.getSequence());
+        record.dispatch(*m_pInterface);
+        pv.countDelivered();
+    }
+    catch(const std::exception& e)
+    {
+        ndsErrorStream(*this) << "Error while delivering a pushed value: " << e.what() << std::endl;
+    }
+}
+
+/*
+ * Dispatcher thread: deliver the records until the queue is empty, then wait
+ *  for new records or for the stop signal
+ *
+ *****/
+void PortImpl::dispatchThread()
+{
+    std::vector<PushRecordImpl> batch;
+    batch.reserve(m_pDispatchQueue->getCapacity());
+    std::vector<PVBaseInImpl*> changedPVs;
+
+    PushRecordImpl record;
+    for(;;)
+    {
+        // Collect the queued records and deliver them with one call
+        ////////////////////////////////////////////////////////////
+        while(batch.size() != batch.capacity() && m_pDispatchQueue->tryPop(record))
+        {
+            if(m_waitingProducers.load(std::memory_order_relaxed) != 0)
+            {
+                std::lock_guard<std::mutex> lock(m_lockDispatcher);
+                m_slotsAvailable.notify_all();
+            }
+
+            if(record.isLatestToken() && !record.getPV()->takeLatest(record))
+            {
+                continue;
+            }
+            batch.push_back(std::move(record));
+            record.clear();
+        }
+
+        // Then one value for each conflating PV changed since the last pass
+        ////////////////////////////////////////////////////////////////////
+        if(m_bHasChangedPVs.load(std::memory_order_relaxed))
+        {
+            takeChanged(changedPVs, batch);
+        }
+
+        if(!batch.empty())
+        {
+            deliverBatch(batch);
+
+            // Release the buffers now rather than when the next records are popped
+            ///////////////////////////////////////////////////////////////////////
+            batch.clear();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_lockDispatcher);
+        if(m_bStopDispatcher.load())
+        {
+            return;
+        }
+
+        m_bDispatcherWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(m_pDispatchQueue->isEmpty() && !m_bHasChangedPVs.load(std::memory_order_relaxed))
+        {
+            m_recordsAvailable.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        m_bDispatcherWaiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+void PortImpl::sendBatch(const std::vector<PushRecordImpl>& records)
+{
+    for(std::vector<PushRecordImpl>::const_iterator scanRecords(records.begin()), endRecords(records.end());
+        scanRecords != endRecords;
+        ++scanRecords)
+    {
+        scanRecords->getPV()->startDelivery(scanRecords->getSequence());
+    }
+
+    m_pInterface->pushBatch(records);
+    for(std::vector<PushRecordImpl>::const_iterator scanRecords(records.begin()), endRecords(records.end());
+        scanRecords != endRecords;
+        ++scanRecords)
+    {
+        scanRecords->getPV()->countDelivered();
+    }
+}
+
+/*
+ * Used by the dispatcher thread, which has no caller to report the error to
+ *
+ *****/
+void PortImpl::deliverBatch(const std::vector<PushRecordImpl>& records)
+{
+    try
+    {
+        sendBatch(records);
+    }
+    catch(const std::exception& e)
+    {
+        ndsErrorStream(*this) << "Error while delivering a batch of pushed values: " << e.what() << std::endl;
+    }
+}
+
+void PortImpl::pushBatch(std::vector<PushRecordImpl>& records)
+{
+    if(m_bDispatching.load(std::memory_order_acquire))
+    {
+        for(std::vector<PushRecordImpl>::iterator scanRecords(records.begin()), endRecords(records.end());
+            scanRecords != endRecords;
+            ++scanRecords)
+        {
+            enqueue(*scanRecords);
+        }
+        return;
+    }
+
+    // As for a push outside of the batch, the errors of the control system
+    //  are reported to the pushing thread
+    ///////////////////////////////////////////////////////////////////////
+    sendBatch(records);
+}
+
+void PortImpl::push(PushRecordImpl& record)
+{
+    if(record.getPV() == 0)
+    {
+        return;
+    }
+
+    record.setSequence(record.getPV()->countEnqueued());
+    if(m_bDispatching.load(std::memory_order_acquire))
+    {
+        enqueue(record);
+        return;
+    }
+    deliver(record);
+}
+
+bool PortImpl::isDispatching() const
+{
+    return m_bDispatching.load(std::memory_order_acquire);
+}
+
+double PortImpl::getDispatchLoad() const
+{
+    if(!m_bDispatching.load(std::memory_order_relaxed))
+    {
+        return 0;
+    }
+    return (double)m_pDispatchQueue->getSize() / (double)m_pDispatchQueue->getCapacity();
+}
+
+bool PortImpl::scheduleFlush(PVBaseInImpl& pv, const std::chrono::steady_clock::time_point& flushTime)
+{
+    std::lock_guard<std::mutex> lock(m_lockFlush);
+    if(m_bStopFlusher)
+    {
+        return false;
+    }
+
+    if(m_pFlushThread.get() == 0)
+    {
+        m_pFlushThread.reset(runInThread(buildFullName(*m_pFactory) + "-flush", std::bind(&PortImpl::flushThread, this)));
+    }
+    m_flushSchedule.insert(std::make_pair(flushTime, &pv));
+    m_flushScheduled.notify_one();
+    return true;
+}
+
+/*
+ * The flush thread locks m_lockFlushing before releasing m_lockFlush: after
+ *  the PV has been removed from the schedule, locking m_lockFlushing waits
+ *  for the flush that may have already started
+ *
+ *****/
+void PortImpl::cancelFlush(PVBaseInImpl& pv)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lockFlush);
+        for(flushSchedule_t::iterator scanSchedule(m_flushSchedule.begin()); scanSchedule != m_flushSchedule.end();)
+        {
+            if(scanSchedule->second == &pv)
+            {
+                m_flushSchedule.erase(scanSchedule++);
+            }
+            else
+            {
+                ++scanSchedule;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lockFlushing(m_lockFlushing);
+}
+
+void PortImpl::flushThread()
+{
+    std::unique_lock<std::mutex> lock(m_lockFlush);
+    while(!m_bStopFlusher)
+    {
+        if(m_flushSchedule.empty())
+        {
+            m_flushScheduled.wait(lock);
+            continue;
+        }
+
+        const std::chrono::steady_clock::time_point flushTime(m_flushSchedule.begin()->first);
+        if(std::chrono::steady_clock::now() < flushTime)
+        {
+            m_flushScheduled.wait_until(lock, flushTime);
+            continue;
+        }
+
+        PVBaseInImpl* pPV(m_flushSchedule.begin()->second);
+        m_flushSchedule.erase(m_flushSchedule.begin());
+        {
+            std::lock_guard<std::mutex> lockFlushing(m_lockFlushing);
+            lock.unlock();
+            pPV->flushRateLimited(*this);
+        }
+        lock.lock();
+    }
+}
+
+/*
+ * The values held by the PVs are flushed immediately. Values held after this
+ *  point are pushed by the PVs themselves, because scheduleFlush() fails
+ *
+ *****/
+void PortImpl::stopFlusher()
+{
+    flushSchedule_t flushSchedule;
+    {
+        std::lock_guard<std::mutex> lock(m_lockFlush);
+        m_bStopFlusher = true;
+        m_flushScheduled.notify_one();
+    }
+
+    if(m_pFlushThread.get() != 0)
+    {
+        m_pFlushThread->join();
+        m_pFlushThread.reset();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lockFlush);
+        flushSchedule.swap(m_flushSchedule);
+    }
+
+    for(flushSchedule_t::iterator scanSchedule(flushSchedule.begin()), endSchedule(flushSchedule.end());
+        scanSchedule != endSchedule;
+        ++scanSchedule)
+    {
+        scanSchedule->second->flushRateLimited(*this);
+    }
+}
+
 void PortImpl::registerPV(std::shared_ptr<PVBaseImpl> pv)
 {
     m_pInterface->registerPV(pv);
@@ -72,16 +655,106 @@ void PortImpl::deregisterPV(std::shared_ptr<PVBaseImpl> pv)
 }
 
 template<typename T>
-void PortImpl::push(std::shared_ptr<PVBaseImpl> pv, const timespec& timestamp, const T& value)
+void PortImpl::push(PVBaseInImpl& pv, const timespec& timestamp, const T& value)
 {
-    m_pInterface->push(*(pv.get()), timestamp, value);
+    const std::uint64_t sequence(pv.countEnqueued());
+
+    PushBatchImpl* pBatch(PushBatchImpl::getCurrent());
+    if(pBatch != 0 || m_bDispatching.load(std::memory_order_acquire))
+    {
+        PushRecordImpl record;
+        record.set(pv, timestamp, value);
+        record.setSequence(sequence);
+        if(pBatch != 0)
+        {
+            pBatch->add(*this, record);
+        }
+        else
+        {
+            enqueue(record);
+        }
+        return;
+    }
+    pv.startDelivery(sequence);
+    pushToInterface(*m_pInterface, pv, timestamp, value);
+    pv.countDelivered();
 }
 
-template void PortImpl::push<std::int32_t>(std::shared_ptr<PVBaseImpl>, const timespec&, const std::int32_t&);
-template void PortImpl::push<double>(std::shared_ptr<PVBaseImpl>, const timespec&, const double&);
-template void PortImpl::push<std::vector<std::int8_t> >(std::shared_ptr<PVBaseImpl>, const timespec&, const std::vector<std::int8_t>&);
-template void PortImpl::push<std::vector<std::uint8_t> >(std::shared_ptr<PVBaseImpl>, const timespec&, const std::vector<std::uint8_t>&);
-template void PortImpl::push<std::vector<std::int32_t> >(std::shared_ptr<PVBaseImpl>, const timespec&, const std::vector<std::int32_t>&);
-template void PortImpl::push<std::vector<double> >(std::shared_ptr<PVBaseImpl>, const timespec&, const std::vector<double>&);
-template void PortImpl::push<std::string >(std::shared_ptr<PVBaseImpl>, const timespec&, const std::string&);
+template<typename T>
+void PortImpl::push(PVBaseInImpl& pv, const timespec& timestamp, const std::shared_ptr<const T>& pValue)
+{
+    const std::uint64_t sequence(pv.countEnqueued());
+
+    PushBatchImpl* pBatch(PushBatchImpl::getCurrent());
+    if(pBatch != 0 || m_bDispatching.load(std::memory_order_acquire))
+    {
+        PushRecordImpl record;
+        record.set(pv, timestamp, pValue);
+        record.setSequence(sequence);
+        if(pBatch != 0)
+        {
+            pBatch->add(*this, record);
+        }
+        else
+        {
+            enqueue(record);
+        }
+        return;
+    }
+    pv.startDelivery(sequence);
+    pushToInterface(*m_pInterface, pv, timestamp, pValue);
+    pv.countDelivered();
+}
+
+template<typename T>
+void PortImpl::push(PVBaseInImpl& pv, const timespec& timestamp, const T* pData, size_t count)
+{
+    const std::uint64_t sequence(pv.countEnqueued());
+
+    PushBatchImpl* pBatch(PushBatchImpl::getCurrent());
+    if(pBatch != 0 || m_bDispatching.load(std::memory_order_acquire))
+    {
+        // The caller may reuse the buffer as soon as we return
+        ///////////////////////////////////////////////////////
+        PushRecordImpl record;
+        record.set(pv, timestamp, std::shared_ptr<const std::vector<T> >(std::make_shared<std::vector<T> >(pData, pData + count)));
+        record.setSequence(sequence);
+        if(pBatch != 0)
+        {
+            pBatch->add(*this, record);
+        }
+        else
+        {
+            enqueue(record);
+        }
+        return;
+    }
+    pv.startDelivery(sequence);
+    if(!pv.pushChanges(*m_pInterface, timestamp, pData, count))
+    {
+        m_pInterface->push(pv, timestamp, pData, count);
+    }
+    pv.countDelivered();
+}
+
+template void PortImpl::push<std::int32_t>(PVBaseInImpl&, const timespec&, const std::int32_t&);
+template void PortImpl::push<double>(PVBaseInImpl&, const timespec&, const double&);
+template void PortImpl::push<std::vector<std::int8_t> >(PVBaseInImpl&, const timespec&, const std::vector<std::int8_t>&);
+template void PortImpl::push<std::vector<std::uint8_t> >(PVBaseInImpl&, const timespec&, const std::vector<std::uint8_t>&);
+template void PortImpl::push<std::vector<std::int32_t> >(PVBaseInImpl&, const timespec&, const std::vector<std::int32_t>&);
+template void PortImpl::push<std::vector<double> >(PVBaseInImpl&, const timespec&, const std::vector<double>&);
+template void PortImpl::push<std::string >(PVBaseInImpl&, const timespec&, const std::string&);
+
+template void PortImpl::push<std::int32_t>(PVBaseInImpl&, const timespec&, const std::shared_ptr<const std::int32_t>&);
+template void PortImpl::push<double>(PVBaseInImpl&, const timespec&, const std::shared_ptr<const double>&);
+template void PortImpl::push<std::vector<std::int8_t> >(PVBaseInImpl&, const timespec&, const std::shared_ptr<const std::vector<std::int8_t> >&);
+template void PortImpl::push<std::vector<std::uint8_t> >(PVBaseInImpl&, const timespec&, const std::shared_ptr<const std::vector<std::uint8_t> >&);
+template void PortImpl::push<std::vector<std::int32_t> >(PVBaseInImpl&, const timespec&, const std::shared_ptr<const std::vector<std::int32_t> >&);
+template void PortImpl::push<std::vector<double> >(PVBaseInImpl&, const timespec&, const std::shared_ptr<const std::vector<double> >&);
+template void PortImpl::push<std::string >(PVBaseInImpl&, const timespec&, const std::shared_ptr<const std::string>&);
+
+template void PortImpl::push<std::int8_t>(PVBaseInImpl&, const timespec&, const std::int8_t*, size_t);
+template void PortImpl::push<std::uint8_t>(PVBaseInImpl&, const timespec&, const std::uint8_t*, size_t);
+template void PortImpl::push<std::int32_t>(PVBaseInImpl&, const timespec&, const std::int32_t*, size_t);
+template void PortImpl::push<double>(PVBaseInImpl&, const timespec&, const double*, size_t);
 }
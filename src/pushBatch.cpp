@@ -0,0 +1,29 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include "nds3/pushBatch.h"
+#include "nds3/impl/pushBatchImpl.h"
+
+namespace nds
+{
+
+PushBatch::PushBatch(): m_pImplementation(std::make_shared<PushBatchImpl>())
+{
+}
+
+PushBatch::~PushBatch()
+{
+}
+
+void PushBatch::flush()
+{
+    m_pImplementation->flush();
+}
+
+}
@@ -0,0 +1,120 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include <exception>
+
+#include "nds3/impl/pushBatchImpl.h"
+#include "nds3/impl/portImpl.h"
+
+namespace nds
+{
+
+thread_local PushBatchImpl* PushBatchImpl::m_pCurrentBatch(0);
+
+PushBatchImpl::PushBatchImpl(): m_bActive(m_pCurrentBatch == 0)
+{
+    if(m_bActive)
+    {
+        m_pCurrentBatch = this;
+    }
+}
+
+/*
+ * A destructor cannot throw: the errors of the control system are logged
+ *
+ *****/
+PushBatchImpl::~PushBatchImpl()
+{
+    if(m_bActive)
+    {
+        deliver(false);
+        m_pCurrentBatch = 0;
+    }
+}
+
+PushBatchImpl* PushBatchImpl::getCurrent()
+{
+    return m_pCurrentBatch;
+}
+
+void PushBatchImpl::add(PortImpl& port, PushRecordImpl& record)
+{
+    // A device uses few ports: a linear scan is faster than a map
+    ///////////////////////////////////////////////////////////////
+    portRecords_t::iterator scanPorts(m_portRecords.begin());
+    for(portRecords_t::iterator endPorts(m_portRecords.end()); scanPorts != endPorts && scanPorts->first != &port; ++scanPorts)
+    {
+    }
+    if(scanPorts == m_portRecords.end())
+    {
+        m_portRecords.push_back(std::make_pair(&port, std::vector<PushRecordImpl>()));
+        scanPorts = m_portRecords.end() - 1;
+    }
+
+    scanPorts->second.push_back(std::move(record));
+    record.clear();
+}
+
+void PushBatchImpl::flush()
+{
+    if(m_bActive)
+    {
+        deliver(true);
+    }
+}
+
+/*
+ * The lists keep their capacity: a batch reused for every acquisition cycle
+ *  stops allocating memory.
+ * A port that fails does not prevent the delivery to the other ports: the
+ *  first error is thrown once all the ports have been served
+ *
+ *****/
+void PushBatchImpl::deliver(const bool bThrow)
+{
+    // Values pushed while delivering (e.g. by the control system) are not
+    //  added to the lists being delivered
+    //////////////////////////////////////////////////////////////////////
+    PushBatchImpl* pCurrentBatch(m_pCurrentBatch);
+    m_pCurrentBatch = 0;
+
+    std::exception_ptr pError;
+    for(portRecords_t::iterator scanPorts(m_portRecords.begin()), endPorts(m_portRecords.end()); scanPorts != endPorts; ++scanPorts)
+    {
+        if(scanPorts->second.empty())
+        {
+            continue;
+        }
+        try
+        {
+            scanPorts->first->pushBatch(scanPorts->second);
+        }
+        catch(const std::exception& e)
+        {
+            if(!bThrow)
+            {
+                ndsErrorStream(*(scanPorts->first)) << "Error while delivering a batch of pushed values: " << e.what() << std::endl;
+            }
+            else if(pError == 0)
+            {
+                pError = std::current_exception();
+            }
+        }
+        scanPorts->second.clear();
+    }
+
+    m_pCurrentBatch = pCurrentBatch;
+
+    if(pError != 0)
+    {
+        std::rethrow_exception(pError);
+    }
+}
+
+}
@@ -0,0 +1,161 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include <cstddef>
+#include <utility>
+#include "nds3/impl/pushQueueImpl.h"
+
+namespace nds
+{
+
+namespace
+{
+
+size_t roundToPowerOf2(size_t value)
+{
+    size_t powerOf2(2);
+    while(powerOf2 < value)
+    {
+        powerOf2 <<= 1;
+    }
+    return powerOf2;
+}
+
+}
+
+PushQueueImpl::PushQueueImpl(size_t capacity):
+    m_positionMask(roundToPowerOf2(capacity) - 1),
+    m_cells(new cell_t[m_positionMask + 1]),
+    m_enqueuePosition(0),
+    m_dequeuePosition(0)
+{
+    // A cell is free for the producer that reaches it at position N when its
+    //  sequence is N
+    /////////////////////////////////////////////////////////////////////////
+    for(size_t scanCells(0); scanCells != m_positionMask + 1; ++scanCells)
+    {
+        m_cells[scanCells].m_sequence.store(scanCells, std::memory_order_relaxed);
+        m_cells[scanCells].m_bEvictable.store(false, std::memory_order_relaxed);
+    }
+}
+
+/*
+ * Claim the cell at the enqueue position, then publish it by setting
+ *  its sequence to position + 1
+ *
+ *****/
+bool PushQueueImpl::tryPush(PushRecordImpl& record, const bool bEvictable)
+{
+    size_t position(m_enqueuePosition.load(std::memory_order_relaxed));
+    for(;;)
+    {
+        cell_t& cell(m_cells[position & m_positionMask]);
+        const size_t sequence(cell.m_sequence.load(std::memory_order_acquire));
+        const std::ptrdiff_t difference((std::ptrdiff_t)sequence - (std::ptrdiff_t)position);
+        if(difference == 0)
+        {
+            if(m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                cell.m_record = std::move(record);
+                cell.m_bEvictable.store(bEvictable, std::memory_order_relaxed);
+                record.clear();
+                cell.m_sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if(difference < 0)
+        {
+            // The cell still holds the record pushed one lap ago
+            /////////////////////////////////////////////////////
+            return false;
+        }
+        else
+        {
+            position = m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool PushQueueImpl::tryPop(PushRecordImpl& record)
+{
+    return tryPop(record, false);
+}
+
+bool PushQueueImpl::tryEvict(PushRecordImpl& record)
+{
+    return tryPop(record, true);
+}
+
+/*
+ * Claim the cell at the dequeue position, then free it for the next lap by
+ *  setting its sequence to position + capacity
+ *
+ *****/
+bool PushQueueImpl::tryPop(PushRecordImpl& record, const bool bOnlyEvictable)
+{
+    size_t position(m_dequeuePosition.load(std::memory_order_relaxed));
+    for(;;)
+    {
+        cell_t& cell(m_cells[position & m_positionMask]);
+        const size_t sequence(cell.m_sequence.load(std::memory_order_acquire));
+        const std::ptrdiff_t difference((std::ptrdiff_t)sequence - (std::ptrdiff_t)(position + 1));
+        if(difference == 0)
+        {
+            // The flag is read before the cell is claimed: if another consumer
+            //  claims the cell first then the exchange below fails
+            ///////////////////////////////////////////////////////////////////
+            if(bOnlyEvictable && !cell.m_bEvictable.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+            if(m_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                record = std::move(cell.m_record);
+                cell.m_record.clear();
+                cell.m_sequence.store(position + m_positionMask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if(difference < 0)
+        {
+            // The cell has not been published yet
+            //////////////////////////////////////
+            return false;
+        }
+        else
+        {
+            position = m_dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool PushQueueImpl::isEmpty() const
+{
+    return m_enqueuePosition.load() == m_dequeuePosition.load();
+}
+
+size_t PushQueueImpl::getCapacity() const
+{
+    return m_positionMask + 1;
+}
+
+/*
+ * The dequeue position is read first: the enqueue position read afterwards
+ *  cannot be lower
+ *
+ *****/
+size_t PushQueueImpl::getSize() const
+{
+    const size_t dequeuePosition(m_dequeuePosition.load(std::memory_order_relaxed));
+    const size_t enqueuePosition(m_enqueuePosition.load(std::memory_order_relaxed));
+    const size_t size(enqueuePosition - dequeuePosition);
+    return size > m_positionMask + 1 ? m_positionMask + 1 : size;
+}
+
+}
@@ -0,0 +1,208 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nds3/impl/pushRecordImpl.h"
+#include "nds3/impl/pvBaseInImpl.h"
+#include "nds3/impl/interfaceBaseImpl.h"
+
+namespace nds
+{
+
+PushRecordImpl::PushRecordImpl(): m_pPV(0), m_sequence(0), m_dataType(dataType_t::dataInt32), m_bLatestToken(false), m_int32Value(0)
+{
+    m_timestamp.tv_sec = 0;
+    m_timestamp.tv_nsec = 0;
+}
+
+/*
+ * Arrays and strings are copied into a shared buffer
+ *
+ *****/
+template<typename T>
+void PushRecordImpl::set(PVBaseInImpl& pv, const timespec& timestamp, const T& value)
+{
+    m_pPV = &pv;
+    m_timestamp = timestamp;
+    m_bLatestToken = false;
+    m_dataType = PVBaseImpl::getDataTypeForCPPType<T>();
+    m_pValue = std::make_shared<T>(value);
+}
+
+template<>
+void PushRecordImpl::set<std::int32_t>(PVBaseInImpl& pv, const timespec& timestamp, const std::int32_t& value)
+{
+    m_pPV = &pv;
+    m_timestamp = timestamp;
+    m_bLatestToken = false;
+    m_dataType = dataType_t::dataInt32;
+    m_int32Value = value;
+    m_pValue.reset();
+}
+
+template<>
+void PushRecordImpl::set<double>(PVBaseInImpl& pv, const timespec& timestamp, const double& value)
+{
+    m_pPV = &pv;
+    m_timestamp = timestamp;
+    m_bLatestToken = false;
+    m_dataType = dataType_t::dataFloat64;
+    m_doubleValue = value;
+    m_pValue.reset();
+}
+
+/*
+ * Shared arrays and strings are referenced, shared scalars are copied
+ *
+ *****/
+template<typename T>
+void PushRecordImpl::set(PVBaseInImpl& pv, const timespec& timestamp, const std::shared_ptr<const T>& pValue)
+{
+    m_pPV = &pv;
+    m_timestamp = timestamp;
+    m_bLatestToken = false;
+    m_dataType = PVBaseImpl::getDataTypeForCPPType<T>();
+    m_pValue = pValue;
+}
+
+template<>
+void PushRecordImpl::set<std::int32_t>(PVBaseInImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::int32_t>& pValue)
+{
+    set(pv, timestamp, *pValue);
+}
+
+template<>
+void PushRecordImpl::set<double>(PVBaseInImpl& pv, const timespec& timestamp, const std::shared_ptr<const double>& pValue)
+{
+    set(pv, timestamp, *pValue);
+}
+
+void PushRecordImpl::setLatestToken(PVBaseInImpl& pv)
+{
+    m_pPV = &pv;
+    m_bLatestToken = true;
+    m_pValue.reset();
+}
+
+bool PushRecordImpl::isLatestToken() const
+{
+    return m_bLatestToken;
+}
+
+void PushRecordImpl::clear()
+{
+    m_pPV = 0;
+    m_sequence = 0;
+    m_bLatestToken = false;
+    m_pValue.reset();
+}
+
+void PushRecordImpl::dispatch(InterfaceBaseImpl& interface) const
+{
+    switch(m_dataType)
+    {
+    case dataType_t::dataInt32:
+        interface.push(*m_pPV, m_timestamp, m_int32Value);
+        break;
+    case dataType_t::dataFloat64:
+        interface.push(*m_pPV, m_timestamp, m_doubleValue);
+        break;
+    case dataType_t::dataInt8Array:
+        dispatchArray<std::int8_t>(interface);
+        break;
+    case dataType_t::dataUint8Array:
+        dispatchArray<std::uint8_t>(interface);
+        break;
+    case dataType_t::dataInt32Array:
+        dispatchArray<std::int32_t>(interface);
+        break;
+    case dataType_t::dataFloat64Array:
+        dispatchArray<double>(interface);
+        break;
+    case dataType_t::dataString:
+        interface.push(*m_pPV, m_timestamp, std::static_pointer_cast<const std::string>(m_pValue));
+        break;
+    }
+}
+
+template<typename E>
+void PushRecordImpl::dispatchArray(InterfaceBaseImpl& interface) const
+{
+    const std::shared_ptr<const std::vector<E> > pValue(std::static_pointer_cast<const std::vector<E> >(m_pValue));
+    if(!m_pPV->pushChanges(interface, m_timestamp, pValue->data(), pValue->size()))
+    {
+        interface.push(*m_pPV, m_timestamp, pValue);
+    }
+}
+
+PVBaseInImpl* PushRecordImpl::getPV() const
+{
+    return m_pPV;
+}
+
+const timespec& PushRecordImpl::getTimestamp() const
+{
+    return m_timestamp;
+}
+
+void PushRecordImpl::setSequence(const std::uint64_t sequence)
+{
+    m_sequence = sequence;
+}
+
+std::uint64_t PushRecordImpl::getSequence() const
+{
+    return m_sequence;
+}
+
+dataType_t PushRecordImpl::getDataType() const
+{
+    return m_dataType;
+}
+
+template<typename T>
+const T& PushRecordImpl::getValue() const
+{
+    return *static_cast<const T*>(m_pValue.get());
+}
+
+template<>
+const std::int32_t& PushRecordImpl::getValue<std::int32_t>() const
+{
+    return m_int32Value;
+}
+
+template<>
+const double& PushRecordImpl::getValue<double>() const
+{
+    return m_doubleValue;
+}
+
+template void PushRecordImpl::set<std::vector<std::int8_t> >(PVBaseInImpl&, const timespec&, const std::vector<std::int8_t>&);
+template void PushRecordImpl::set<std::vector<std::uint8_t> >(PVBaseInImpl&, const timespec&, const std::vector<std::uint8_t>&);
+template void PushRecordImpl::set<std::vector<std::int32_t> >(PVBaseInImpl&, const timespec&, const std::vector<std::int32_t>&);
+template void PushRecordImpl::set<std::vector<double> >(PVBaseInImpl&, const timespec&, const std::vector<double>&);
+template void PushRecordImpl::set<std::string>(PVBaseInImpl&, const timespec&, const std::string&);
+
+template void PushRecordImpl::set<std::vector<std::int8_t> >(PVBaseInImpl&, const timespec&, const std::shared_ptr<const std::vector<std::int8_t> >&);
+template void PushRecordImpl::set<std::vector<std::uint8_t> >(PVBaseInImpl&, const timespec&, const std::shared_ptr<const std::vector<std::uint8_t> >&);
+template void PushRecordImpl::set<std::vector<std::int32_t> >(PVBaseInImpl&, const timespec&, const std::shared_ptr<const std::vector<std::int32_t> >&);
+template void PushRecordImpl::set<std::vector<double> >(PVBaseInImpl&, const timespec&, const std::shared_ptr<const std::vector<double> >&);
+template void PushRecordImpl::set<std::string>(PVBaseInImpl&, const timespec&, const std::shared_ptr<const std::string>&);
+
+template const std::vector<std::int8_t>& PushRecordImpl::getValue<std::vector<std::int8_t> >() const;
+template const std::vector<std::uint8_t>& PushRecordImpl::getValue<std::vector<std::uint8_t> >() const;
+template const std::vector<std::int32_t>& PushRecordImpl::getValue<std::vector<std::int32_t> >() const;
+template const std::vector<double>& PushRecordImpl::getValue<std::vector<double> >() const;
+template const std::string& PushRecordImpl::getValue<std::string>() const;
+
+}
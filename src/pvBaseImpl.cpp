@@ -7,6 +7,7 @@
  * file included in the distribution.
  */
 
+#include <cstring>
 #include "nds3/port.h"
 #include "nds3/pvBase.h"
 #include "nds3/impl/pvBaseImpl.h"
@@ -23,7 +24,8 @@ PVBaseImpl::PVBaseImpl(const std::string& name): BaseImpl(name),
     m_scanType(scanType_t::passive),
     m_periodicScanSeconds(1),
     m_maxElements(1),
-    m_bProcessAtInit(false)
+    m_bProcessAtInit(false),
+    m_pCachedPort(0)
 {
 
 }
@@ -73,6 +75,86 @@ void PVBaseImpl::read(timespec* /* pTimestamp */, std::string* /* pValue */) con
 }
 
 
+/*
+ * Read functions into the control system buffers. Without a stored value to
+ *  copy from, we read the value as usual and then copy it
+ *
+ ***************************************************************************/
+size_t PVBaseImpl::read(timespec* pTimestamp, std::int8_t* pBuffer, size_t capacity) const
+{
+    std::vector<std::int8_t> value;
+    read(pTimestamp, &value);
+    return copyToBuffer(value, pBuffer, capacity);
+}
+
+size_t PVBaseImpl::read(timespec* pTimestamp, std::uint8_t* pBuffer, size_t capacity) const
+{
+    std::vector<std::uint8_t> value;
+    read(pTimestamp, &value);
+    return copyToBuffer(value, pBuffer, capacity);
+}
+
+size_t PVBaseImpl::read(timespec* pTimestamp, std::int32_t* pBuffer, size_t capacity) const
+{
+    if(getDataType() == dataType_t::dataInt32)
+    {
+        std::int32_t value;
+        read(pTimestamp, &value);
+        return copyToBuffer(value, pBuffer, capacity);
+    }
+    std::vector<std::int32_t> value;
+    read(pTimestamp, &value);
+    return copyToBuffer(value, pBuffer, capacity);
+}
+
+size_t PVBaseImpl::read(timespec* pTimestamp, double* pBuffer, size_t capacity) const
+{
+    if(getDataType() == dataType_t::dataFloat64)
+    {
+        double value;
+        read(pTimestamp, &value);
+        return copyToBuffer(value, pBuffer, capacity);
+    }
+    std::vector<double> value;
+    read(pTimestamp, &value);
+    return copyToBuffer(value, pBuffer, capacity);
+}
+
+
+/*
+ * Copy a value into a control system buffer
+ *
+ *******************************************/
+template<typename E>
+size_t PVBaseImpl::copyToBuffer(const std::vector<E>& value, E* pBuffer, size_t capacity)
+{
+    const size_t count(value.size() < capacity ? value.size() : capacity);
+    if(count != 0)
+    {
+        ::memcpy(pBuffer, value.data(), count * sizeof(E));
+    }
+    return count;
+}
+
+size_t PVBaseImpl::copyToBuffer(const std::string& value, std::uint8_t* pBuffer, size_t capacity)
+{
+    const size_t count(value.size() < capacity ? value.size() : capacity);
+    ::memcpy(pBuffer, value.data(), count);
+    return count;
+}
+
+template<typename E>
+size_t PVBaseImpl::copyToBuffer(const E& value, E* pBuffer, size_t capacity)
+{
+    if(capacity == 0)
+    {
+        return 0;
+    }
+    *pBuffer = value;
+    return 1;
+}
+
+
 /*
  * Write functions for all the supported data types
  *
@@ -255,7 +337,27 @@ bool PVBaseImpl::getProcessAtInit() const
 void PVBaseImpl::initialize(FactoryBaseImpl& controlSystem)
 {
     BaseImpl::initialize(controlSystem);
-    getPort()->registerPV(std::static_pointer_cast<PVBaseImpl>(shared_from_this()));
+    std::shared_ptr<PortImpl> pPort(getPort());
+    pPort->registerPV(std::static_pointer_cast<PVBaseImpl>(shared_from_this()));
+    m_pCachedPort.store(pPort.get(), std::memory_order_release);
+}
+
+
+/*
+ * Return the port without walking the tree
+ *
+ ******************************************/
+PortImpl& PVBaseImpl::getCachedPort()
+{
+    PortImpl* pPort(m_pCachedPort.load(std::memory_order_acquire));
+    if(pPort != 0)
+    {
+        return *pPort;
+    }
+
+    // Not initialized yet: the node tree keeps the port alive
+    //////////////////////////////////////////////////////////
+    return *getPort();
 }
 
 
@@ -266,9 +368,17 @@ void PVBaseImpl::initialize(FactoryBaseImpl& controlSystem)
 void PVBaseImpl::deinitialize()
 {
     BaseImpl::deinitialize();
+    m_pCachedPort.store(0, std::memory_order_release);
     getPort()->deregisterPV(std::static_pointer_cast<PVBaseImpl>(shared_from_this()));
 }
 
 
+template size_t PVBaseImpl::copyToBuffer<std::int8_t>(const std::vector<std::int8_t>&, std::int8_t*, size_t);
+template size_t PVBaseImpl::copyToBuffer<std::uint8_t>(const std::vector<std::uint8_t>&, std::uint8_t*, size_t);
+template size_t PVBaseImpl::copyToBuffer<std::int32_t>(const std::vector<std::int32_t>&, std::int32_t*, size_t);
+template size_t PVBaseImpl::copyToBuffer<double>(const std::vector<double>&, double*, size_t);
+
+template size_t PVBaseImpl::copyToBuffer<std::int32_t>(const std::int32_t&, std::int32_t*, size_t);
+template size_t PVBaseImpl::copyToBuffer<double>(const double&, double*, size_t);
 
 }
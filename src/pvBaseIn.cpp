@@ -7,6 +7,8 @@
  * file included in the distribution.
  */
 
+#include <limits>
+#include <utility>
 #include "nds3/pvBaseIn.h"
 #include "nds3/impl/pvBaseInImpl.h"
 
@@ -28,10 +30,62 @@ void PVBaseIn::read(timespec* pTimestamp, T* pValue) const
     std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->read(pTimestamp, pValue);
 }
 
+/*
+ * The push functions are called for each acquired value: they don't copy
+ *  m_pImplementation to avoid the reference count updates
+ *
+ *****/
 template<typename T>
 void PVBaseIn::push(const timespec& timestamp, const T& value)
 {
-    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->push(timestamp, value);
+    static_cast<PVBaseInImpl*>(m_pImplementation.get())->push(timestamp, value);
+}
+
+template<typename T>
+void PVBaseIn::push(const timespec& timestamp, const std::shared_ptr<const T>& pValue)
+{
+    static_cast<PVBaseInImpl*>(m_pImplementation.get())->push(timestamp, pValue);
+}
+
+template<typename E>
+void PVBaseIn::push(const timespec& timestamp, const E* pData, size_t count)
+{
+    static_cast<PVBaseInImpl*>(m_pImplementation.get())->push(timestamp, pData, count);
+}
+
+void PVBaseIn::push(const timespec& timestamp, std::int32_t&& value)
+{
+    static_cast<PVBaseInImpl*>(m_pImplementation.get())->push(timestamp, std::move(value));
+}
+
+void PVBaseIn::push(const timespec& timestamp, double&& value)
+{
+    static_cast<PVBaseInImpl*>(m_pImplementation.get())->push(timestamp, std::move(value));
+}
+
+void PVBaseIn::push(const timespec& timestamp, std::vector<std::int8_t>&& value)
+{
+    static_cast<PVBaseInImpl*>(m_pImplementation.get())->push(timestamp, std::move(value));
+}
+
+void PVBaseIn::push(const timespec& timestamp, std::vector<std::uint8_t>&& value)
+{
+    static_cast<PVBaseInImpl*>(m_pImplementation.get())->push(timestamp, std::move(value));
+}
+
+void PVBaseIn::push(const timespec& timestamp, std::vector<std::int32_t>&& value)
+{
+    static_cast<PVBaseInImpl*>(m_pImplementation.get())->push(timestamp, std::move(value));
+}
+
+void PVBaseIn::push(const timespec& timestamp, std::vector<double>&& value)
+{
+    static_cast<PVBaseInImpl*>(m_pImplementation.get())->push(timestamp, std::move(value));
+}
+
+void PVBaseIn::push(const timespec& timestamp, std::string&& value)
+{
+    static_cast<PVBaseInImpl*>(m_pImplementation.get())->push(timestamp, std::move(value));
 }
 
 void PVBaseIn::setDecimation(const std::uint32_t decimation)
@@ -39,31 +93,180 @@ void PVBaseIn::setDecimation(const std::uint32_t decimation)
     std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->setDecimation(decimation);
 }
 
+void PVBaseIn::setDecimationMode(const decimationMode_t decimationMode)
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->setDecimationMode(decimationMode);
+}
+
+void PVBaseIn::setAdaptiveDecimation(const std::uint32_t maxDecimation)
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->setAdaptiveDecimation(maxDecimation);
+}
+
+std::uint32_t PVBaseIn::getEffectiveDecimation() const
+{
+    return std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getEffectiveDecimation();
+}
+
+void PVBaseIn::setDeadband(const deadbandType_t type, const double deadband)
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->setDeadband(type, deadband);
+}
+
+void PVBaseIn::setMaxPublishRate(const double maxRate)
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->setMaxPublishRate(maxRate);
+}
+
+void PVBaseIn::setPushPolicy(const pushPolicy_t pushPolicy)
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->setPushPolicy(pushPolicy);
+}
+
+void PVBaseIn::setMultiProducer(const bool bMultiProducer)
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->setMultiProducer(bMultiProducer);
+}
+
+void PVBaseIn::setDifferentialPush(const bool bDifferentialPush)
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->setDifferentialPush(bDifferentialPush);
+}
+
+void PVBaseIn::setHistoryDepth(const size_t depth)
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->setHistoryDepth(depth);
+}
+
+template<typename T>
+void PVBaseIn::getHistory(const timespec& from, const timespec& to, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getHistory(from, to, std::numeric_limits<size_t>::max(), pTimestamps, pValues);
+}
+
+template<typename T>
+void PVBaseIn::getHistory(const size_t numValues, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const
+{
+    const timespec from = {0, 0};
+    const timespec to = {std::numeric_limits<time_t>::max(), 0};
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getHistory(from, to, numValues, pTimestamps, pValues);
+}
+
+void PVBaseIn::setArchive(const std::string& fileName, const size_t numFrames)
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->setArchive(fileName, numFrames);
+}
+
+void PVBaseIn::setArchiveDirectory(const std::string& directory)
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->setArchiveDirectory(directory);
+}
+
+std::uint64_t PVBaseIn::getEnqueuedCount() const
+{
+    return std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getEnqueuedCount();
+}
+
+std::uint64_t PVBaseIn::getDeliveredCount() const
+{
+    return std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getDeliveredCount();
+}
+
+std::uint64_t PVBaseIn::getDroppedCount() const
+{
+    return std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getDroppedCount();
+}
+
+std::uint64_t PVBaseIn::getPushedCount() const
+{
+    return std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getPushedCount();
+}
+
+std::uint64_t PVBaseIn::getDecimatedCount() const
+{
+    return std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getDecimatedCount();
+}
+
+std::uint64_t PVBaseIn::getFilteredCount() const
+{
+    return std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getFilteredCount();
+}
+
+std::uint64_t PVBaseIn::getConflatedCount() const
+{
+    return std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getConflatedCount();
+}
+
+std::uint64_t PVBaseIn::getLinkSkippedCount() const
+{
+    return std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getLinkSkippedCount();
+}
+
+std::uint64_t PVBaseIn::getGapCount() const
+{
+    return std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getGapCount();
+}
+
+std::uint64_t PVBaseIn::getLastDeliveredSequence() const
+{
+    return std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->getLastDeliveredSequence();
+}
+
 void PVBaseIn::replicateFrom(const std::string &sourceInputPVName)
 {
-    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->replicateFrom(sourceInputPVName);
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->replicateFrom(sourceInputPVName, 1, 0);
+}
+
+void PVBaseIn::replicateFrom(const std::string &sourceInputPVName, const std::uint32_t decimation, const double maxRate)
+{
+    std::static_pointer_cast<PVBaseInImpl>(m_pImplementation)->replicateFrom(sourceInputPVName, decimation, maxRate);
 }
 
 template void PVBaseIn::read<std::int32_t>(timespec*, std::int32_t*) const;
 template void PVBaseIn::push<std::int32_t>(const timespec&, const std::int32_t&);
+template void PVBaseIn::push<std::int32_t>(const timespec&, const std::shared_ptr<const std::int32_t>&);
+template void PVBaseIn::getHistory<std::int32_t>(const timespec&, const timespec&, std::vector<timespec>*, std::vector<std::int32_t>*) const;
+template void PVBaseIn::getHistory<std::int32_t>(const size_t, std::vector<timespec>*, std::vector<std::int32_t>*) const;
 
 template void PVBaseIn::read<double>(timespec*, double*) const;
 template void PVBaseIn::push<double>(const timespec&, const double&);
+template void PVBaseIn::push<double>(const timespec&, const std::shared_ptr<const double>&);
+template void PVBaseIn::getHistory<double>(const timespec&, const timespec&, std::vector<timespec>*, std::vector<double>*) const;
+template void PVBaseIn::getHistory<double>(const size_t, std::vector<timespec>*, std::vector<double>*) const;
 
 template void PVBaseIn::read<std::vector<std::int8_t> >(timespec*, std::vector<std::int8_t>*) const;
 template void PVBaseIn::push<std::vector<std::int8_t> >(const timespec&, const std::vector<std::int8_t>&);
+template void PVBaseIn::push<std::vector<std::int8_t> >(const timespec&, const std::shared_ptr<const std::vector<std::int8_t> >&);
+template void PVBaseIn::getHistory<std::vector<std::int8_t> >(const timespec&, const timespec&, std::vector<timespec>*, std::vector<std::vector<std::int8_t> >*) const;
+template void PVBaseIn::getHistory<std::vector<std::int8_t> >(const size_t, std::vector<timespec>*, std::vector<std::vector<std::int8_t> >*) const;
+template void PVBaseIn::push<std::int8_t>(const timespec&, const std::int8_t*, size_t);
 
 template void PVBaseIn::read<std::vector<std::uint8_t> >(timespec*, std::vector<std::uint8_t>*) const;
 template void PVBaseIn::push<std::vector<std::uint8_t> >(const timespec&, const std::vector<std::uint8_t>&);
+template void PVBaseIn::push<std::vector<std::uint8_t> >(const timespec&, const std::shared_ptr<const std::vector<std::uint8_t> >&);
+template void PVBaseIn::getHistory<std::vector<std::uint8_t> >(const timespec&, const timespec&, std::vector<timespec>*, std::vector<std::vector<std::uint8_t> >*) const;
+template void PVBaseIn::getHistory<std::vector<std::uint8_t> >(const size_t, std::vector<timespec>*, std::vector<std::vector<std::uint8_t> >*) const;
+template void PVBaseIn::push<std::uint8_t>(const timespec&, const std::uint8_t*, size_t);
 
 template void PVBaseIn::read<std::vector<std::int32_t> >(timespec*, std::vector<std::int32_t>*) const;
 template void PVBaseIn::push<std::vector<std::int32_t> >(const timespec&, const std::vector<std::int32_t>&);
+template void PVBaseIn::push<std::vector<std::int32_t> >(const timespec&, const std::shared_ptr<const std::vector<std::int32_t> >&);
+template void PVBaseIn::getHistory<std::vector<std::int32_t> >(const timespec&, const timespec&, std::vector<timespec>*, std::vector<std::vector<std::int32_t> >*) const;
+template void PVBaseIn::getHistory<std::vector<std::int32_t> >(const size_t, std::vector<timespec>*, std::vector<std::vector<std::int32_t> >*) const;
+template void PVBaseIn::push<std::int32_t>(const timespec&, const std::int32_t*, size_t);
 
 template void PVBaseIn::read<std::vector<double> >(timespec*, std::vector<double>*) const;
 template void PVBaseIn::push<std::vector<double> >(const timespec&, const std::vector<double>&);
+template void PVBaseIn::push<std::vector<double> >(const timespec&, const std::shared_ptr<const std::vector<double> >&);
+template void PVBaseIn::getHistory<std::vector<double> >(const timespec&, const timespec&, std::vector<timespec>*, std::vector<std::vector<double> >*) const;
+template void PVBaseIn::getHistory<std::vector<double> >(const size_t, std::vector<timespec>*, std::vector<std::vector<double> >*) const;
+template void PVBaseIn::push<double>(const timespec&, const double*, size_t);
 
 template void PVBaseIn::read<std::string >(timespec*, std::string*) const;
 template void PVBaseIn::push<std::string >(const timespec&, const std::string&);
+template void PVBaseIn::push<std::string >(const timespec&, const std::shared_ptr<const std::string>&);
+template void PVBaseIn::getHistory<std::string >(const timespec&, const timespec&, std::vector<timespec>*, std::vector<std::string>*) const;
+template void PVBaseIn::getHistory<std::string >(const size_t, std::vector<timespec>*, std::vector<std::string>*) const;
 
 }
 
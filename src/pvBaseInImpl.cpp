@@ -8,158 +8,1247 @@
  */
 
 #include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <limits>
 #include <cstring>
+#include <type_traits>
+#include <utility>
+#include <thread>
+#include <chrono>
 
+#include "nds3/exceptions.h"
 #include "nds3/impl/pvBaseInImpl.h"
 #include "nds3/impl/pvBaseOutImpl.h"
 #include "nds3/impl/portImpl.h"
+#include "nds3/impl/interfaceBaseImpl.h"
 #include "nds3/impl/ndsFactoryImpl.h"
 #include "nds3/impl/factoryBaseImpl.h"
 
 namespace nds
 {
 
+namespace
+{
+
+/*
+ * Maximum time that the removal of a receiver waits for the pushes that are
+ *  still delivering values to it
+ *
+ *****/
+const std::chrono::milliseconds receiverRemovalTimeout(1000);
+
+/*
+ * Number of deliveries to the receivers active on the calling thread. A
+ *  receiver removed by the same thread while it receives a value must not
+ *  wait for the deliveries to finish: one of them is the caller
+ *
+ *****/
+thread_local std::uint32_t receiversDeliveryDepth(0);
+
+/*
+ * Dispatch queue loads that make the adaptive decimation double or halve the
+ *  decimation factor. The gap between them avoids oscillations
+ *
+ *****/
+const double adaptiveDecimationHighLoad(0.5);
+const double adaptiveDecimationLowLoad(0.125);
+
+/*
+ * Size of the elements recorded in the history and in the archive for each
+ *  data type
+ *
+ *****/
+size_t getElementSize(const dataType_t dataType)
+{
+    switch(dataType)
+    {
+    case dataType_t::dataInt32:
+    case dataType_t::dataInt32Array:
+        return sizeof(std::int32_t);
+    case dataType_t::dataFloat64:
+    case dataType_t::dataFloat64Array:
+        return sizeof(double);
+    case dataType_t::dataInt8Array:
+    case dataType_t::dataUint8Array:
+    case dataType_t::dataString:
+        return 1;
+    }
+    return 1;
+}
+
+/*
+ * Convert the seconds passed to the command "history" into a timestamp
+ *
+ *****/
+timespec secondsToTimestamp(const std::string& secondsString)
+{
+    double seconds;
+    std::istringstream convertParameter(secondsString);
+    convertParameter >> seconds;
+    if(convertParameter.fail())
+    {
+        throw std::runtime_error("Invalid time: " + secondsString);
+    }
+
+    timespec timestamp;
+    const double integerSeconds(std::floor(seconds));
+    timestamp.tv_sec = (time_t)integerSeconds;
+    timestamp.tv_nsec = (long)((seconds - integerSeconds) * 1e9);
+    return timestamp;
+}
+
+/*
+ * Write the elements of a recorded value for the command "history"
+ *
+ *****/
+template<typename T>
+void formatHistoryValue(std::ostream& stream, const T& value)
+{
+    stream << " " << value;
+}
+
+template<typename E>
+void formatHistoryValue(std::ostream& stream, const std::vector<E>& value)
+{
+    for(typename std::vector<E>::const_iterator scanElements(value.begin()), endElements(value.end()); scanElements != endElements; ++scanElements)
+    {
+        stream << " " << +*scanElements;
+    }
+}
+
+
+}
+
 PVBaseInImpl::PVBaseInImpl(const std::string& name, const inputPvType_t pvType): PVBaseImpl(name), m_pvType(pvType),
-    m_decimationFactor(1), m_decimationCount(1)
+    m_bHasReceivers(false),
+    m_bMultiProducer(false),
+    m_decimationFactor(1), m_decimationCount(1), m_effectiveDecimation(1), m_maxAdaptiveDecimation(0),
+    m_decimationMode(decimationMode_t::sample), m_bResetDecimator(false),
+    m_deadbandType(deadbandType_t::none), m_deadband(0), m_bResetDeadband(false),
+    m_publishInterval(0), m_bFlushScheduled(false),
+    m_pushPolicy(pushPolicy_t::block), m_enqueuedCount(0), m_deliveredCount(0), m_droppedCount(0),
+    m_pushedCount(0), m_decimatedCount(0), m_filteredCount(0), m_conflatedCount(0), m_linkSkippedCount(0),
+    m_gapCount(0), m_lastDeliveredSequence(0),
+    m_bDifferentialPush(false),
+    m_bHistory(false),
+    m_pArchive(0)
+{
+    defineCommand("replicate", "replicate destination source", 1, std::bind(&PVBaseInImpl::commandReplicate,this, std::placeholders::_1));
+    defineCommand("decimation", "decimation node decimationFactor", 1, std::bind(&PVBaseInImpl::commandDecimation,this, std::placeholders::_1));
+    defineCommand("decimationMode", "decimationMode node sample|average|minimum|maximum|peakHold", 1, std::bind(&PVBaseInImpl::commandDecimationMode,this, std::placeholders::_1));
+    defineCommand("adaptiveDecimation", "adaptiveDecimation node maxDecimationFactor (0 disables)", 1, std::bind(&PVBaseInImpl::commandAdaptiveDecimation,this, std::placeholders::_1));
+    defineCommand("deadband", "deadband node none|absolute|relative deadband", 2, std::bind(&PVBaseInImpl::commandDeadband,this, std::placeholders::_1));
+    defineCommand("differentialPush", "differentialPush node 0|1", 1, std::bind(&PVBaseInImpl::commandDifferentialPush,this, std::placeholders::_1));
+    defineCommand("maxPublishRate", "maxPublishRate node valuesPerSecond", 1, std::bind(&PVBaseInImpl::commandMaxPublishRate,this, std::placeholders::_1));
+    defineCommand("pushPolicy", "pushPolicy node block|dropOldest|dropNewest|keepLatest|conflate", 1, std::bind(&PVBaseInImpl::commandPushPolicy,this, std::placeholders::_1));
+    defineCommand("pushStatistics", "pushStatistics node (returns enqueued delivered dropped)", 0, std::bind(&PVBaseInImpl::commandPushStatistics,this, std::placeholders::_1));
+    defineCommand("pushDiagnostics", "pushDiagnostics node (returns pushed decimated filtered conflated linkSkipped enqueued dropped delivered gaps)", 0, std::bind(&PVBaseInImpl::commandPushDiagnostics,this, std::placeholders::_1));
+    defineCommand("historyDepth", "historyDepth node numValues (0 disables)", 1, std::bind(&PVBaseInImpl::commandHistoryDepth,this, std::placeholders::_1));
+    defineCommand("history", "history node last numValues | history node fromSeconds toSeconds", 2, std::bind(&PVBaseInImpl::commandHistory,this, std::placeholders::_1));
+    defineCommand("archive", "archive node fileName numFrames (0 closes the archive, the file is created in the archive directory)", 2, std::bind(&PVBaseInImpl::commandArchive,this, std::placeholders::_1));
+}
+
+void PVBaseInImpl::initialize(FactoryBaseImpl &controlSystem)
+{
+    PVBaseImpl::initialize(controlSystem);
+    NdsFactoryImpl::getInstance().registerInputPV(this);
+}
+
+void PVBaseInImpl::deinitialize()
+{
+    getCachedPort().cancelFlush(*this);
+    NdsFactoryImpl::getInstance().deregisterInputPV(this);
+    PVBaseImpl::deinitialize();
+}
+
+void PVBaseInImpl::replicateFrom(const std::string &sourceInputPVName, const std::uint32_t decimation, const double maxRate)
+{
+    NdsFactoryImpl::getInstance().replicate(sourceInputPVName, this, decimation, maxRate);
+}
+
+void PVBaseInImpl::read(timespec* /* pTimestamp */, std::int32_t* /* pValue */) const
+{
+    throw;
+}
+
+void PVBaseInImpl::read(timespec* /* pTimestamp */, double* /* pValue */) const
+{
+    throw;
+}
+
+void PVBaseInImpl::read(timespec* pTimestamp, std::vector<std::int8_t>* pValue) const
+{
+    // TODO
+    // Epics calls this also for unsigned-int and strings
+    // If we arrive here maybe we really wanted to call the unsigned int function.
+    // This is as ugly as it can get: consider modifying this
+    read(pTimestamp, (std::vector<std::uint8_t>*) pValue);
+}
+
+void PVBaseInImpl::read(timespec* pTimestamp, std::vector<std::uint8_t>* pValue) const
+{
+    // TODO
+    // Epics calls this also for strings.
+    // If we arrive here maybe we really wanted to call the string function.
+    // This is as ugly as it can get: consider modifying this
+    std::string temporaryValue;
+    read(pTimestamp, &temporaryValue);
+    pValue->resize(temporaryValue.size());
+    ::memcpy(pValue->data(), temporaryValue.data(), temporaryValue.size());
+}
+
+void PVBaseInImpl::read(timespec* /* pTimestamp */, std::vector<std::int32_t>* /* pValue */) const
+{
+    throw;
+}
+
+void PVBaseInImpl::read(timespec* /* pTimestamp */, std::vector<double>* /* pValue */) const
+{
+    throw;
+}
+
+void PVBaseInImpl::read(timespec* /* pTimestamp */, std::string* /* pValue */) const
+{
+    throw;
+}
+
+
+template<typename T>
+void PVBaseInImpl::push(const timespec& timestamp, const T& value)
+{
+    // Find the port then push the value
+    ////////////////////////////////////
+    PortImpl& port(getCachedPort());
+    countProducerEvent(m_pushedCount);
+    if(m_bHistory.load(std::memory_order_relaxed) || m_pArchive.load(std::memory_order_relaxed) != 0)
+    {
+        recordValue(timestamp, value);
+    }
+    std::unique_lock<std::mutex> lockProducers(m_lockProducers, std::defer_lock);
+    if(m_bMultiProducer.load(std::memory_order_relaxed) && !serializeProducer(port, lockProducers))
+    {
+        if(countDecimation())
+        {
+            publish(port, timestamp, value);
+        }
+
+        // A receiver added after serializeProducer() checked the flag still
+        //  gets the value: the receivers are served under the lock
+        ////////////////////////////////////////////////////////////////////
+        if(!m_bHasReceivers.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        lockProducers.lock();
+    }
+    else if(m_decimationMode.load(std::memory_order_relaxed) != decimationMode_t::sample)
+    {
+        pushDecimated(port, timestamp, value);
+    }
+    else if(countDecimation())
+    {
+        if(isOutsideDeadband(value))
+        {
+            publish(port, timestamp, value);
+        }
+    }
+
+    // Push the value to the outputs (subscription) and inputs (replication)
+    ////////////////////////////////////////////////////////////////////////
+    const std::shared_ptr<const receivers_t> pReceivers(getReceivers());
+    if(pReceivers == 0)
+    {
+        return;
+    }
+
+    // Scalars are cheaper to copy than to share
+    ////////////////////////////////////////////
+    if(std::is_scalar<T>::value)
+    {
+        ReceiversDeliveryScope deliveryScope;
+
+        for(subscribersList_t::const_iterator scanOutputs(pReceivers->m_subscriberOutputPVs.begin()), endOutputs(pReceivers->m_subscriberOutputPVs.end());
+            scanOutputs != endOutputs;
+            ++scanOutputs)
+        {
+            if(passLink(scanOutputs->second))
+            {
+                scanOutputs->first->write(timestamp, value);
+            }
+        }
+
+        for(destinationList_t::const_iterator scanInputs(pReceivers->m_replicationDestinationPVs.begin()), endInputs(pReceivers->m_replicationDestinationPVs.end());
+            scanInputs != endInputs;
+            ++scanInputs)
+        {
+            if(passLink(scanInputs->second))
+            {
+                scanInputs->first->push(timestamp, value);
+            }
+        }
+        return;
+    }
+
+    // Copy the value once and share the copy with all the receivers
+    ////////////////////////////////////////////////////////////////
+    pushToReceivers(*pReceivers, timestamp, std::shared_ptr<const T>(std::make_shared<T>(value)));
+}
+
+template<typename T>
+void PVBaseInImpl::push(const timespec& timestamp, const std::shared_ptr<const T>& pValue)
+{
+    // Find the port then push the value
+    ////////////////////////////////////
+    PortImpl& port(getCachedPort());
+    countProducerEvent(m_pushedCount);
+    if(m_bHistory.load(std::memory_order_relaxed) || m_pArchive.load(std::memory_order_relaxed) != 0)
+    {
+        recordValue(timestamp, *pValue);
+    }
+    std::unique_lock<std::mutex> lockProducers(m_lockProducers, std::defer_lock);
+    if(m_bMultiProducer.load(std::memory_order_relaxed) && !serializeProducer(port, lockProducers))
+    {
+        if(countDecimation())
+        {
+            publish(port, timestamp, pValue);
+        }
+
+        // A receiver added after serializeProducer() checked the flag still
+        //  gets the value: the receivers are served under the lock
+        ////////////////////////////////////////////////////////////////////
+        if(!m_bHasReceivers.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        lockProducers.lock();
+    }
+    else if(m_decimationMode.load(std::memory_order_relaxed) != decimationMode_t::sample)
+    {
+        pushDecimated(port, timestamp, *pValue);
+    }
+    else if(countDecimation())
+    {
+        if(isOutsideDeadband(*pValue))
+        {
+            publish(port, timestamp, pValue);
+        }
+    }
+
+    const std::shared_ptr<const receivers_t> pReceivers(getReceivers());
+    if(pReceivers != 0)
+    {
+        pushToReceivers(*pReceivers, timestamp, pValue);
+    }
+}
+
+/*
+ * Scalars are cheaper to copy than to share
+ *
+ *****/
+void PVBaseInImpl::push(const timespec& timestamp, std::int32_t&& value)
+{
+    push(timestamp, static_cast<const std::int32_t&>(value));
+}
+
+void PVBaseInImpl::push(const timespec& timestamp, double&& value)
+{
+    push(timestamp, static_cast<const double&>(value));
+}
+
+void PVBaseInImpl::push(const timespec& timestamp, std::vector<std::int8_t>&& value)
+{
+    pushOwned(timestamp, value);
+}
+
+void PVBaseInImpl::push(const timespec& timestamp, std::vector<std::uint8_t>&& value)
+{
+    pushOwned(timestamp, value);
+}
+
+void PVBaseInImpl::push(const timespec& timestamp, std::vector<std::int32_t>&& value)
+{
+    pushOwned(timestamp, value);
+}
+
+void PVBaseInImpl::push(const timespec& timestamp, std::vector<double>&& value)
+{
+    pushOwned(timestamp, value);
+}
+
+void PVBaseInImpl::push(const timespec& timestamp, std::string&& value)
+{
+    pushOwned(timestamp, value);
+}
+
+/*
+ * The moved value becomes the shared buffer: the port, the subscribers and
+ *  the replication destinations reference it without copying it
+ *
+ *****/
+template<typename T>
+void PVBaseInImpl::pushOwned(const timespec& timestamp, T& value)
+{
+    const std::shared_ptr<const T> pValue(std::make_shared<T>(std::move(value)));
+    push<T>(timestamp, pValue);
+}
+
+template<typename T>
+void PVBaseInImpl::push(const timespec& timestamp, const T* pData, size_t count)
+{
+    if(count > getMaxElements())
+    {
+        std::ostringstream errorMessage;
+        errorMessage << "Cannot push " << count << " elements into the PV " << getFullName() << ": the maximum is " << getMaxElements();
+        throw MaxElementsExceeded(errorMessage.str());
+    }
+
+    // Find the port then push the value
+    ////////////////////////////////////
+    PortImpl& port(getCachedPort());
+    countProducerEvent(m_pushedCount);
+    if(m_bHistory.load(std::memory_order_relaxed) || m_pArchive.load(std::memory_order_relaxed) != 0)
+    {
+        recordElements(timestamp, pData, count);
+    }
+    std::unique_lock<std::mutex> lockProducers(m_lockProducers, std::defer_lock);
+    if(m_bMultiProducer.load(std::memory_order_relaxed) && !serializeProducer(port, lockProducers))
+    {
+        if(countDecimation())
+        {
+            publish(port, timestamp, pData, count);
+        }
+
+        // A receiver added after serializeProducer() checked the flag still
+        //  gets the value: the receivers are served under the lock
+        ////////////////////////////////////////////////////////////////////
+        if(!m_bHasReceivers.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        lockProducers.lock();
+    }
+    else if(m_decimationMode.load(std::memory_order_relaxed) != decimationMode_t::sample)
+    {
+        pushDecimated(port, timestamp, pData, count);
+    }
+    else if(countDecimation())
+    {
+        if(isOutsideDeadband(pData, count))
+        {
+            publish(port, timestamp, pData, count);
+        }
+    }
+
+    const std::shared_ptr<const receivers_t> pReceivers(getReceivers());
+    if(pReceivers == 0)
+    {
+        return;
+    }
+
+    // Copy the elements once and share the copy with all the receivers
+    ////////////////////////////////////////////////////////////////////
+    pushToReceivers(*pReceivers, timestamp, std::shared_ptr<const std::vector<T> >(std::make_shared<std::vector<T> >(pData, pData + count)));
+}
+
+/*
+ * Scalars are combined as arrays of one element
+ *
+ *****/
+template<typename T>
+void PVBaseInImpl::pushDecimated(PortImpl& port, const timespec& timestamp, const T& value)
+{
+    if(!prepareDecimator())
+    {
+        return;
+    }
+
+    m_decimator.accumulate(&value, 1);
+    if(countDecimation())
+    {
+        T result;
+        m_decimator.getResult(&result);
+        if(isOutsideDeadband(result))
+        {
+            publish(port, timestamp, result);
+        }
+    }
+}
+
+template<typename E>
+void PVBaseInImpl::pushDecimated(PortImpl& port, const timespec& timestamp, const std::vector<E>& value)
+{
+    pushDecimated(port, timestamp, value.data(), value.size());
+}
+
+/*
+ * The combined elements are pushed in a new shared buffer: the accumulator is
+ *  reused for the next interval
+ *
+ *****/
+template<typename E>
+void PVBaseInImpl::pushDecimated(PortImpl& port, const timespec& timestamp, const E* pData, size_t count)
+{
+    if(!prepareDecimator())
+    {
+        return;
+    }
+
+    m_decimator.accumulate(pData, count);
+    if(countDecimation())
+    {
+        const std::shared_ptr<std::vector<E> > pResult(std::make_shared<std::vector<E> >(m_decimator.getSize()));
+        m_decimator.getResult(pResult->data());
+        if(isOutsideDeadband(pResult->data(), pResult->size()))
+        {
+            publish(port, timestamp, std::shared_ptr<const std::vector<E> >(pResult));
+        }
+    }
+}
+
+/*
+ * Strings cannot be combined: they are sampled
+ *
+ *****/
+void PVBaseInImpl::pushDecimated(PortImpl& port, const timespec& timestamp, const std::string& value)
+{
+    if(prepareDecimator() && countDecimation())
+    {
+        publish(port, timestamp, value);
+    }
+}
+
+template<typename T>
+void PVBaseInImpl::publish(PortImpl& port, const timespec& timestamp, const T& value)
+{
+    if(m_publishInterval.load(std::memory_order_relaxed) == 0)
+    {
+        port.push(*this, timestamp, value);
+        return;
+    }
+    pushRateLimited(port, timestamp, value);
+}
+
+/*
+ * A held value must survive the caller's buffer: the elements are copied
+ *  only when the rate limit is active
+ *
+ *****/
+template<typename E>
+void PVBaseInImpl::publish(PortImpl& port, const timespec& timestamp, const E* pData, size_t count)
+{
+    if(m_publishInterval.load(std::memory_order_relaxed) == 0)
+    {
+        port.push(*this, timestamp, pData, count);
+        return;
+    }
+    pushRateLimited(port, timestamp, std::shared_ptr<const std::vector<E> >(std::make_shared<std::vector<E> >(pData, pData + count)));
+}
+
+/*
+ * The lock keeps the values in order when the flush thread pushes the held
+ *  value while the device pushes a new one
+ *
+ *****/
+template<typename T>
+void PVBaseInImpl::pushRateLimited(PortImpl& port, const timespec& timestamp, const T& value)
+{
+    std::lock_guard<std::mutex> lock(m_lockRateLimit);
+
+    const std::chrono::steady_clock::time_point now(std::chrono::steady_clock::now());
+    if(!m_bFlushScheduled && now >= m_nextPublishTime)
+    {
+        m_nextPublishTime = now + std::chrono::nanoseconds(m_publishInterval.load(std::memory_order_relaxed));
+        port.push(*this, timestamp, value);
+        return;
+    }
+
+    // Keep only the latest value: the port's flush thread pushes it when
+    //  the interval expires
+    ///////////////////////////////////////////////////////////////////////
+    if(m_rateLimitedRecord.getPV() != 0)
+    {
+        countProducerEvent(m_conflatedCount);
+    }
+    m_rateLimitedRecord.set(*this, timestamp, value);
+    if(!m_bFlushScheduled)
+    {
+        m_bFlushScheduled = port.scheduleFlush(*this, m_nextPublishTime);
+        if(!m_bFlushScheduled)
+        {
+            port.push(m_rateLimitedRecord);
+            m_rateLimitedRecord.clear();
+        }
+    }
+}
+
+void PVBaseInImpl::flushRateLimited(PortImpl& port)
+{
+    std::lock_guard<std::mutex> lock(m_lockRateLimit);
+
+    m_bFlushScheduled = false;
+    if(m_rateLimitedRecord.getPV() == 0)
+    {
+        return;
+    }
+    m_nextPublishTime = std::chrono::steady_clock::now() + std::chrono::nanoseconds(m_publishInterval.load(std::memory_order_relaxed));
+    port.push(m_rateLimitedRecord);
+    m_rateLimitedRecord.clear();
+}
+
+/*
+ * Scalars are compared as arrays of one element
+ *
+ *****/
+template<typename T>
+bool PVBaseInImpl::isOutsideDeadband(const T& value)
+{
+    return isOutsideDeadband(&value, 1);
+}
+
+template<typename E>
+bool PVBaseInImpl::isOutsideDeadband(const std::vector<E>& value)
+{
+    return isOutsideDeadband(value.data(), value.size());
+}
+
+template<typename E>
+bool PVBaseInImpl::isOutsideDeadband(const E* pData, size_t count)
+{
+    if(m_bResetDeadband.load(std::memory_order_relaxed) && m_bResetDeadband.exchange(false))
+    {
+        m_deadbandFilter.reset(m_deadbandType.load(), m_deadband.load());
+    }
+    if(m_deadbandType.load(std::memory_order_relaxed) == deadbandType_t::none)
+    {
+        return true;
+    }
+    if(!m_deadbandFilter.update(pData, count))
+    {
+        countProducerEvent(m_filteredCount);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Strings are not filtered
+ *
+ *****/
+bool PVBaseInImpl::isOutsideDeadband(const std::string& /* value */)
+{
+    return true;
+}
+
+/*
+ * The counter is updated with plain loads and stores when a single thread
+ *  pushes, with a compare-and-swap when several threads push
+ *
+ *****/
+bool PVBaseInImpl::countDecimation()
+{
+    if(!m_bMultiProducer.load(std::memory_order_relaxed))
+    {
+        const std::uint32_t decimationCount(m_decimationCount.load(std::memory_order_relaxed) - 1);
+        if(decimationCount != 0)
+        {
+            m_decimationCount.store(decimationCount, std::memory_order_relaxed);
+            countProducerEvent(m_decimatedCount);
+            return false;
+        }
+        m_decimationCount.store(m_effectiveDecimation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        adaptDecimation();
+        return true;
+    }
+
+    std::uint32_t decimationCount(m_decimationCount.load(std::memory_order_relaxed));
+    std::uint32_t nextCount;
+    do
+    {
+        nextCount = decimationCount == 1 ? m_effectiveDecimation.load(std::memory_order_relaxed) : decimationCount - 1;
+    }
+    while(!m_decimationCount.compare_exchange_weak(decimationCount, nextCount, std::memory_order_relaxed));
+    if(decimationCount != 1)
+    {
+        countProducerEvent(m_decimatedCount);
+        return false;
+    }
+    adaptDecimation();
+    return true;
+}
+
+/*
+ * Concurrent producers may adapt the factor at the same time: the last store
+ *  wins and the factor stays within the limits
+ *
+ *****/
+void PVBaseInImpl::adaptDecimation()
+{
+    const std::uint32_t maxDecimation(m_maxAdaptiveDecimation.load(std::memory_order_relaxed));
+    const std::uint32_t minDecimation(m_decimationFactor.load(std::memory_order_relaxed));
+    if(maxDecimation == 0 || minDecimation == 0)
+    {
+        return;
+    }
+
+    const double load(getCachedPort().getDispatchLoad());
+    const std::uint32_t decimation(m_effectiveDecimation.load(std::memory_order_relaxed));
+    if(load > adaptiveDecimationHighLoad && decimation < maxDecimation)
+    {
+        m_effectiveDecimation.store(decimation > maxDecimation / 2 ? maxDecimation : decimation * 2, std::memory_order_relaxed);
+    }
+    else if(load < adaptiveDecimationLowLoad && decimation > minDecimation)
+    {
+        m_effectiveDecimation.store(decimation / 2 < minDecimation ? minDecimation : decimation / 2, std::memory_order_relaxed);
+    }
+}
+
+/*
+ * Same strategy as countDecimation(): the counters cost a plain store when
+ *  a single thread pushes
+ *
+ *****/
+void PVBaseInImpl::countProducerEvent(std::atomic<std::uint64_t>& counter)
+{
+    if(!m_bMultiProducer.load(std::memory_order_relaxed))
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*
+ * The lock-free path skips all the stages that keep a state between two
+ *  values. The rate limiter has its own lock and the port's dispatch queue
+ *  accepts concurrent producers
+ *
+ *****/
+bool PVBaseInImpl::serializeProducer(PortImpl& port, std::unique_lock<std::mutex>& lockProducers)
+{
+    const bool bSerialize(m_decimationMode.load(std::memory_order_relaxed) != decimationMode_t::sample ||
+                          m_deadbandType.load(std::memory_order_relaxed) != deadbandType_t::none ||
+                          m_bResetDecimator.load(std::memory_order_relaxed) ||
+                          m_bResetDeadband.load(std::memory_order_relaxed) ||
+                          m_bHasReceivers.load(std::memory_order_relaxed) ||
+                          !port.isDispatching());
+    if(bSerialize)
+    {
+        lockProducers.lock();
+    }
+    return bSerialize;
+}
+
+bool PVBaseInImpl::prepareDecimator()
+{
+    if(m_bResetDecimator.load(std::memory_order_relaxed) && m_bResetDecimator.exchange(false))
+    {
+        m_decimator.reset(m_decimationMode.load());
+        m_decimationCount.store(m_effectiveDecimation.load());
+    }
+    if(m_decimationFactor == 0)
+    {
+        countProducerEvent(m_decimatedCount);
+        return false;
+    }
+    return true;
+}
+
+template<typename T>
+void PVBaseInImpl::pushToReceivers(const receivers_t& receivers, const timespec& timestamp, const std::shared_ptr<const T>& pValue)
+{
+    ReceiversDeliveryScope deliveryScope;
+
+    for(subscribersList_t::const_iterator scanOutputs(receivers.m_subscriberOutputPVs.begin()), endOutputs(receivers.m_subscriberOutputPVs.end());
+        scanOutputs != endOutputs;
+        ++scanOutputs)
+    {
+        if(passLink(scanOutputs->second))
+        {
+            scanOutputs->first->write(timestamp, pValue);
+        }
+    }
+
+    for(destinationList_t::const_iterator scanInputs(receivers.m_replicationDestinationPVs.begin()), endInputs(receivers.m_replicationDestinationPVs.end());
+        scanInputs != endInputs;
+        ++scanInputs)
+    {
+        if(passLink(scanInputs->second))
+        {
+            scanInputs->first->push(timestamp, pValue);
+        }
+    }
+}
+
+std::shared_ptr<const PVBaseInImpl::receivers_t> PVBaseInImpl::getReceivers() const
+{
+    // The flag spares the snapshot to the PVs without receivers
+    ////////////////////////////////////////////////////////////
+    if(!m_bHasReceivers.load(std::memory_order_acquire))
+    {
+        return std::shared_ptr<const receivers_t>();
+    }
+    return std::atomic_load(&m_pReceivers);
+}
+
+PVBaseInImpl::ReceiversDeliveryScope::ReceiversDeliveryScope()
+{
+    ++receiversDeliveryDepth;
+}
+
+PVBaseInImpl::ReceiversDeliveryScope::~ReceiversDeliveryScope()
+{
+    --receiversDeliveryDepth;
+}
+
+bool PVBaseInImpl::passLink(const std::shared_ptr<LinkFilterImpl>& pFilter)
+{
+    if(pFilter == 0 || pFilter->pass())
+    {
+        return true;
+    }
+    countProducerEvent(m_linkSkippedCount);
+    return false;
+}
+
+/*
+ * Publish the new list, then wait until the pushes that still iterate the
+ *  previous one release it. The wait is skipped when the caller is itself
+ *  delivering a value and is bounded by receiverRemovalTimeout
+ *
+ *****/
+void PVBaseInImpl::publishReceivers(const std::shared_ptr<const receivers_t>& pReceivers, const bool bRemovedReceiver)
+{
+    const bool bHasReceivers(!pReceivers->m_subscriberOutputPVs.empty() || !pReceivers->m_replicationDestinationPVs.empty());
+
+    std::shared_ptr<const receivers_t> pPreviousReceivers(std::atomic_exchange(&m_pReceivers, pReceivers));
+    m_bHasReceivers.store(bHasReceivers, std::memory_order_release);
+
+    if(!bRemovedReceiver || pPreviousReceivers == 0)
+    {
+        return;
+    }
+
+    // A receiver that removes a link while it receives a value holds the
+    //  previous list itself
+    /////////////////////////////////////////////////////////////////////
+    if(receiversDeliveryDepth != 0)
+    {
+        return;
+    }
+
+    // The pushes that started after the exchange see the new list, so the
+    //  number of users of the previous one can only decrease
+    //////////////////////////////////////////////////////////////////////
+    const std::chrono::steady_clock::time_point deadline(std::chrono::steady_clock::now() + receiverRemovalTimeout);
+    while(pPreviousReceivers.use_count() != 1)
+    {
+        if(std::chrono::steady_clock::now() >= deadline)
+        {
+            return;
+        }
+        std::this_thread::yield();
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+}
+
+void PVBaseInImpl::subscribeReceiver(PVBaseOutImpl* pReceiver, const std::uint32_t decimation, const double maxRate)
+{
+    std::lock_guard<std::mutex> lock(m_lockSubscribersList);
+
+    std::shared_ptr<receivers_t> pReceivers(std::make_shared<receivers_t>());
+    if(m_pReceivers != 0)
+    {
+        *pReceivers = *m_pReceivers;
+    }
+    pReceivers->m_subscriberOutputPVs[pReceiver] = makeLinkFilter(decimation, maxRate);
+    publishReceivers(pReceivers, false);
+}
+
+/*
+ * Links that forward all the values have no filter: push() skips the
+ *  filtering with a single test
+ *
+ *****/
+std::shared_ptr<LinkFilterImpl> PVBaseInImpl::makeLinkFilter(const std::uint32_t decimation, const double maxRate)
+{
+    if(!LinkFilterImpl::isNeeded(decimation, maxRate))
+    {
+        return std::shared_ptr<LinkFilterImpl>();
+    }
+    return std::make_shared<LinkFilterImpl>(decimation, maxRate);
+}
+
+void PVBaseInImpl::unsubscribeReceiver(PVBaseOutImpl* pReceiver)
+{
+    std::lock_guard<std::mutex> lock(m_lockSubscribersList);
+
+    if(m_pReceivers == 0 || m_pReceivers->m_subscriberOutputPVs.find(pReceiver) == m_pReceivers->m_subscriberOutputPVs.end())
+    {
+        return;
+    }
+
+    std::shared_ptr<receivers_t> pReceivers(std::make_shared<receivers_t>(*m_pReceivers));
+    pReceivers->m_subscriberOutputPVs.erase(pReceiver);
+    publishReceivers(pReceivers, true);
+}
+
+void PVBaseInImpl::replicateTo(PVBaseInImpl *pDestination, const std::uint32_t decimation, const double maxRate)
+{
+    std::lock_guard<std::mutex> lock(m_lockSubscribersList);
+
+    std::shared_ptr<receivers_t> pReceivers(std::make_shared<receivers_t>());
+    if(m_pReceivers != 0)
+    {
+        *pReceivers = *m_pReceivers;
+    }
+    pReceivers->m_replicationDestinationPVs[pDestination] = makeLinkFilter(decimation, maxRate);
+    publishReceivers(pReceivers, false);
+}
+
+void PVBaseInImpl::stopReplicationTo(PVBaseInImpl* pDestination)
+{
+    std::lock_guard<std::mutex> lock(m_lockSubscribersList);
+
+    if(m_pReceivers == 0 || m_pReceivers->m_replicationDestinationPVs.find(pDestination) == m_pReceivers->m_replicationDestinationPVs.end())
+    {
+        return;
+    }
+
+    std::shared_ptr<receivers_t> pReceivers(std::make_shared<receivers_t>(*m_pReceivers));
+    pReceivers->m_replicationDestinationPVs.erase(pDestination);
+    publishReceivers(pReceivers, true);
+}
+
+
+void PVBaseInImpl::setDecimation(const std::uint32_t decimation)
+{
+    m_decimationFactor.store(decimation);
+    m_effectiveDecimation.store(decimation);
+    m_decimationCount.store(decimation);
+    m_bResetDecimator.store(true);
+}
+
+void PVBaseInImpl::setDecimationMode(const decimationMode_t decimationMode)
 {
-    defineCommand("replicate", "replicate destination source", 1, std::bind(&PVBaseInImpl::commandReplicate,this, std::placeholders::_1));
-    defineCommand("decimation", "decimation node decimationFactor", 1, std::bind(&PVBaseInImpl::commandDecimation,this, std::placeholders::_1));
+    m_decimationMode.store(decimationMode);
+    m_bResetDecimator.store(true);
 }
 
-void PVBaseInImpl::initialize(FactoryBaseImpl &controlSystem)
+decimationMode_t PVBaseInImpl::getDecimationMode() const
 {
-    PVBaseImpl::initialize(controlSystem);
-    NdsFactoryImpl::getInstance().registerInputPV(this);
+    return m_decimationMode.load();
 }
 
-void PVBaseInImpl::deinitialize()
+void PVBaseInImpl::setAdaptiveDecimation(const std::uint32_t maxDecimation)
 {
-    NdsFactoryImpl::getInstance().deregisterInputPV(this);
-    PVBaseImpl::deinitialize();
+    m_maxAdaptiveDecimation.store(maxDecimation);
+    if(maxDecimation == 0)
+    {
+        m_effectiveDecimation.store(m_decimationFactor.load());
+    }
 }
 
-void PVBaseInImpl::replicateFrom(const std::string &sourceInputPVName)
+std::uint32_t PVBaseInImpl::getAdaptiveDecimation() const
 {
-    NdsFactoryImpl::getInstance().replicate(sourceInputPVName, this);
+    return m_maxAdaptiveDecimation.load();
 }
 
-void PVBaseInImpl::read(timespec* /* pTimestamp */, std::int32_t* /* pValue */) const
+std::uint32_t PVBaseInImpl::getEffectiveDecimation() const
 {
-    throw;
+    return m_effectiveDecimation.load();
 }
 
-void PVBaseInImpl::read(timespec* /* pTimestamp */, double* /* pValue */) const
+void PVBaseInImpl::setDeadband(const deadbandType_t type, const double deadband)
 {
-    throw;
+    m_deadband.store(deadband);
+    m_deadbandType.store(type);
+    m_bResetDeadband.store(true);
 }
 
-void PVBaseInImpl::read(timespec* pTimestamp, std::vector<std::int8_t>* pValue) const
+void PVBaseInImpl::setMaxPublishRate(const double maxRate)
 {
-    // TODO
-    // Epics calls this also for unsigned-int and strings
-    // If we arrive here maybe we really wanted to call the unsigned int function.
-    // This is as ugly as it can get: consider modifying this
-    read(pTimestamp, (std::vector<std::uint8_t>*) pValue);
+    m_publishInterval.store(maxRate > 0 ? (std::int64_t)(1e9 / maxRate) : 0);
 }
 
-void PVBaseInImpl::read(timespec* pTimestamp, std::vector<std::uint8_t>* pValue) const
+double PVBaseInImpl::getMaxPublishRate() const
 {
-    // TODO
-    // Epics calls this also for strings.
-    // If we arrive here maybe we really wanted to call the string function.
-    // This is as ugly as it can get: consider modifying this
-    std::string temporaryValue;
-    read(pTimestamp, &temporaryValue);
-    pValue->resize(temporaryValue.size());
-    ::memcpy(pValue->data(), temporaryValue.data(), temporaryValue.size());
+    const std::int64_t publishInterval(m_publishInterval.load());
+    return publishInterval == 0 ? 0 : 1e9 / (double)publishInterval;
 }
 
-void PVBaseInImpl::read(timespec* /* pTimestamp */, std::vector<std::int32_t>* /* pValue */) const
+void PVBaseInImpl::setMultiProducer(const bool bMultiProducer)
 {
-    throw;
+    m_bMultiProducer.store(bMultiProducer);
 }
 
-void PVBaseInImpl::read(timespec* /* pTimestamp */, std::vector<double>* /* pValue */) const
+bool PVBaseInImpl::isMultiProducer() const
 {
-    throw;
+    return m_bMultiProducer.load();
 }
 
-void PVBaseInImpl::read(timespec* /* pTimestamp */, std::string* /* pValue */) const
+void PVBaseInImpl::setDifferentialPush(const bool bDifferentialPush)
 {
-    throw;
+    std::lock_guard<std::mutex> lock(m_lockChanges);
+    m_changeDetector.reset();
+    m_bDifferentialPush.store(bDifferentialPush);
+}
+
+bool PVBaseInImpl::isDifferentialPush() const
+{
+    return m_bDifferentialPush.load();
+}
+
+/*
+ * The lock is held while the interface receives the changes: the next array
+ *  of the PV must be compared with this one only after it has been delivered
+ *
+ *****/
+template<typename E>
+bool PVBaseInImpl::pushChanges(InterfaceBaseImpl& interface, const timespec& timestamp, const E* pData, size_t count)
+{
+    if(!m_bDifferentialPush.load(std::memory_order_relaxed) || !interface.supportsChangedRanges())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lockChanges);
+    if(!m_changeDetector.update(pData, count, m_changedRanges))
+    {
+        return false;
+    }
+    interface.push(*this, timestamp, pData, count, m_changedRanges);
+    return true;
+}
+
+void PVBaseInImpl::setHistoryDepth(const size_t depth)
+{
+    m_bHistory.store(false);
+    m_history.reset(depth, getMaxElements(), getElementSize(getDataType()));
+    m_bHistory.store(depth != 0);
 }
 
+size_t PVBaseInImpl::getHistoryDepth() const
+{
+    return m_history.getDepth();
+}
 
 template<typename T>
-void PVBaseInImpl::push(const timespec& timestamp, const T& value)
+void PVBaseInImpl::getHistory(const timespec& from, const timespec& to, size_t maxValues, std::vector<timespec>* pTimestamps, std::vector<T>* pValues) const
 {
-    // Find the port then push the value
-    ////////////////////////////////////
-    std::shared_ptr<PortImpl> pPort(getPort());
-    if(--m_decimationCount == 0) // push can only happen from one thread. No sync needed
+    m_history.get(from, to, maxValues, pTimestamps, pValues);
+}
+
+void PVBaseInImpl::setArchive(const std::string& fileName, const size_t numFrames)
+{
+    std::lock_guard<std::mutex> lock(m_lockArchive);
+
+    ArchiveWriterImpl* pArchive(0);
+    if(numFrames != 0)
     {
-        m_decimationCount = m_decimationFactor;
-        pPort->push(std::static_pointer_cast<PVBaseImpl>(shared_from_this()), timestamp, value);
+        std::unique_ptr<ArchiveWriterImpl> pNewArchive(new ArchiveWriterImpl(fileName, getFullName(), getDataType(), numFrames, getMaxElements(), getElementSize(getDataType())));
+        m_archiveWriters.push_back(std::move(pNewArchive));
+        pArchive = m_archiveWriters.back().get();
     }
 
-    // Push the value to the outputs (subscription) and inputs (replication)
+    // A producer may still be recording into the previous archive: it is
+    //  released only with the PV, so the push path needs no reference count
     ////////////////////////////////////////////////////////////////////////
-    std::lock_guard<std::mutex> lock(m_lockSubscribersList);
+    m_pArchive.store(pArchive, std::memory_order_release);
+}
 
-    for(subscribersList_t::iterator scanOutputs(m_subscriberOutputPVs.begin()), endOutputs(m_subscriberOutputPVs.end());
-        scanOutputs != endOutputs;
-        ++scanOutputs)
+void PVBaseInImpl::setArchiveDirectory(const std::string& directory)
+{
+    std::lock_guard<std::mutex> lock(m_lockArchive);
+    m_archiveDirectory = directory;
+}
+
+template<typename T>
+void PVBaseInImpl::recordValue(const timespec& timestamp, const T& value)
+{
+    recordElements(timestamp, &value, 1);
+}
+
+template<typename E>
+void PVBaseInImpl::recordValue(const timespec& timestamp, const std::vector<E>& value)
+{
+    recordElements(timestamp, value.data(), value.size());
+}
+
+void PVBaseInImpl::recordValue(const timespec& timestamp, const std::string& value)
+{
+    recordElements(timestamp, value.data(), value.size());
+}
+
+void PVBaseInImpl::recordElements(const timespec& timestamp, const void* pData, size_t count)
+{
+    if(m_bHistory.load(std::memory_order_relaxed))
     {
-        (*scanOutputs)->write(timestamp, value);
+        m_history.record(timestamp, pData, count);
     }
+    ArchiveWriterImpl* pArchive(m_pArchive.load(std::memory_order_acquire));
+    if(pArchive != 0)
+    {
+        pArchive->record(timestamp, pData, count);
+    }
+}
 
-    for(destinationList_t::iterator scanInputs(m_replicationDestinationPVs.begin()), endInputs(m_replicationDestinationPVs.end());
-        scanInputs != endInputs;
-        ++scanInputs)
+template<typename T>
+parameters_t PVBaseInImpl::formatHistory(const timespec& from, const timespec& to, size_t maxValues) const
+{
+    std::vector<timespec> timestamps;
+    std::vector<T> values;
+    getHistory(from, to, maxValues, &timestamps, &values);
+
+    parameters_t history;
+    for(size_t scanValues(0); scanValues != values.size(); ++scanValues)
     {
-        (*scanInputs)->push(timestamp, value);
+        std::ostringstream formatValue;
+        formatValue << timestamps[scanValues].tv_sec << "." << std::setw(9) << std::setfill('0') << timestamps[scanValues].tv_nsec << std::setfill(' ');
+        formatValue.precision(std::numeric_limits<double>::max_digits10);
+        formatHistoryValue(formatValue, values[scanValues]);
+        history.push_back(formatValue.str());
     }
+    return history;
 }
 
-void PVBaseInImpl::subscribeReceiver(PVBaseOutImpl* pReceiver)
+void PVBaseInImpl::setPushPolicy(const pushPolicy_t pushPolicy)
 {
-    std::lock_guard<std::mutex> lock(m_lockSubscribersList);
-    m_subscriberOutputPVs.insert(pReceiver);
+    m_pushPolicy.store(pushPolicy);
 }
 
-void PVBaseInImpl::unsubscribeReceiver(PVBaseOutImpl* pReceiver)
+pushPolicy_t PVBaseInImpl::getPushPolicy() const
 {
-    std::lock_guard<std::mutex> lock(m_lockSubscribersList);
+    return m_pushPolicy.load();
+}
 
-    subscribersList_t::const_iterator findReceiver = m_subscriberOutputPVs.find(pReceiver);
-    if(findReceiver != m_subscriberOutputPVs.end())
-    {
-        m_subscriberOutputPVs.erase(findReceiver);
-    }
+std::uint64_t PVBaseInImpl::getEnqueuedCount() const
+{
+    return m_enqueuedCount.load();
 }
 
-void PVBaseInImpl::replicateTo(PVBaseInImpl *pDestination)
+std::uint64_t PVBaseInImpl::getDeliveredCount() const
 {
-    std::lock_guard<std::mutex> lock(m_lockSubscribersList);
-    m_replicationDestinationPVs.insert(pDestination);
+    return m_deliveredCount.load();
 }
 
-void PVBaseInImpl::stopReplicationTo(PVBaseInImpl* pDestination)
+std::uint64_t PVBaseInImpl::getDroppedCount() const
 {
-    std::lock_guard<std::mutex> lock(m_lockSubscribersList);
+    return m_droppedCount.load();
+}
+
+std::uint64_t PVBaseInImpl::getPushedCount() const
+{
+    return m_pushedCount.load();
+}
+
+std::uint64_t PVBaseInImpl::getDecimatedCount() const
+{
+    return m_decimatedCount.load();
+}
+
+std::uint64_t PVBaseInImpl::getFilteredCount() const
+{
+    return m_filteredCount.load();
+}
+
+std::uint64_t PVBaseInImpl::getConflatedCount() const
+{
+    return m_conflatedCount.load();
+}
+
+std::uint64_t PVBaseInImpl::getLinkSkippedCount() const
+{
+    return m_linkSkippedCount.load();
+}
+
+std::uint64_t PVBaseInImpl::getGapCount() const
+{
+    return m_gapCount.load();
+}
+
+std::uint64_t PVBaseInImpl::getLastDeliveredSequence() const
+{
+    return m_lastDeliveredSequence.load();
+}
+
+std::uint64_t PVBaseInImpl::countEnqueued()
+{
+    return m_enqueuedCount.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void PVBaseInImpl::countDelivered()
+{
+    m_deliveredCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PVBaseInImpl::countDropped()
+{
+    m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*
+ * Only a higher sequence number moves the last delivered one forward: the
+ *  numbers skipped meanwhile are gaps until they are delivered.
+ * Values pushed concurrently by a multi-producer PV may be delivered out
+ *  of order
+ *
+ *****/
+void PVBaseInImpl::startDelivery(const std::uint64_t sequence)
+{
+    if(sequence == 0)
+    {
+        return;
+    }
+
+    std::uint64_t lastSequence(m_lastDeliveredSequence.load(std::memory_order_relaxed));
+    while(sequence > lastSequence)
+    {
+        if(m_lastDeliveredSequence.compare_exchange_weak(lastSequence, sequence, std::memory_order_relaxed))
+        {
+            if(sequence != lastSequence + 1)
+            {
+                m_gapCount.fetch_add(sequence - lastSequence - 1, std::memory_order_relaxed);
+            }
+            return;
+        }
+    }
 
-    destinationList_t::const_iterator findDestination = m_replicationDestinationPVs.find(pDestination);
-    if(findDestination != m_replicationDestinationPVs.end())
+    // A late value fills a gap. The thread that moved the last delivered
+    //  sequence forward may not have counted the gap yet: the counter is
+    //  never decremented below zero
+    ////////////////////////////////////////////////////////////////////
+    std::uint64_t gapCount(m_gapCount.load(std::memory_order_relaxed));
+    while(gapCount != 0 && !m_gapCount.compare_exchange_weak(gapCount, gapCount - 1, std::memory_order_relaxed))
     {
-        m_replicationDestinationPVs.erase(findDestination);
     }
 }
 
+bool PVBaseInImpl::storeLatest(PushRecordImpl& record)
+{
+    std::lock_guard<std::mutex> lock(m_lockLatest);
 
-void PVBaseInImpl::setDecimation(const std::uint32_t decimation)
+    const bool bEmptySlot(m_latestRecord.getPV() == 0);
+    if(!bEmptySlot)
+    {
+        countDropped();
+    }
+    m_latestRecord = std::move(record);
+    record.clear();
+    return bEmptySlot;
+}
+
+bool PVBaseInImpl::takeLatest(PushRecordImpl& record)
 {
-    m_decimationFactor = decimation;
-    m_decimationCount = decimation;
+    std::lock_guard<std::mutex> lock(m_lockLatest);
+
+    if(m_latestRecord.getPV() == 0)
+    {
+        return false;
+    }
+    record = std::move(m_latestRecord);
+    m_latestRecord.clear();
+    return true;
 }
 
 
@@ -183,6 +1272,238 @@ parameters_t PVBaseInImpl::commandDecimation(const parameters_t &parameters)
     return parameters_t();
 }
 
+parameters_t PVBaseInImpl::commandAdaptiveDecimation(const parameters_t &parameters)
+{
+    std::uint32_t maxDecimation;
+    std::istringstream convertParameter(parameters[0]);
+    convertParameter >> maxDecimation;
+    setAdaptiveDecimation(maxDecimation);
+    return parameters_t();
+}
+
+parameters_t PVBaseInImpl::commandDecimationMode(const parameters_t &parameters)
+{
+    const std::string& modeName(parameters[0]);
+    if(modeName == "sample")
+    {
+        setDecimationMode(decimationMode_t::sample);
+    }
+    else if(modeName == "average")
+    {
+        setDecimationMode(decimationMode_t::average);
+    }
+    else if(modeName == "minimum")
+    {
+        setDecimationMode(decimationMode_t::minimum);
+    }
+    else if(modeName == "maximum")
+    {
+        setDecimationMode(decimationMode_t::maximum);
+    }
+    else if(modeName == "peakHold")
+    {
+        setDecimationMode(decimationMode_t::peakHold);
+    }
+    else
+    {
+        throw std::runtime_error("Unknown decimation mode: " + modeName);
+    }
+    return parameters_t();
+}
+
+parameters_t PVBaseInImpl::commandDeadband(const parameters_t &parameters)
+{
+    const std::string& typeName(parameters[0]);
+    double deadband;
+    std::istringstream convertParameter(parameters[1]);
+    convertParameter >> deadband;
+
+    if(typeName == "none")
+    {
+        setDeadband(deadbandType_t::none, deadband);
+    }
+    else if(typeName == "absolute")
+    {
+        setDeadband(deadbandType_t::absolute, deadband);
+    }
+    else if(typeName == "relative")
+    {
+        setDeadband(deadbandType_t::relative, deadband);
+    }
+    else
+    {
+        throw std::runtime_error("Unknown deadband type: " + typeName);
+    }
+    return parameters_t();
+}
+
+parameters_t PVBaseInImpl::commandDifferentialPush(const parameters_t &parameters)
+{
+    bool bDifferentialPush;
+    std::istringstream convertParameter(parameters[0]);
+    convertParameter >> bDifferentialPush;
+    setDifferentialPush(bDifferentialPush);
+    return parameters_t();
+}
+
+parameters_t PVBaseInImpl::commandMaxPublishRate(const parameters_t &parameters)
+{
+    double maxRate;
+    std::istringstream convertParameter(parameters[0]);
+    convertParameter >> maxRate;
+    setMaxPublishRate(maxRate);
+    return parameters_t();
+}
+
+parameters_t PVBaseInImpl::commandPushPolicy(const parameters_t &parameters)
+{
+    const std::string& policyName(parameters[0]);
+    if(policyName == "block")
+    {
+        setPushPolicy(pushPolicy_t::block);
+    }
+    else if(policyName == "dropOldest")
+    {
+        setPushPolicy(pushPolicy_t::dropOldest);
+    }
+    else if(policyName == "dropNewest")
+    {
+        setPushPolicy(pushPolicy_t::dropNewest);
+    }
+    else if(policyName == "keepLatest")
+    {
+        setPushPolicy(pushPolicy_t::keepLatest);
+    }
+    else if(policyName == "conflate")
+    {
+        setPushPolicy(pushPolicy_t::conflate);
+    }
+    else
+    {
+        throw std::runtime_error("Unknown push policy: " + policyName);
+    }
+    return parameters_t();
+}
+
+parameters_t PVBaseInImpl::commandPushStatistics(const parameters_t & /* parameters */)
+{
+    // Read enqueued last: the other counters are updated after it
+    /////////////////////////////////////////////////////////////
+    const std::uint64_t delivered(getDeliveredCount());
+    const std::uint64_t dropped(getDroppedCount());
+    const std::uint64_t enqueued(getEnqueuedCount());
+
+    parameters_t statistics;
+    statistics.push_back(std::to_string(enqueued));
+    statistics.push_back(std::to_string(delivered));
+    statistics.push_back(std::to_string(dropped));
+    return statistics;
+}
+
+parameters_t PVBaseInImpl::commandPushDiagnostics(const parameters_t & /* parameters */)
+{
+    // Follow the values from the producer to the control system
+    ////////////////////////////////////////////////////////////
+    parameters_t diagnostics;
+    diagnostics.push_back(std::to_string(getPushedCount()));
+    diagnostics.push_back(std::to_string(getDecimatedCount()));
+    diagnostics.push_back(std::to_string(getFilteredCount()));
+    diagnostics.push_back(std::to_string(getConflatedCount()));
+    diagnostics.push_back(std::to_string(getLinkSkippedCount()));
+    diagnostics.push_back(std::to_string(getEnqueuedCount()));
+    diagnostics.push_back(std::to_string(getDroppedCount()));
+    diagnostics.push_back(std::to_string(getDeliveredCount()));
+    diagnostics.push_back(std::to_string(getGapCount()));
+    return diagnostics;
+}
+
+parameters_t PVBaseInImpl::commandHistoryDepth(const parameters_t &parameters)
+{
+    size_t depth;
+    std::istringstream convertParameter(parameters[0]);
+    convertParameter >> depth;
+    if(convertParameter.fail())
+    {
+        throw std::runtime_error("Invalid history depth: " + parameters[0]);
+    }
+    setHistoryDepth(depth);
+    return parameters_t();
+}
+
+parameters_t PVBaseInImpl::commandHistory(const parameters_t &parameters)
+{
+    // Select the last values or a time range
+    /////////////////////////////////////////
+    timespec from = {0, 0};
+    timespec to = {std::numeric_limits<time_t>::max(), 0};
+    size_t maxValues(std::numeric_limits<size_t>::max());
+    if(parameters[0] == "last")
+    {
+        std::istringstream convertParameter(parameters[1]);
+        convertParameter >> maxValues;
+        if(convertParameter.fail())
+        {
+            throw std::runtime_error("Invalid number of values: " + parameters[1]);
+        }
+    }
+    else
+    {
+        from = secondsToTimestamp(parameters[0]);
+        to = secondsToTimestamp(parameters[1]);
+    }
+
+    switch(getDataType())
+    {
+    case dataType_t::dataInt32:
+        return formatHistory<std::int32_t>(from, to, maxValues);
+    case dataType_t::dataFloat64:
+        return formatHistory<double>(from, to, maxValues);
+    case dataType_t::dataInt8Array:
+        return formatHistory<std::vector<std::int8_t> >(from, to, maxValues);
+    case dataType_t::dataUint8Array:
+        return formatHistory<std::vector<std::uint8_t> >(from, to, maxValues);
+    case dataType_t::dataInt32Array:
+        return formatHistory<std::vector<std::int32_t> >(from, to, maxValues);
+    case dataType_t::dataFloat64Array:
+        return formatHistory<std::vector<double> >(from, to, maxValues);
+    case dataType_t::dataString:
+        return formatHistory<std::string>(from, to, maxValues);
+    }
+    return parameters_t();
+}
+
+parameters_t PVBaseInImpl::commandArchive(const parameters_t &parameters)
+{
+    size_t numFrames;
+    std::istringstream convertParameter(parameters[1]);
+    convertParameter >> numFrames;
+    if(convertParameter.fail())
+    {
+        throw std::runtime_error("Invalid number of frames: " + parameters[1]);
+    }
+
+    // The control system can only name a file in the directory selected by
+    //  the device
+    ///////////////////////////////////////////////////////////////////////
+    const std::string& fileName(parameters[0]);
+    if(fileName.empty() || fileName.find('/') != std::string::npos || fileName.find("..") != std::string::npos)
+    {
+        throw std::runtime_error("Invalid archive file name: " + fileName);
+    }
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(m_lockArchive);
+        directory = m_archiveDirectory;
+    }
+    if(directory.empty())
+    {
+        throw std::runtime_error("The command archive is not enabled for the PV " + getFullName());
+    }
+
+    setArchive(directory + "/" + fileName, numFrames);
+    return parameters_t();
+}
+
 
 std::string PVBaseInImpl::buildFullExternalName(const FactoryBaseImpl& controlSystem) const
 {
@@ -237,6 +1558,14 @@ std::string PVBaseInImpl::buildFullExternalName(const FactoryBaseImpl& controlSy
 }
 
 
+template void PVBaseInImpl::getHistory<std::int32_t>(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::int32_t>*) const;
+template void PVBaseInImpl::getHistory<double>(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<double>*) const;
+template void PVBaseInImpl::getHistory<std::vector<std::int8_t> >(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::vector<std::int8_t> >*) const;
+template void PVBaseInImpl::getHistory<std::vector<std::uint8_t> >(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::vector<std::uint8_t> >*) const;
+template void PVBaseInImpl::getHistory<std::vector<std::int32_t> >(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::vector<std::int32_t> >*) const;
+template void PVBaseInImpl::getHistory<std::vector<double> >(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::vector<double> >*) const;
+template void PVBaseInImpl::getHistory<std::string>(const timespec&, const timespec&, size_t, std::vector<timespec>*, std::vector<std::string>*) const;
+
 template void PVBaseInImpl::push<std::int32_t>(const timespec&, const std::int32_t&);
 template void PVBaseInImpl::push<double>(const timespec&, const double&);
 template void PVBaseInImpl::push<std::vector<std::int8_t> >(const timespec&, const std::vector<std::int8_t>&);
@@ -245,5 +1574,23 @@ template void PVBaseInImpl::push<std::vector<std::int32_t> >(const timespec&, co
 template void PVBaseInImpl::push<std::vector<double> >(const timespec&, const std::vector<double>&);
 template void PVBaseInImpl::push<std::string >(const timespec&, const std::string&);
 
-}
 
+template void PVBaseInImpl::push<std::int32_t>(const timespec&, const std::shared_ptr<const std::int32_t>&);
+template void PVBaseInImpl::push<double>(const timespec&, const std::shared_ptr<const double>&);
+template void PVBaseInImpl::push<std::vector<std::int8_t> >(const timespec&, const std::shared_ptr<const std::vector<std::int8_t> >&);
+template void PVBaseInImpl::push<std::vector<std::uint8_t> >(const timespec&, const std::shared_ptr<const std::vector<std::uint8_t> >&);
+template void PVBaseInImpl::push<std::vector<std::int32_t> >(const timespec&, const std::shared_ptr<const std::vector<std::int32_t> >&);
+template void PVBaseInImpl::push<std::vector<double> >(const timespec&, const std::shared_ptr<const std::vector<double> >&);
+template void PVBaseInImpl::push<std::string >(const timespec&, const std::shared_ptr<const std::string>&);
+
+template void PVBaseInImpl::push<std::int8_t>(const timespec&, const std::int8_t*, size_t);
+template void PVBaseInImpl::push<std::uint8_t>(const timespec&, const std::uint8_t*, size_t);
+template void PVBaseInImpl::push<std::int32_t>(const timespec&, const std::int32_t*, size_t);
+template void PVBaseInImpl::push<double>(const timespec&, const double*, size_t);
+
+template bool PVBaseInImpl::pushChanges<std::int8_t>(InterfaceBaseImpl&, const timespec&, const std::int8_t*, size_t);
+template bool PVBaseInImpl::pushChanges<std::uint8_t>(InterfaceBaseImpl&, const timespec&, const std::uint8_t*, size_t);
+template bool PVBaseInImpl::pushChanges<std::int32_t>(InterfaceBaseImpl&, const timespec&, const std::int32_t*, size_t);
+template bool PVBaseInImpl::pushChanges<double>(InterfaceBaseImpl&, const timespec&, const double*, size_t);
+
+}
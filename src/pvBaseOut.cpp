@@ -23,7 +23,12 @@ PVBaseOut::PVBaseOut(std::shared_ptr<PVBaseOutImpl> pvImpl): PVBase(std::static_
 
 void PVBaseOut::subscribeTo(const std::string &inputPVName)
 {
-    std::static_pointer_cast<PVBaseOutImpl>(m_pImplementation)->subscribeTo(inputPVName);
+    std::static_pointer_cast<PVBaseOutImpl>(m_pImplementation)->subscribeTo(inputPVName, 1, 0);
+}
+
+void PVBaseOut::subscribeTo(const std::string &inputPVName, const std::uint32_t decimation, const double maxRate)
+{
+    std::static_pointer_cast<PVBaseOutImpl>(m_pImplementation)->subscribeTo(inputPVName, decimation, maxRate);
 }
 
 template<typename T>
@@ -34,9 +34,9 @@ void PVBaseOutImpl::deinitialize()
     PVBaseImpl::deinitialize();
 }
 
-void PVBaseOutImpl::subscribeTo(const std::string &inputPVName)
+void PVBaseOutImpl::subscribeTo(const std::string &inputPVName, const std::uint32_t decimation, const double maxRate)
 {
-    NdsFactoryImpl::getInstance().subscribe(inputPVName, this);
+    NdsFactoryImpl::getInstance().subscribe(inputPVName, this, decimation, maxRate);
 }
 
 
@@ -130,6 +130,41 @@ void PVBaseOutImpl::write(const timespec& /* pTimestamp */, const std::string& /
     throw;
 }
 
+void PVBaseOutImpl::write(const timespec& timestamp, const std::shared_ptr<const std::int32_t>& pValue)
+{
+    write(timestamp, *pValue);
+}
+
+void PVBaseOutImpl::write(const timespec& timestamp, const std::shared_ptr<const double>& pValue)
+{
+    write(timestamp, *pValue);
+}
+
+void PVBaseOutImpl::write(const timespec& timestamp, const std::shared_ptr<const std::vector<std::int8_t> >& pValue)
+{
+    write(timestamp, *pValue);
+}
+
+void PVBaseOutImpl::write(const timespec& timestamp, const std::shared_ptr<const std::vector<std::uint8_t> >& pValue)
+{
+    write(timestamp, *pValue);
+}
+
+void PVBaseOutImpl::write(const timespec& timestamp, const std::shared_ptr<const std::vector<std::int32_t> >& pValue)
+{
+    write(timestamp, *pValue);
+}
+
+void PVBaseOutImpl::write(const timespec& timestamp, const std::shared_ptr<const std::vector<double> >& pValue)
+{
+    write(timestamp, *pValue);
+}
+
+void PVBaseOutImpl::write(const timespec& timestamp, const std::shared_ptr<const std::string>& pValue)
+{
+    write(timestamp, *pValue);
+}
+
 dataDirection_t PVBaseOutImpl::getDataDirection() const
 {
     return dataDirection_t::output;
@@ -59,6 +59,39 @@ void PVVariableIn<T>::setValue(const timespec& timestamp, const T& value)
 }
 
 
+/*
+ * Move a value into the PV
+ *
+ **************************/
+template <typename T>
+void PVVariableIn<T>::setValue(T&& value)
+{
+    return std::static_pointer_cast<PVVariableInImpl<T> >(m_pImplementation)->setValue(std::move(value));
+}
+
+
+/*
+ * Move a value into the PV and store its timestamp
+ *
+ **************************************************/
+template <typename T>
+void PVVariableIn<T>::setValue(const timespec& timestamp, T&& value)
+{
+    return std::static_pointer_cast<PVVariableInImpl<T> >(m_pImplementation)->setValue(timestamp, std::move(value));
+}
+
+
+/*
+ * Return a view of the stored value
+ *
+ ***********************************/
+template <typename T>
+std::shared_ptr<const T> PVVariableIn<T>::getSnapshot(timespec* pTimestamp) const
+{
+    return std::static_pointer_cast<PVVariableInImpl<T> >(m_pImplementation)->getSnapshot(pTimestamp);
+}
+
+
 // Instantiate all the needed data types
 ////////////////////////////////////////
 template class PVVariableIn<std::int32_t>;
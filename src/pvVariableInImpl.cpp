@@ -7,6 +7,9 @@
  * file included in the distribution.
  */
 
+#include <atomic>
+#include <type_traits>
+#include <utility>
 #include "nds3/impl/pvVariableInImpl.h"
 #include "nds3/impl/pvBaseOutImpl.h"
 
@@ -18,10 +21,12 @@ namespace nds
  *
  *************/
 template <typename T>
-PVVariableInImpl<T>::PVVariableInImpl(const std::string& name, const inputPvType_t pvType): PVBaseInImpl(name, pvType), m_value()
+PVVariableInImpl<T>::PVVariableInImpl(const std::string& name, const inputPvType_t pvType): PVBaseInImpl(name, pvType)
 {
-    m_timestamp.tv_sec = 0;
-    m_timestamp.tv_nsec = 0;
+    std::shared_ptr<snapshot_t> pSnapshot(std::make_shared<snapshot_t>());
+    pSnapshot->m_timestamp.tv_sec = 0;
+    pSnapshot->m_timestamp.tv_nsec = 0;
+    m_pSnapshot = pSnapshot;
 
 }
 
@@ -33,9 +38,103 @@ PVVariableInImpl<T>::PVVariableInImpl(const std::string& name, const inputPvType
 template <typename T>
 void PVVariableInImpl<T>::read(timespec* pTimestamp, T* pValue) const
 {
-    std::unique_lock<std::mutex> lock(m_pvMutex);
-    *pValue = m_value;
-    *pTimestamp = m_timestamp;
+    const std::shared_ptr<const snapshot_t> pSnapshot(std::atomic_load(&m_pSnapshot));
+    *pValue = pSnapshot->m_value;
+    *pTimestamp = pSnapshot->m_timestamp;
+}
+
+
+/*
+ * Called by the control system to copy the stored value into its buffer
+ *
+ ************************************************************************/
+template <typename T>
+size_t PVVariableInImpl<T>::read(timespec* pTimestamp, typename bufferElement_t<T>::type* pBuffer, size_t capacity) const
+{
+    // Scalars are stored in the seqlock
+    ////////////////////////////////////
+    if(std::is_scalar<T>::value)
+    {
+        T value;
+        read(pTimestamp, &value);
+        return copyToBuffer(value, pBuffer, capacity);
+    }
+
+    const std::shared_ptr<const snapshot_t> pSnapshot(std::atomic_load(&m_pSnapshot));
+    *pTimestamp = pSnapshot->m_timestamp;
+    return copyToBuffer(pSnapshot->m_value, pBuffer, capacity);
+}
+
+
+/*
+ * Return a view of the stored value
+ *
+ ***********************************/
+template <typename T>
+std::shared_ptr<const T> PVVariableInImpl<T>::getSnapshot(timespec* pTimestamp) const
+{
+    // Scalars are stored in the seqlock
+    ////////////////////////////////////
+    if(std::is_scalar<T>::value)
+    {
+        std::shared_ptr<T> pValue(std::make_shared<T>());
+        read(pTimestamp, pValue.get());
+        return pValue;
+    }
+
+    const std::shared_ptr<const snapshot_t> pSnapshot(std::atomic_load(&m_pSnapshot));
+    *pTimestamp = pSnapshot->m_timestamp;
+    return std::shared_ptr<const T>(pSnapshot, &pSnapshot->m_value);
+}
+
+
+/*
+ * Return the spare snapshot or allocate a new one
+ *
+ *************************************************/
+template <typename T>
+std::shared_ptr<typename PVVariableInImpl<T>::snapshot_t> PVVariableInImpl<T>::takeSpareSnapshot()
+{
+    std::shared_ptr<snapshot_t> pSnapshot(std::atomic_exchange(&m_pSpareSnapshot, std::shared_ptr<snapshot_t>()));
+    if(pSnapshot == 0)
+    {
+        pSnapshot = std::make_shared<snapshot_t>();
+    }
+    return pSnapshot;
+}
+
+
+/*
+ * Publish a snapshot. Nobody can take a new reference to the replaced
+ *  snapshot: if we hold the only one then it can be filled again
+ *
+ *********************************************************************/
+template <typename T>
+void PVVariableInImpl<T>::publishSnapshot(const std::shared_ptr<snapshot_t>& pSnapshot)
+{
+    std::shared_ptr<const snapshot_t> pPreviousSnapshot(std::atomic_exchange(&m_pSnapshot, std::shared_ptr<const snapshot_t>(pSnapshot)));
+    if(pPreviousSnapshot.use_count() == 1)
+    {
+        // Synchronize with the readers that released the snapshot
+        ///////////////////////////////////////////////////////////
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::atomic_store(&m_pSpareSnapshot, std::const_pointer_cast<snapshot_t>(pPreviousSnapshot));
+    }
+}
+
+
+/*
+ * Store a new value without pushing it to the subscribers
+ *
+ *********************************************************/
+template <typename T>
+std::shared_ptr<const typename PVVariableInImpl<T>::snapshot_t> PVVariableInImpl<T>::storeValue(const timespec& timestamp, const T& value)
+{
+    std::shared_ptr<snapshot_t> pSnapshot(takeSpareSnapshot());
+    pSnapshot->m_timestamp = timestamp;
+    pSnapshot->m_value = value;
+    publishSnapshot(pSnapshot);
+    return pSnapshot;
 }
 
 
@@ -46,22 +145,82 @@ void PVVariableInImpl<T>::read(timespec* pTimestamp, T* pValue) const
 template <typename T>
 void PVVariableInImpl<T>::setValue(const timespec& timestamp, const T& value)
 {
-    {
-        // Store the value
-        //////////////////
-        std::unique_lock<std::mutex> lock(m_pvMutex);
-        m_value =value;
-        m_timestamp = timestamp;
-    }
+    const std::shared_ptr<const snapshot_t> pSnapshot(storeValue(timestamp, value));
 
     // Push the value to the outputs
     ////////////////////////////////
-    std::lock_guard<std::mutex> lock(m_lockSubscribersList);
-    for(subscribersList_t::iterator scanOutputs(m_subscriberOutputPVs.begin()), endOutputs(m_subscriberOutputPVs.end());
+    const std::shared_ptr<const receivers_t> pReceivers(getReceivers());
+    if(pReceivers == 0)
+    {
+        return;
+    }
+
+    // The subscribers share the published snapshot. Scalars are stored in
+    //  the seqlock and copied
+    ///////////////////////////////////////////////////////////////////////
+    std::shared_ptr<const T> pValue;
+    if(pSnapshot != 0)
+    {
+        pValue = std::shared_ptr<const T>(pSnapshot, &pSnapshot->m_value);
+    }
+    ReceiversDeliveryScope deliveryScope;
+    for(subscribersList_t::const_iterator scanOutputs(pReceivers->m_subscriberOutputPVs.begin()), endOutputs(pReceivers->m_subscriberOutputPVs.end());
+        scanOutputs != endOutputs;
+        ++scanOutputs)
+    {
+        if(passLink(scanOutputs->second))
+        {
+            if(pValue != 0)
+            {
+                scanOutputs->first->write(timestamp, pValue);
+            }
+            else
+            {
+                scanOutputs->first->write(timestamp, value);
+            }
+        }
+    }
+}
+
+
+/*
+ * Move a new value and its timestamp into the PV
+ *
+ ************************************************/
+template <typename T>
+void PVVariableInImpl<T>::setValue(const timespec& timestamp, T&& value)
+{
+    // Scalars are cheaper to copy than to share
+    ////////////////////////////////////////////
+    if(std::is_scalar<T>::value)
+    {
+        setValue(timestamp, static_cast<const T&>(value));
+        return;
+    }
+
+    std::shared_ptr<snapshot_t> pSnapshot(takeSpareSnapshot());
+    pSnapshot->m_timestamp = timestamp;
+    pSnapshot->m_value = std::move(value);
+    publishSnapshot(pSnapshot);
+
+    const std::shared_ptr<const receivers_t> pReceivers(getReceivers());
+    if(pReceivers == 0)
+    {
+        return;
+    }
+
+    // The subscribers share the published snapshot
+    ///////////////////////////////////////////////
+    const std::shared_ptr<const T> pValue(pSnapshot, &pSnapshot->m_value);
+    ReceiversDeliveryScope deliveryScope;
+    for(subscribersList_t::const_iterator scanOutputs(pReceivers->m_subscriberOutputPVs.begin()), endOutputs(pReceivers->m_subscriberOutputPVs.end());
         scanOutputs != endOutputs;
         ++scanOutputs)
     {
-        (*scanOutputs)->write(timestamp, value);
+        if(passLink(scanOutputs->second))
+        {
+            scanOutputs->first->write(timestamp, pValue);
+        }
     }
 }
 
@@ -77,6 +236,17 @@ void PVVariableInImpl<T>::setValue(const T& value)
 }
 
 
+/*
+ * Move a new value into the PV
+ *
+ ******************************/
+template <typename T>
+void PVVariableInImpl<T>::setValue(T&& value)
+{
+    setValue(getTimestamp(), std::move(value));
+}
+
+
 /*
  * Return the PV's data type
  *
@@ -88,6 +258,38 @@ dataType_t PVVariableInImpl<T>::getDataType() const
 }
 
 
+/*
+ * The scalar values are exchanged through a seqlock: the control system
+ *  reads never block the thread that sets the value
+ *
+ ***********************************************************************/
+template<>
+void PVVariableInImpl<std::int32_t>::read(timespec* pTimestamp, std::int32_t* pValue) const
+{
+    m_scalarValue.load(pTimestamp, pValue);
+}
+
+template<>
+void PVVariableInImpl<double>::read(timespec* pTimestamp, double* pValue) const
+{
+    m_scalarValue.load(pTimestamp, pValue);
+}
+
+template<>
+std::shared_ptr<const PVVariableInImpl<std::int32_t>::snapshot_t> PVVariableInImpl<std::int32_t>::storeValue(const timespec& timestamp, const std::int32_t& value)
+{
+    m_scalarValue.store(timestamp, value);
+    return std::shared_ptr<const snapshot_t>();
+}
+
+template<>
+std::shared_ptr<const PVVariableInImpl<double>::snapshot_t> PVVariableInImpl<double>::storeValue(const timespec& timestamp, const double& value)
+{
+    m_scalarValue.store(timestamp, value);
+    return std::shared_ptr<const snapshot_t>();
+}
+
+
 // Instantiate all the needed data types
 ////////////////////////////////////////
 template class PVVariableInImpl<std::int32_t>;
@@ -58,6 +58,17 @@ void PVVariableOut<T>::getValue(timespec* pTime, T* pValue) const
     std::static_pointer_cast<PVVariableOutImpl<T> >(m_pImplementation)->getValue(pTime, pValue);
 }
 
+
+/*
+ * Return a view of the value stored in the PV
+ *
+ *********************************************/
+template <typename T>
+std::shared_ptr<const T> PVVariableOut<T>::getSnapshot(timespec* pTime) const
+{
+    return std::static_pointer_cast<PVVariableOutImpl<T> >(m_pImplementation)->getSnapshot(pTime);
+}
+
 // Instantiate all the needed data types
 ////////////////////////////////////////
 template class PVVariableOut<std::int32_t>;
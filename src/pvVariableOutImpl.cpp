@@ -7,6 +7,9 @@
  * file included in the distribution.
  */
 
+#include <atomic>
+#include <type_traits>
+#include <utility>
 #include "nds3/impl/pvVariableOutImpl.h"
 
 namespace nds
@@ -17,11 +20,18 @@ namespace nds
  *
  *************/
 template <typename T>
-PVVariableOutImpl<T>::PVVariableOutImpl(const std::string& name, const outputPvType_t pvType): PVBaseOutImpl(name, pvType), m_value()
+PVVariableOutImpl<T>::PVVariableOutImpl(const std::string& name, const outputPvType_t pvType): PVBaseOutImpl(name, pvType),
+    m_bOwnValue(true)
 {
     m_timestamp.tv_sec = 0;
     m_timestamp.tv_nsec = 0;
 
+    // Scalars are stored in the seqlock and never use the buffer
+    /////////////////////////////////////////////////////////////
+    if(!std::is_scalar<T>::value)
+    {
+        m_pValue = std::make_shared<T>();
+    }
 }
 
 
@@ -32,9 +42,29 @@ PVVariableOutImpl<T>::PVVariableOutImpl(const std::string& name, const outputPvT
 template <typename T>
 void PVVariableOutImpl<T>::read(timespec* pTimestamp, T* pValue) const
 {
-    std::unique_lock<std::mutex> lock(m_pvMutex);
-    *pValue = m_value;
-    *pTimestamp = m_timestamp;
+    getValue(pTimestamp, pValue);
+}
+
+
+/*
+ * Called when the control system wants to copy the stored value into its
+ *  buffer
+ *
+ ************************************************************************/
+template <typename T>
+size_t PVVariableOutImpl<T>::read(timespec* pTimestamp, typename bufferElement_t<T>::type* pBuffer, size_t capacity) const
+{
+    // Scalars are stored in the seqlock
+    ////////////////////////////////////
+    if(std::is_scalar<T>::value)
+    {
+        T value;
+        getValue(pTimestamp, &value);
+        return copyToBuffer(value, pBuffer, capacity);
+    }
+
+    const std::shared_ptr<const T> pValue(getSnapshot(pTimestamp));
+    return copyToBuffer(*pValue, pBuffer, capacity);
 }
 
 
@@ -45,9 +75,92 @@ void PVVariableOutImpl<T>::read(timespec* pTimestamp, T* pValue) const
 template <typename T>
 void PVVariableOutImpl<T>::write(const timespec& timestamp, const T& value)
 {
+    std::shared_ptr<T> pValue(takeSpareValue());
+    *pValue = value;
+    publishValue(timestamp, pValue, true);
+}
+
+
+/*
+ * Move a value into the PV
+ *
+ **************************/
+template <typename T>
+void PVVariableOutImpl<T>::write(const timespec& timestamp, T&& value)
+{
+    // Scalars are stored without the mutex
+    ///////////////////////////////////////
+    if(std::is_scalar<T>::value)
+    {
+        write(timestamp, static_cast<const T&>(value));
+        return;
+    }
+
+    std::shared_ptr<T> pValue(takeSpareValue());
+    *pValue = std::move(value);
+    publishValue(timestamp, pValue, true);
+}
+
+
+/*
+ * Called when a subscribed input PV pushes a shared value
+ *
+ *********************************************************/
+template <typename T>
+void PVVariableOutImpl<T>::write(const timespec& timestamp, const std::shared_ptr<const T>& pValue)
+{
+    if(std::is_scalar<T>::value)
+    {
+        write(timestamp, *pValue);
+        return;
+    }
+
+    publishValue(timestamp, pValue, false);
+}
+
+
+/*
+ * Return the spare buffer or allocate a new one
+ *
+ ***********************************************/
+template <typename T>
+std::shared_ptr<T> PVVariableOutImpl<T>::takeSpareValue()
+{
+    std::shared_ptr<T> pValue;
+    {
+        std::unique_lock<std::mutex> lock(m_pvMutex);
+        pValue.swap(m_pSpareValue);
+    }
+    if(pValue == 0)
+    {
+        pValue = std::make_shared<T>();
+    }
+    return pValue;
+}
+
+
+/*
+ * Replace the stored buffer. The readers take their references while
+ *  holding the mutex: once replaced, a buffer referenced only by us can be
+ *  filled again
+ *
+ *************************************************************************/
+template <typename T>
+void PVVariableOutImpl<T>::publishValue(const timespec& timestamp, const std::shared_ptr<const T>& pValue, bool bOwnValue)
+{
+    std::shared_ptr<const T> pPreviousValue(pValue);
+
     std::unique_lock<std::mutex> lock(m_pvMutex);
-    m_value =value;
+    m_pValue.swap(pPreviousValue);
     m_timestamp = timestamp;
+    if(m_bOwnValue && pPreviousValue.use_count() == 1)
+    {
+        // Synchronize with the readers that released the buffer
+        ////////////////////////////////////////////////////////
+        std::atomic_thread_fence(std::memory_order_acquire);
+        m_pSpareValue = std::const_pointer_cast<T>(pPreviousValue);
+    }
+    m_bOwnValue = bOwnValue;
 }
 
 
@@ -69,21 +182,75 @@ dataType_t PVVariableOutImpl<T>::getDataType() const
 template <typename T>
 T PVVariableOutImpl<T>::getValue() const
 {
-    std::unique_lock<std::mutex> lock(m_pvMutex);
-    return m_value;
+    timespec timestamp;
+    T value;
+    getValue(&timestamp, &value);
+    return value;
 }
 
 
 /*
- * Return the value and timestamp stored in the PV
+ * Return the value and timestamp stored in the PV.
+ * The scalars are read from the seqlock by the specializations below
  *
- *************************************************/
+ *********************************************************************/
 template <typename T>
 void PVVariableOutImpl<T>::getValue(timespec* pTime, T* pValue) const
 {
+    *pValue = *getSnapshot(pTime);
+}
+
+
+/*
+ * Return a view of the value stored in the PV
+ *
+ *********************************************/
+template <typename T>
+std::shared_ptr<const T> PVVariableOutImpl<T>::getSnapshot(timespec* pTime) const
+{
+    // Scalars are stored in the seqlock: the view is a copy.
+    // getValue() and read() don't need it and don't allocate
+    //////////////////////////////////////////////////////////
+    if(std::is_scalar<T>::value)
+    {
+        std::shared_ptr<T> pValue(std::make_shared<T>());
+        getValue(pTime, pValue.get());
+        return pValue;
+    }
+
     std::unique_lock<std::mutex> lock(m_pvMutex);
-    *pValue = m_value;
     *pTime = m_timestamp;
+    return m_pValue;
+}
+
+
+/*
+ * The scalar PVs are polled by the acquisition loops: they are stored in a
+ *  seqlock so the readers never block the control system writes
+ *
+ **************************************************************************/
+template<>
+void PVVariableOutImpl<std::int32_t>::write(const timespec& timestamp, const std::int32_t& value)
+{
+    m_scalarValue.store(timestamp, value);
+}
+
+template<>
+void PVVariableOutImpl<double>::write(const timespec& timestamp, const double& value)
+{
+    m_scalarValue.store(timestamp, value);
+}
+
+template<>
+void PVVariableOutImpl<std::int32_t>::getValue(timespec* pTime, std::int32_t* pValue) const
+{
+    m_scalarValue.load(pTime, pValue);
+}
+
+template<>
+void PVVariableOutImpl<double>::getValue(timespec* pTime, double* pValue) const
+{
+    m_scalarValue.load(pTime, pValue);
 }
 
 
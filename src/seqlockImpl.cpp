@@ -0,0 +1,83 @@
+/*
+ * Nominal Device Support v3 (NDS3)
+ *
+ * Copyright (c) 2015 Cosylab d.d.
+ *
+ * For more information about the license please refer to the license.txt
+ * file included in the distribution.
+ */
+
+#include <cstring>
+#include "nds3/impl/seqlockImpl.h"
+
+namespace nds
+{
+
+SeqlockImpl::SeqlockImpl(): m_sequence(0), m_value(0), m_seconds(0), m_nanoseconds(0)
+{
+}
+
+/*
+ * A writer owns the value while the sequence is odd. The data is stored
+ *  with relaxed atomics: the fences order it with the sequence numbers
+ *
+ *****/
+template<typename T>
+void SeqlockImpl::store(const timespec& timestamp, const T value)
+{
+    static_assert(sizeof(T) <= sizeof(std::uint64_t), "The value must fit in 64 bits");
+
+    std::uint64_t bits(0);
+    std::memcpy(&bits, &value, sizeof(T));
+
+    // Wait for the other writers by moving the sequence from even to odd
+    /////////////////////////////////////////////////////////////////////
+    std::uint32_t sequence(m_sequence.load(std::memory_order_relaxed) & ~1u);
+    while(!m_sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+        sequence &= ~1u;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_value.store(bits, std::memory_order_relaxed);
+    m_seconds.store((std::int64_t)timestamp.tv_sec, std::memory_order_relaxed);
+    m_nanoseconds.store((std::int64_t)timestamp.tv_nsec, std::memory_order_relaxed);
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+template<typename T>
+void SeqlockImpl::load(timespec* pTimestamp, T* pValue) const
+{
+    std::uint64_t bits;
+    std::int64_t seconds;
+    std::int64_t nanoseconds;
+
+    // Copy again if a writer was active or stored a value meanwhile
+    ////////////////////////////////////////////////////////////////
+    for(;;)
+    {
+        const std::uint32_t sequence(m_sequence.load(std::memory_order_acquire));
+        bits = m_value.load(std::memory_order_relaxed);
+        seconds = m_seconds.load(std::memory_order_relaxed);
+        nanoseconds = m_nanoseconds.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if((sequence & 1) == 0 && m_sequence.load(std::memory_order_relaxed) == sequence)
+        {
+            break;
+        }
+    }
+
+    std::memcpy(pValue, &bits, sizeof(T));
+    pTimestamp->tv_sec = (time_t)seconds;
+    pTimestamp->tv_nsec = (long)nanoseconds;
+}
+
+template void SeqlockImpl::store<std::int32_t>(const timespec&, const std::int32_t);
+template void SeqlockImpl::store<double>(const timespec&, const double);
+
+template void SeqlockImpl::load<std::int32_t>(timespec*, std::int32_t*) const;
+template void SeqlockImpl::load<double>(timespec*, double*) const;
+
+}
@@ -69,6 +69,7 @@ StateMachineImpl::StateMachineImpl(bool bAsync,
     m_pGetStatePV->setScanType(scanType_t::interrupt, 0);
     m_pGetStatePV->setEnumeration(enumerationStrings);
     m_pGetStatePV->processAtInit(true);
+    m_pGetStatePV->setPushPolicy(pushPolicy_t::block); // Every state transition must reach the control system
     addChild(m_pGetStatePV);
 
     std::shared_ptr<PVDelegateInImpl<std::int32_t> > pGetGlobalStatePV(
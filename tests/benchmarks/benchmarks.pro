@@ -0,0 +1,26 @@
+TEMPLATE = app
+CONFIG += console
+CONFIG -= qt
+
+TARGET = nds3benchmarks
+
+QMAKE_CXXFLAGS += -std=c++0x -Wall -Wextra -pedantic -pthread -O2
+
+DEFINES += NDS3_DLL
+DEFINES += NDS3_DLL_IMPORT
+
+INCLUDEPATH += ../include
+
+LIBS +=  -lnds3 -lpthread
+
+SOURCES += \
+    src/pushRate.cpp \
+    ../src/testDevice.cpp \
+    ../src/ndsTestInterface.cpp \
+    ../src/ndsTestFactory.cpp
+
+
+HEADERS += \
+    ../include/testDevice.h \
+    ../include/ndsTestInterface.h \
+    ../include/ndsTestFactory.h
@@ -0,0 +1,70 @@
+/*
+ * Measures the number of values per second that a PV can push.
+ *
+ * Not a unit test: the results depend on the machine and on its load, so
+ *  the benchmark is built separately from the tests and is run manually,
+ *  with an optimized build of the library.
+ */
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <nds3/nds.h>
+#include "testDevice.h"
+#include "ndsTestFactory.h"
+
+namespace
+{
+
+/*
+ * Push numPushes values and return the number of pushes per second
+ *
+ *****/
+double measurePushRate(nds::PVBaseIn& pv, const std::int32_t numPushes)
+{
+    timespec timestamp = {0, 0};
+
+    std::chrono::steady_clock::time_point startTime(std::chrono::steady_clock::now());
+    for(std::int32_t pushValue(0); pushValue != numPushes; ++pushValue)
+    {
+        pv.push(timestamp, pushValue);
+    }
+    std::chrono::duration<double> elapsed(std::chrono::steady_clock::now() - startTime);
+
+    return (double)numPushes / elapsed.count();
+}
+
+}
+
+int main()
+{
+    nds::Factory::registerDriver("testDevice",
+                           std::bind(&TestDevice::allocateDevice, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+                           std::bind(&TestDevice::deallocateDevice, std::placeholders::_1));
+
+    nds::Factory testControlSystem(std::shared_ptr<nds::FactoryBaseImpl>(new nds::tests::TestControlSystemFactoryImpl()));
+    nds::Factory::registerControlSystem(testControlSystem);
+
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+
+    // With decimation 0 the value never reaches the control system: this
+    //  measures the cost of the push path inside NDS
+    /////////////////////////////////////////////////////////////////////
+    pDevice->m_variableIn0.setDecimation(0);
+    measurePushRate(pDevice->m_variableIn0, 100000); // Warm up
+    double pvRate(measurePushRate(pDevice->m_variableIn0, 10000000));
+    std::cout << "Push path without delivery:       " << (std::uint64_t)pvRate << " pushes/s" << std::endl;
+
+    // Full push, including the test control system
+    ///////////////////////////////////////////////
+    pDevice->m_variableIn0.setDecimation(1);
+    double deliveredRate(measurePushRate(pDevice->m_variableIn0, 1000000));
+    std::cout << "Push delivered to the test system: " << (std::uint64_t)deliveredRate << " pushes/s" << std::endl;
+
+    factory.destroyDevice("rootNode");
+
+    return 0;
+}
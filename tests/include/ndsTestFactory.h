@@ -32,7 +32,7 @@ public:
 
     size_t getRegisteredCommandsNumber();
 
-    void executeCommand(const std::string& command, const std::string& node, nds::parameters_t& parameters);
+    nds::parameters_t executeCommand(const std::string& command, const std::string& node, nds::parameters_t& parameters);
 
     virtual const std::string& getDefaultSeparator(const uint32_t nodeLevel) const;
 
@@ -4,6 +4,7 @@
 #include <nds3/impl/interfaceBaseImpl.h>
 #include <nds3/definitions.h>
 #include <vector>
+#include <unistd.h>
 
 namespace nds
 {
@@ -36,10 +37,18 @@ public:
     virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::vector<std::int32_t> & value);
     virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::vector<double> & value);
     virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::string & value);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::vector<std::int32_t> >& pValue);
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::int32_t* pData, size_t count);
+    virtual bool supportsChangedRanges() const;
+    virtual void push(const PVBaseImpl& pv, const timespec& timestamp, const std::int32_t* pData, size_t count, const changedRanges_t& changedRanges);
+    virtual void pushBatch(const std::vector<PushRecordImpl>& records);
 
     template<typename T>
     void readCSValue(const std::string& pvName, timespec* pTimestamp, T* pValue);
 
+    template<typename E>
+    size_t readCSBuffer(const std::string& pvName, timespec* pTimestamp, E* pBuffer, size_t capacity);
+
     template<typename T>
     void writeCSValue(const std::string& pvName, const timespec& timestamp, const T& value);
 
@@ -51,12 +60,54 @@ public:
     void getPushedVectorDouble(const std::string& pvName, const timespec*& pTime, const std::vector<double>*& pValue);
     void getPushedString(const std::string& pvName, const timespec*& pTime, const std::string*& pValue);
 
+    /*
+     * Returns the address of the last shared buffer received by the interface
+     */
+    const void* getLastSharedBuffer() const;
+
+    /*
+     * Returns the address of the elements of the last array received by reference
+     *  (shared buffer or caller's buffer)
+     */
+    const void* getLastSharedData() const;
+
+    /*
+     * Returns the number of values received by the last call to pushBatch()
+     */
+    size_t getLastBatchSize() const;
+
+    /*
+     * Returns the ranges received by the last differential push
+     */
+    const changedRanges_t& getLastChangedRanges() const;
+
+    /*
+     * Simulates a slow control system: each push takes the specified time
+     */
+    void setPushDelay(std::uint32_t microseconds);
+
+    /*
+     * Simulates a control system that refuses the pushed values
+     */
+    void setPushError(bool bPushError);
+
 private:
     const std::string m_name;
 
     typedef std::map<std::string, PVBaseImpl*> registeredPVs_t;
     registeredPVs_t m_registeredPVs;
 
+    const void* m_pLastSharedBuffer;
+    const void* m_pLastSharedData;
+
+    std::uint32_t m_pushDelayMicroseconds;
+
+    bool m_bPushError;
+
+    size_t m_lastBatchSize;
+
+    changedRanges_t m_lastChangedRanges;
+
     template <typename T>
     class PushedValues
     {
@@ -107,6 +158,14 @@ private:
                          const timespec& timestamp,
                          const T& value)
     {
+        if(m_pushDelayMicroseconds != 0)
+        {
+            ::usleep(m_pushDelayMicroseconds);
+        }
+        if(m_bPushError)
+        {
+            throw std::runtime_error("The control system refused the value");
+        }
         storeInto[pvName].storeValue(timestamp, value);
     }
 
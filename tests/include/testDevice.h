@@ -1,6 +1,7 @@
 #ifndef TESTDEVICE_H
 #define TESTDEVICE_H
 
+#include <functional>
 #include <nds3/nds.h>
 
 class TestDevice
@@ -28,12 +29,22 @@ public:
     nds::PVVariableOut<std::int32_t> m_numberAcquisitions;
 
     nds::DataAcquisition<std::vector<std::int32_t> > m_dataAcquisition;
+    nds::DataAcquisition<std::vector<std::int32_t> > m_waveformAcquisition;
 
     nds::PVVariableIn<std::string> m_testVariableIn;
     nds::PVVariableOut<std::string> m_testVariableOut;
 
     nds::PVVariableOut<std::int32_t> m_setCurrentTime;
 
+    nds::PVVariableIn<std::int32_t> m_asyncVariableIn0;
+    nds::PVVariableIn<std::vector<std::int32_t> > m_asyncVariableIn1;
+
+    // Called by the PV delegateOut after it stores the written value
+    std::function<void(const std::string&)> m_writeDelegateHook;
+
+    // Called by the PV delegateOutInt32 with the written value
+    std::function<void(const std::int32_t&)> m_writeInt32DelegateHook;
+
 private:
     timespec getCurrentTime();
 
@@ -48,6 +59,7 @@ private:
 
     void readDelegate(timespec* pTimestamp, std::string* pValue);
     void writeDelegate(const timespec& timestamp, const std::string& value);
+    void writeInt32Delegate(const timespec& timestamp, const std::int32_t& value);
 
     void writeTestVariableIn(const timespec& timestamp, const std::string& value);
     void pushTestVariableIn(const timespec& timestamp, const std::string& value);
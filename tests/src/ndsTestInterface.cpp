@@ -11,7 +11,7 @@ static std::mutex m_lockInterfacesMap;
 
 
 TestControlSystemInterfaceImpl::TestControlSystemInterfaceImpl(const std::string &fullName):
-    m_name(fullName)
+    m_name(fullName), m_pLastSharedBuffer(0), m_pLastSharedData(0), m_pushDelayMicroseconds(0), m_bPushError(false), m_lastBatchSize(0)
 {
     std::lock_guard<std::mutex> lock(m_lockInterfacesMap);
     if(m_interfacesMap.find(fullName) != m_interfacesMap.end())
@@ -94,6 +94,67 @@ void TestControlSystemInterfaceImpl::push(const PVBaseImpl& pv, const timespec&
 
 
 
+void TestControlSystemInterfaceImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::shared_ptr<const std::vector<std::int32_t> >& pValue)
+{
+    m_pLastSharedBuffer = pValue.get();
+    m_pLastSharedData = pValue->data();
+    storePushedData(pv.getFullExternalName(), m_pushedVectorInt32, timestamp, *pValue);
+}
+
+void TestControlSystemInterfaceImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::int32_t* pData, size_t count)
+{
+    m_pLastSharedData = pData;
+    storePushedData(pv.getFullExternalName(), m_pushedVectorInt32, timestamp, std::vector<std::int32_t>(pData, pData + count));
+}
+
+bool TestControlSystemInterfaceImpl::supportsChangedRanges() const
+{
+    return true;
+}
+
+void TestControlSystemInterfaceImpl::push(const PVBaseImpl& pv, const timespec& timestamp, const std::int32_t* pData, size_t count, const changedRanges_t& changedRanges)
+{
+    m_lastChangedRanges = changedRanges;
+    push(pv, timestamp, pData, count);
+}
+
+void TestControlSystemInterfaceImpl::pushBatch(const std::vector<PushRecordImpl>& records)
+{
+    m_lastBatchSize = records.size();
+    InterfaceBaseImpl::pushBatch(records);
+}
+
+size_t TestControlSystemInterfaceImpl::getLastBatchSize() const
+{
+    return m_lastBatchSize;
+}
+
+const changedRanges_t& TestControlSystemInterfaceImpl::getLastChangedRanges() const
+{
+    return m_lastChangedRanges;
+}
+
+const void* TestControlSystemInterfaceImpl::getLastSharedBuffer() const
+{
+    return m_pLastSharedBuffer;
+}
+
+const void* TestControlSystemInterfaceImpl::getLastSharedData() const
+{
+    return m_pLastSharedData;
+}
+
+void TestControlSystemInterfaceImpl::setPushDelay(std::uint32_t microseconds)
+{
+    m_pushDelayMicroseconds = microseconds;
+}
+
+void TestControlSystemInterfaceImpl::setPushError(bool bPushError)
+{
+    m_bPushError = bPushError;
+}
+
+
 template<typename T>
 void TestControlSystemInterfaceImpl::readCSValue(const std::string& pvName, timespec* pTimestamp, T* pValue)
 {
@@ -114,6 +175,23 @@ template void TestControlSystemInterfaceImpl::readCSValue<std::vector<double> >(
 template void TestControlSystemInterfaceImpl::readCSValue<std::string>(const std::string& pvName, timespec* timestamp, std::string* value);
 
 
+template<typename E>
+size_t TestControlSystemInterfaceImpl::readCSBuffer(const std::string& pvName, timespec* pTimestamp, E* pBuffer, size_t capacity)
+{
+    registeredPVs_t::iterator findPV = m_registeredPVs.find(pvName);
+    if(findPV == m_registeredPVs.end())
+    {
+        throw std::runtime_error("PV not found");
+    }
+    return findPV->second->read(pTimestamp, pBuffer, capacity);
+}
+
+template size_t TestControlSystemInterfaceImpl::readCSBuffer<std::int8_t>(const std::string& pvName, timespec* timestamp, std::int8_t* pBuffer, size_t capacity);
+template size_t TestControlSystemInterfaceImpl::readCSBuffer<std::uint8_t>(const std::string& pvName, timespec* timestamp, std::uint8_t* pBuffer, size_t capacity);
+template size_t TestControlSystemInterfaceImpl::readCSBuffer<std::int32_t>(const std::string& pvName, timespec* timestamp, std::int32_t* pBuffer, size_t capacity);
+template size_t TestControlSystemInterfaceImpl::readCSBuffer<double>(const std::string& pvName, timespec* timestamp, double* pBuffer, size_t capacity);
+
+
 template<typename T>
 void TestControlSystemInterfaceImpl::writeCSValue(const std::string& pvName, const timespec& timestamp, const T& value)
 {
@@ -1,4 +1,8 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unistd.h>
 #include <nds3/nds.h>
 #include "testDevice.h"
 #include "ndsTestInterface.h"
@@ -151,6 +155,13 @@ TEST(testDataAcquisition, testDecimation)
         }
     }
 
+    // The decimation applied to the data is published once
+    ////////////////////////////////////////////////////////
+    const std::int32_t* pEffectiveDecimation;
+    pInterface->getPushedInt32("/rootNode-Channel1.data.EffectiveDecimation", pTime, pEffectiveDecimation);
+    EXPECT_EQ(2, *pEffectiveDecimation);
+    EXPECT_THROW(pInterface->getPushedInt32("/rootNode-Channel1.data.EffectiveDecimation", pTime, pEffectiveDecimation), std::runtime_error);
+
     pInterface->writeCSValue("/rootNode-Channel1.data.StateMachine.setState", timestamp, (std::int32_t)nds::state_t::on);
     pInterface->getPushedInt32("/rootNode-Channel1.data.StateMachine.getState", pStateMachineSwitchTime, pStateMachineState);
     EXPECT_EQ((std::int32_t)nds::state_t::stopping, *pStateMachineState);
@@ -159,3 +170,619 @@ TEST(testDataAcquisition, testDecimation)
 
 }
 
+
+TEST(testDataAcquisition, testDecimationModes)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    std::vector<std::vector<std::int32_t> > frames(3);
+    frames[0] = {1, -4, 10};
+    frames[1] = {2, -5, 20};
+    frames[2] = {4, -6, 0};
+
+    const std::vector<std::int32_t>* pPushedValues;
+    const timespec* pPushedTimestamp;
+    timespec timestamp = {0, 0};
+
+    pDevice->m_variableIn1.setDecimation(3);
+
+    // Average, rounded to the nearest integer
+    //////////////////////////////////////////
+    pDevice->m_variableIn1.setDecimationMode(nds::decimationMode_t::average);
+    for(size_t pushFrame(0); pushFrame != frames.size(); ++pushFrame)
+    {
+        timestamp.tv_sec = (time_t)pushFrame;
+        pDevice->m_variableIn1.push(timestamp, frames[pushFrame]);
+    }
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.variableIn1", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(2, pPushedTimestamp->tv_sec);
+    EXPECT_EQ(std::vector<std::int32_t>({2, -5, 10}), *pPushedValues);
+
+    // Minimum and maximum, selected via the command
+    ////////////////////////////////////////////////
+    nds::parameters_t parameters;
+    parameters.push_back("minimum");
+    nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("decimationMode", "rootNode-Channel1-variableIn1", parameters);
+    for(size_t pushFrame(0); pushFrame != frames.size(); ++pushFrame)
+    {
+        pDevice->m_variableIn1.push(timestamp, frames[pushFrame]);
+    }
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.variableIn1", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(std::vector<std::int32_t>({1, -6, 0}), *pPushedValues);
+
+    pDevice->m_variableIn1.setDecimationMode(nds::decimationMode_t::maximum);
+    for(size_t pushFrame(0); pushFrame != frames.size(); ++pushFrame)
+    {
+        pDevice->m_variableIn1.push(timestamp, frames[pushFrame]);
+    }
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.variableIn1", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(std::vector<std::int32_t>({4, -4, 20}), *pPushedValues);
+
+    // The peak hold keeps the maximum across the intervals
+    ///////////////////////////////////////////////////////
+    pDevice->m_variableIn1.setDecimationMode(nds::decimationMode_t::peakHold);
+    for(size_t pushFrame(0); pushFrame != frames.size(); ++pushFrame)
+    {
+        pDevice->m_variableIn1.push(timestamp, frames[pushFrame]);
+    }
+    for(size_t pushFrame(0); pushFrame != frames.size(); ++pushFrame)
+    {
+        pDevice->m_variableIn1.push(timestamp, std::vector<std::int32_t>(3, 5));
+    }
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.variableIn1", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(std::vector<std::int32_t>({4, -4, 20}), *pPushedValues);
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.variableIn1", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(std::vector<std::int32_t>({5, 5, 20}), *pPushedValues);
+
+    // Scalars are combined too
+    ///////////////////////////
+    pDevice->m_variableIn0.setDecimation(2);
+    pDevice->m_variableIn0.setDecimationMode(nds::decimationMode_t::average);
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)10);
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)21);
+    const std::int32_t* pPushedValue;
+    pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+    EXPECT_EQ(16, *pPushedValue);
+
+    // The data acquisition reads the mode from its PV
+    //////////////////////////////////////////////////
+    EXPECT_EQ(nds::decimationMode_t::sample, pDevice->m_dataAcquisition.getDecimationMode());
+    pInterface->writeCSValue("/rootNode-Channel1.data.DecimationMode", timestamp, (std::int32_t)nds::decimationMode_t::maximum);
+    EXPECT_EQ(nds::decimationMode_t::maximum, pDevice->m_dataAcquisition.getDecimationMode());
+
+    factory.destroyDevice("rootNode");
+}
+
+
+TEST(testDataAcquisition, testDeadband)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    const std::vector<std::int32_t>* pPushedValues;
+    const std::int32_t* pPushedValue;
+    const timespec* pPushedTimestamp;
+    timespec timestamp = {0, 0};
+
+    // Arrays pass when any element changes more than the deadband
+    //////////////////////////////////////////////////////////////
+    pDevice->m_dataAcquisition.setDeadband(nds::deadbandType_t::absolute, 5);
+
+    std::vector<std::int32_t> values(1000, 0);
+    pDevice->m_dataAcquisition.push(timestamp, values);
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.data.Data", pPushedTimestamp, pPushedValues);
+
+    std::fill(values.begin(), values.end(), 5);
+    pDevice->m_dataAcquisition.push(timestamp, values);
+    EXPECT_THROW(pInterface->getPushedVectorInt32("/rootNode-Channel1.data.Data", pPushedTimestamp, pPushedValues), std::runtime_error);
+
+    values[900] = 6;
+    pDevice->m_dataAcquisition.push(timestamp, values);
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.data.Data", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(values, *pPushedValues);
+
+    // A different size always passes
+    /////////////////////////////////
+    values.resize(10);
+    pDevice->m_dataAcquisition.push(timestamp, values);
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.data.Data", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(values, *pPushedValues);
+
+    // Relative deadband on a scalar, selected via the command
+    //////////////////////////////////////////////////////////
+    nds::parameters_t parameters;
+    parameters.push_back("relative");
+    parameters.push_back("0.1");
+    nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("deadband", "rootNode-Channel1-variableIn0", parameters);
+
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)100);
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)109);
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)91);
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)111);
+    pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+    EXPECT_EQ(100, *pPushedValue);
+    pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+    EXPECT_EQ(111, *pPushedValue);
+    EXPECT_THROW(pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue), std::runtime_error);
+
+    // Without deadband all the values pass
+    ///////////////////////////////////////
+    pDevice->m_variableIn0.setDeadband(nds::deadbandType_t::none, 0);
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)111);
+    pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+    EXPECT_EQ(111, *pPushedValue);
+
+    factory.destroyDevice("rootNode");
+}
+
+
+TEST(testDataAcquisition, testHistory)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+
+    std::vector<timespec> timestamps;
+    std::vector<std::int32_t> values;
+
+    // Nothing is recorded until a depth is set
+    ///////////////////////////////////////////
+    timespec timestamp = {1, 0};
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)1);
+    pDevice->m_variableIn0.getHistory(10, &timestamps, &values);
+    EXPECT_TRUE(values.empty());
+
+    // The ring keeps the newest values
+    ///////////////////////////////////
+    pDevice->m_variableIn0.setHistoryDepth(4);
+    for(std::int32_t pushValue(0); pushValue != 6; ++pushValue)
+    {
+        timestamp.tv_sec = 10 + pushValue;
+        pDevice->m_variableIn0.push(timestamp, pushValue);
+    }
+    pDevice->m_variableIn0.getHistory(10, &timestamps, &values);
+    EXPECT_EQ(std::vector<std::int32_t>({2, 3, 4, 5}), values);
+    ASSERT_EQ(4u, timestamps.size());
+    EXPECT_EQ(12, timestamps[0].tv_sec);
+    EXPECT_EQ(15, timestamps[3].tv_sec);
+
+    pDevice->m_variableIn0.getHistory(2, &timestamps, &values);
+    EXPECT_EQ(std::vector<std::int32_t>({4, 5}), values);
+
+    timespec from = {13, 0};
+    timespec to = {14, 0};
+    pDevice->m_variableIn0.getHistory(from, to, &timestamps, &values);
+    EXPECT_EQ(std::vector<std::int32_t>({3, 4}), values);
+
+    // Arrays are truncated to the maximum number of elements
+    /////////////////////////////////////////////////////////
+    pDevice->m_variableIn1.setMaxElements(3);
+    nds::parameters_t parameters;
+    parameters.push_back("2");
+    nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("historyDepth", "rootNode-Channel1-variableIn1", parameters);
+
+    timespec arrayTimestamp = {20, 5};
+    pDevice->m_variableIn1.push(arrayTimestamp, std::vector<std::int32_t>({1, 2}));
+    arrayTimestamp.tv_sec = 21;
+    pDevice->m_variableIn1.push(arrayTimestamp, std::vector<std::int32_t>({3, 4, 5, 6}));
+
+    std::vector<std::vector<std::int32_t> > arrays;
+    pDevice->m_variableIn1.getHistory(10, &timestamps, &arrays);
+    ASSERT_EQ(2u, arrays.size());
+    EXPECT_EQ(std::vector<std::int32_t>({1, 2}), arrays[0]);
+    EXPECT_EQ(std::vector<std::int32_t>({3, 4, 5}), arrays[1]);
+
+    // The command returns one line per value
+    /////////////////////////////////////////
+    parameters.clear();
+    parameters.push_back("last");
+    parameters.push_back("1");
+    nds::parameters_t history = nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("history", "rootNode-Channel1-variableIn1", parameters);
+    EXPECT_EQ(nds::parameters_t({"21.000000005 3 4 5"}), history);
+
+    parameters.clear();
+    parameters.push_back("20");
+    parameters.push_back("20.5");
+    history = nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("history", "rootNode-Channel1-variableIn1", parameters);
+    EXPECT_EQ(nds::parameters_t({"20.000000005 1 2"}), history);
+
+    // The commands reject the numbers that cannot be parsed
+    ////////////////////////////////////////////////////////
+    parameters.clear();
+    parameters.push_back("last");
+    parameters.push_back("many");
+    EXPECT_THROW(nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("history", "rootNode-Channel1-variableIn1", parameters), std::runtime_error);
+
+    parameters.clear();
+    parameters.push_back("deep");
+    EXPECT_THROW(nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("historyDepth", "rootNode-Channel1-variableIn1", parameters), std::runtime_error);
+    pDevice->m_variableIn1.getHistory(10, &timestamps, &arrays);
+    EXPECT_EQ(2u, arrays.size());
+
+    // The queries don't return the values overwritten while they are copied
+    /////////////////////////////////////////////////////////////////////////
+    pDevice->m_variableIn1.setMaxElements(1000);
+    pDevice->m_variableIn1.setHistoryDepth(8);
+
+    std::atomic<bool> bWriting(true);
+    std::thread writeThread([&]()
+    {
+        for(std::int32_t pushValue(0); pushValue != 20000; ++pushValue)
+        {
+            timespec pushTimestamp = {pushValue, 0};
+            pDevice->m_variableIn1.push(pushTimestamp, std::vector<std::int32_t>(1000, pushValue));
+        }
+        bWriting.store(false);
+    });
+
+    size_t inconsistentValues(0);
+    while(bWriting.load())
+    {
+        pDevice->m_variableIn1.getHistory(8, &timestamps, &arrays);
+        for(size_t scanValues(0); scanValues != arrays.size(); ++scanValues)
+        {
+            const std::int32_t expectedValue((std::int32_t)timestamps[scanValues].tv_sec);
+            if(std::count(arrays[scanValues].begin(), arrays[scanValues].end(), expectedValue) != 1000)
+            {
+                ++inconsistentValues;
+            }
+        }
+    }
+    writeThread.join();
+    EXPECT_EQ(0u, inconsistentValues);
+
+    factory.destroyDevice("rootNode");
+}
+
+
+TEST(testDataAcquisition, testArchive)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+
+    const std::string fileName("/tmp/nds3TestArchive.arc");
+    EXPECT_THROW(nds::ArchiveReader missingReader("/tmp/nds3MissingArchive.arc"), nds::ArchiveError);
+
+    // The ring keeps the newest frames
+    ///////////////////////////////////
+    pDevice->m_dataAcquisition.setArchive(fileName, 4);
+    nds::ArchiveReader reader(fileName);
+    EXPECT_EQ("rootNode-Channel1-data-Data", reader.getPVName());
+    EXPECT_EQ(nds::dataType_t::dataInt32Array, reader.getDataType());
+    EXPECT_EQ(10000u, reader.getMaxElements());
+    EXPECT_EQ(4u, reader.getNumFrames());
+    EXPECT_EQ(0u, reader.getWrittenCount());
+
+    for(std::int32_t pushFrame(0); pushFrame != 6; ++pushFrame)
+    {
+        timespec timestamp = {100 + pushFrame, pushFrame};
+        pDevice->m_dataAcquisition.push(timestamp, std::vector<std::int32_t>(pushFrame + 1, pushFrame));
+    }
+    EXPECT_EQ(6u, reader.getWrittenCount());
+
+    timespec timestamp;
+    std::vector<std::int32_t> frame;
+    EXPECT_FALSE(reader.read(1, &timestamp, &frame));
+    ASSERT_TRUE(reader.read(2, &timestamp, &frame));
+    EXPECT_EQ(std::vector<std::int32_t>(3, 2), frame);
+    EXPECT_EQ(102, timestamp.tv_sec);
+    EXPECT_EQ(2, timestamp.tv_nsec);
+    EXPECT_FALSE(reader.read(6, &timestamp, &frame));
+
+    std::vector<timespec> timestamps;
+    std::vector<std::vector<std::int32_t> > frames;
+    reader.readLast(10, &timestamps, &frames);
+    ASSERT_EQ(4u, frames.size());
+    EXPECT_EQ(std::vector<std::int32_t>(3, 2), frames[0]);
+    EXPECT_EQ(std::vector<std::int32_t>(6, 5), frames[3]);
+    EXPECT_EQ(105, timestamps[3].tv_sec);
+
+    std::vector<double> wrongTypeFrame;
+    EXPECT_THROW(reader.read(5, &timestamp, &wrongTypeFrame), nds::ArchiveError);
+
+    // A reader follows the writer without ever seeing a partial frame
+    //////////////////////////////////////////////////////////////////
+    pDevice->m_dataAcquisition.setArchive(fileName, 16);
+    nds::ArchiveReader followReader(fileName);
+
+    std::atomic<bool> bWriting(true);
+    std::thread writeThread([&]()
+    {
+        for(std::int32_t pushFrame(0); pushFrame != 20000; ++pushFrame)
+        {
+            timespec pushTimestamp = {pushFrame, 0};
+            pDevice->m_dataAcquisition.push(pushTimestamp, std::vector<std::int32_t>(100 + pushFrame % 100, pushFrame));
+        }
+        bWriting.store(false);
+    });
+
+    size_t inconsistentFrames(0);
+    while(bWriting.load())
+    {
+        followReader.readLast(16, &timestamps, &frames);
+        for(size_t scanFrames(0); scanFrames != frames.size(); ++scanFrames)
+        {
+            const std::int32_t expectedValue((std::int32_t)timestamps[scanFrames].tv_sec);
+            if(frames[scanFrames].size() != (size_t)(100 + expectedValue % 100) ||
+                    std::count(frames[scanFrames].begin(), frames[scanFrames].end(), expectedValue) != (std::ptrdiff_t)frames[scanFrames].size())
+            {
+                ++inconsistentFrames;
+            }
+        }
+    }
+    writeThread.join();
+    EXPECT_EQ(0u, inconsistentFrames);
+    EXPECT_EQ(20000u, followReader.getWrittenCount());
+
+    // The node command is rejected until the device selects a directory,
+    //  and accepts only plain file names
+    ////////////////////////////////////////////////////////////////////////
+    nds::parameters_t parameters;
+    parameters.push_back("nds3TestArchive.arc");
+    parameters.push_back("8");
+    EXPECT_THROW(nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("archive", "rootNode-Channel1-variableIn0", parameters), std::runtime_error);
+
+    pDevice->m_variableIn0.setArchiveDirectory("/tmp");
+    parameters[0] = "../tmp/nds3TestArchive.arc";
+    EXPECT_THROW(nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("archive", "rootNode-Channel1-variableIn0", parameters), std::runtime_error);
+    parameters[0] = "/tmp/nds3TestArchive.arc";
+    EXPECT_THROW(nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("archive", "rootNode-Channel1-variableIn0", parameters), std::runtime_error);
+
+    parameters[0] = "nds3TestArchive.arc";
+    nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("archive", "rootNode-Channel1-variableIn0", parameters);
+    timestamp.tv_sec = 7;
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)42);
+
+    nds::ArchiveReader scalarReader(fileName);
+    std::int32_t value;
+    ASSERT_TRUE(scalarReader.read(0, &timestamp, &value));
+    EXPECT_EQ(42, value);
+    EXPECT_EQ(7, timestamp.tv_sec);
+
+    pDevice->m_variableIn0.setArchive("", 0);
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)43);
+    EXPECT_EQ(1u, scalarReader.getWrittenCount());
+
+    pDevice->m_dataAcquisition.setArchive("", 0);
+    ::unlink(fileName.c_str());
+
+    factory.destroyDevice("rootNode");
+}
+
+
+TEST(testDataAcquisition, testMaxPublishRate)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    const std::vector<std::int32_t>* pPushedValues;
+    const std::int32_t* pPushedValue;
+    const timespec* pPushedTimestamp;
+
+    // The first value is published, the following ones are held and only
+    //  the latest is published at the end of the interval
+    ///////////////////////////////////////////////////////////////////////
+    pDevice->m_variableIn0.setMaxPublishRate(10);
+    for(std::int32_t pushValue(1); pushValue != 5; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_variableIn0.push(timestamp, pushValue);
+    }
+
+    ::usleep(300000);
+
+    pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+    EXPECT_EQ(1, *pPushedValue);
+    pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+    EXPECT_EQ(4, pPushedTimestamp->tv_sec);
+    EXPECT_EQ(4, *pPushedValue);
+    EXPECT_THROW(pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue), std::runtime_error);
+
+    // A rate of zero removes the limit
+    ///////////////////////////////////
+    pDevice->m_variableIn0.setMaxPublishRate(0);
+    timespec timestamp = {0, 0};
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)5);
+    pDevice->m_variableIn0.push(timestamp, (std::int32_t)6);
+    pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+    EXPECT_EQ(5, *pPushedValue);
+    pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+    EXPECT_EQ(6, *pPushedValue);
+
+    // Arrays, with the rate selected via the command
+    ///////////////////////////////////////////////////
+    nds::parameters_t parameters;
+    parameters.push_back("5");
+    nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("maxPublishRate", "rootNode-Channel1-data-Data", parameters);
+
+    std::vector<std::int32_t> values(100, 1);
+    pDevice->m_dataAcquisition.push(timestamp, values);
+    values[50] = 2;
+    pDevice->m_dataAcquisition.push(timestamp, values);
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.data.Data", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(1, (*pPushedValues)[50]);
+
+    ::usleep(300000);
+
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.data.Data", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(values, *pPushedValues);
+
+    factory.destroyDevice("rootNode");
+}
+
+
+TEST(testDataAcquisition, testDisplayDownsampling)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    const std::vector<std::int32_t>* pPushedValues;
+    const timespec* pPushedTimestamp;
+    timespec timestamp = {0, 0};
+
+    // The min/max envelope keeps the extremes of each bucket
+    /////////////////////////////////////////////////////////
+    std::vector<std::int32_t> values(10000);
+    for(size_t index(0); index != values.size(); ++index)
+    {
+        values[index] = (std::int32_t)index;
+    }
+    pDevice->m_waveformAcquisition.push(timestamp, values);
+
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.waveform.Data", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(values, *pPushedValues);
+
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.waveform.Display", pPushedTimestamp, pPushedValues);
+    ASSERT_EQ(100u, pPushedValues->size());
+    for(size_t bucket(0); bucket != 50; ++bucket)
+    {
+        EXPECT_EQ((std::int32_t)(bucket * 200), (*pPushedValues)[bucket * 2]);
+        EXPECT_EQ((std::int32_t)(bucket * 200 + 199), (*pPushedValues)[bucket * 2 + 1]);
+    }
+
+    // The largest triangle three buckets selects the spikes
+    ////////////////////////////////////////////////////////
+    pDevice->m_waveformAcquisition.setDisplayDownsampling(nds::downsamplingMode_t::lttb, 10);
+    std::fill(values.begin(), values.end(), 0);
+    values[5003] = 1000;
+    values[9999] = 1;
+    pDevice->m_waveformAcquisition.push(timestamp, &(values[0]), values.size());
+
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.waveform.Data", pPushedTimestamp, pPushedValues);
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.waveform.Display", pPushedTimestamp, pPushedValues);
+    ASSERT_EQ(10u, pPushedValues->size());
+    EXPECT_EQ(0, pPushedValues->front());
+    EXPECT_EQ(1, pPushedValues->back());
+    EXPECT_EQ(1, std::count(pPushedValues->begin(), pPushedValues->end(), 1000));
+
+    // Small arrays are not modified
+    ////////////////////////////////
+    values.resize(8);
+    pDevice->m_waveformAcquisition.push(timestamp, values);
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.waveform.Data", pPushedTimestamp, pPushedValues);
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.waveform.Display", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(values, *pPushedValues);
+
+    // Target sizes smaller than 3 are rejected
+    ///////////////////////////////////////////
+    EXPECT_THROW(pDevice->m_waveformAcquisition.setDisplayDownsampling(nds::downsamplingMode_t::minMax, 2), std::logic_error);
+    EXPECT_THROW(pDevice->m_waveformAcquisition.setDisplayDownsampling(nds::downsamplingMode_t::lttb, 0), std::logic_error);
+    values.resize(20);
+    pDevice->m_waveformAcquisition.push(timestamp, values);
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.waveform.Display", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(10u, pPushedValues->size());
+
+    factory.destroyDevice("rootNode");
+}
+
+
+TEST(testDataAcquisition, testPushPointer)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    const size_t maxElements(pDevice->m_dataAcquisition.getMaxElements());
+    std::unique_ptr<std::int32_t[]> pSamples(new std::int32_t[maxElements + 1]);
+    for(size_t fill(0); fill != maxElements + 1; ++fill)
+    {
+        pSamples[fill] = (std::int32_t)fill + 5;
+    }
+
+    // The interface receives the device's buffer
+    /////////////////////////////////////////////
+    timespec timestamp = {50, 60};
+    pDevice->m_dataAcquisition.push(timestamp, pSamples.get(), maxElements);
+    EXPECT_EQ(pSamples.get(), pInterface->getLastSharedData());
+
+    const std::vector<std::int32_t>* pPushedValues;
+    const timespec* pPushedTimestamp;
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.data.Data", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(50, pPushedTimestamp->tv_sec);
+    EXPECT_EQ(60, pPushedTimestamp->tv_nsec);
+    EXPECT_EQ(std::vector<std::int32_t>(pSamples.get(), pSamples.get() + maxElements), *pPushedValues);
+
+    // Too many elements
+    ////////////////////
+    EXPECT_THROW(pDevice->m_dataAcquisition.push(timestamp, pSamples.get(), maxElements + 1), nds::MaxElementsExceeded);
+
+    factory.destroyDevice("rootNode");
+}
+
+
+TEST(testDataAcquisition, testLeaseCommit)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    // Leased buffers are sized to maxElements
+    //////////////////////////////////////////
+    std::shared_ptr<std::vector<std::int32_t> > pBuffer(pDevice->m_dataAcquisition.lease());
+    ASSERT_EQ(pDevice->m_dataAcquisition.getMaxElements(), pBuffer->size());
+    for(size_t fillBuffer(0); fillBuffer != pBuffer->size(); ++fillBuffer)
+    {
+        (*pBuffer)[fillBuffer] = (std::int32_t)fillBuffer * 3;
+    }
+    const std::vector<std::int32_t>* pLeasedBuffer(pBuffer.get());
+
+    timespec timestamp = {30, 40};
+    pDevice->m_dataAcquisition.commit(timestamp, pBuffer);
+    EXPECT_FALSE(pBuffer);
+
+    // The control system must have received the leased buffer, not a copy
+    ///////////////////////////////////////////////////////////////////////
+    EXPECT_EQ(pLeasedBuffer, pInterface->getLastSharedBuffer());
+
+    const std::vector<std::int32_t>* pPushedValues;
+    const timespec* pPushedTimestamp;
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.data.Data", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(30, pPushedTimestamp->tv_sec);
+    EXPECT_EQ(40, pPushedTimestamp->tv_nsec);
+    ASSERT_EQ(pDevice->m_dataAcquisition.getMaxElements(), pPushedValues->size());
+    for(size_t compare(0); compare != pPushedValues->size(); ++compare)
+    {
+        EXPECT_EQ((std::int32_t)compare * 3, (*pPushedValues)[compare]);
+    }
+
+    // Nobody holds the buffer anymore: the pool hands it out again
+    ///////////////////////////////////////////////////////////////
+    pBuffer = pDevice->m_dataAcquisition.lease();
+    EXPECT_EQ(pLeasedBuffer, pBuffer.get());
+
+    // While a buffer is in use the pool provides a different one
+    /////////////////////////////////////////////////////////////
+    std::shared_ptr<std::vector<std::int32_t> > pSecondBuffer(pDevice->m_dataAcquisition.lease());
+    EXPECT_NE(pBuffer.get(), pSecondBuffer.get());
+    EXPECT_EQ(pDevice->m_dataAcquisition.getMaxElements(), pSecondBuffer->size());
+
+    factory.destroyDevice("rootNode");
+}
@@ -36,10 +36,24 @@ TestDevice::TestDevice(nds::Factory &factory, const std::string &parameter): m_n
                                                                                                      std::placeholders::_2,
                                                                                                      std::placeholders::_3)));
 
+    m_waveformAcquisition = channel1.addChild(nds::DataAcquisition<std::vector<std::int32_t> >("waveform",
+                                                                                               10000,
+                                                                                               std::bind(&TestDevice::switchOn, this),
+                                                                                               std::bind(&TestDevice::switchOff, this),
+                                                                                               std::bind(&TestDevice::start, this),
+                                                                                               std::bind(&TestDevice::stop, this),
+                                                                                               std::bind(&TestDevice::recover, this),
+                                                                                               std::bind(&TestDevice::allowChange, this,
+                                                                                                         std::placeholders::_1,
+                                                                                                         std::placeholders::_2,
+                                                                                                         std::placeholders::_3)));
+    m_waveformAcquisition.setDisplayDownsampling(nds::downsamplingMode_t::minMax, 100);
+
     m_numberAcquisitions = channel1.addChild(nds::PVVariableOut<std::int32_t>("numAcquisitions"));
 
     channel1.addChild(nds::PVDelegateIn<std::string>("delegateIn", std::bind(&TestDevice::readDelegate, this, std::placeholders::_1, std::placeholders::_2)));
     channel1.addChild(nds::PVDelegateOut<std::string>("delegateOut", std::bind(&TestDevice::writeDelegate, this, std::placeholders::_1, std::placeholders::_2)));
+    channel1.addChild(nds::PVDelegateOut<std::int32_t>("delegateOutInt32", std::bind(&TestDevice::writeInt32Delegate, this, std::placeholders::_1, std::placeholders::_2)));
 
     m_testVariableIn = channel1.addChild(nds::PVVariableIn<std::string>("testVariableIn"));
     m_testVariableIn.setValue("Initial value");
@@ -53,6 +67,12 @@ TestDevice::TestDevice(nds::Factory &factory, const std::string &parameter): m_n
 
     channel1.setTimestampDelegate(std::bind(&TestDevice::getCurrentTime, this));
 
+    nds::Port asyncChannel("AsyncChannel");
+    asyncChannel.setDispatchQueueSize(16);
+    rootNode.addChild(asyncChannel);
+    m_asyncVariableIn0 = asyncChannel.addChild(nds::PVVariableIn<std::int32_t>("asyncVariableIn0"));
+    m_asyncVariableIn1 = asyncChannel.addChild(nds::PVVariableIn<std::vector<std::int32_t> >("asyncVariableIn1"));
+
     rootNode.initialize(this, factory);
 }
 
@@ -159,6 +179,18 @@ void TestDevice::writeDelegate(const timespec& timestamp, const std::string& val
 {
     m_timestamp = timestamp;
     m_writtenByDelegate = value;
+    if(m_writeDelegateHook)
+    {
+        m_writeDelegateHook(value);
+    }
+}
+
+void TestDevice::writeInt32Delegate(const timespec& /* timestamp */, const std::int32_t& value)
+{
+    if(m_writeInt32DelegateHook)
+    {
+        m_writeInt32DelegateHook(value);
+    }
 }
 
 void TestDevice::writeTestVariableIn(const timespec& timestamp, const std::string& value)
@@ -1,4 +1,9 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
 #include <nds3/nds.h>
 #include "testDevice.h"
 #include "ndsTestInterface.h"
@@ -188,3 +193,1046 @@ TEST(testPVs, testReplication)
     factory.destroyDevice("rootNode");
 }
 
+TEST(testPVs, testLinkDecimation)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    factory.subscribe("rootNode-Channel1-testVariableIn", "rootNode-Channel1-testVariableOut", 3, 0);
+    factory.replicate("rootNode-Channel1-testVariableIn", "rootNode-Channel1-delegateIn", 2, 0);
+
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    // Each link applies its own decimation
+    ///////////////////////////////////////
+    for(std::int32_t count(0); count != 6; ++count)
+    {
+        std::ostringstream value;
+        value << "Test string " << count;
+
+        timespec timestamp;
+        timestamp.tv_sec = count;
+        timestamp.tv_nsec = 0;
+        pInterface->writeCSValue("/rootNode-Channel1.pushTestVariableIn", timestamp, value.str());
+
+        if(count >= 2)
+        {
+            std::string readValue;
+            timespec readTimestamp;
+            pInterface->readCSValue("/rootNode-Channel1.readTestVariableOut", &readTimestamp, &readValue);
+            EXPECT_EQ(count - (count + 1) % 3, readTimestamp.tv_sec);
+        }
+    }
+
+    const std::string* pReadValue;
+    const timespec* pReadTimestamp;
+    for(std::int32_t count(1); count < 6; count += 2)
+    {
+        pInterface->getPushedString("/rootNode-Channel1.delegateIn", pReadTimestamp, pReadValue);
+        EXPECT_EQ(count, pReadTimestamp->tv_sec);
+    }
+    EXPECT_THROW(pInterface->getPushedString("/rootNode-Channel1.delegateIn", pReadTimestamp, pReadValue), std::runtime_error);
+
+    // Replicating again replaces the settings of the link
+    //////////////////////////////////////////////////////
+    factory.replicate("rootNode-Channel1-testVariableIn", "rootNode-Channel1-delegateIn", 1, 1);
+    for(std::int32_t count(0); count != 5; ++count)
+    {
+        timespec timestamp = {count, 0};
+        pInterface->writeCSValue("/rootNode-Channel1.pushTestVariableIn", timestamp, std::string("rate limited"));
+    }
+    pInterface->getPushedString("/rootNode-Channel1.delegateIn", pReadTimestamp, pReadValue);
+    EXPECT_EQ(0, pReadTimestamp->tv_sec);
+    EXPECT_THROW(pInterface->getPushedString("/rootNode-Channel1.delegateIn", pReadTimestamp, pReadValue), std::runtime_error);
+
+    factory.destroyDevice("rootNode");
+}
+
+
+TEST(testPVs, testSharedPush)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    std::shared_ptr<std::vector<std::int32_t> > pBuffer(std::make_shared<std::vector<std::int32_t> >(1000));
+    for(size_t fill(0); fill != pBuffer->size(); ++fill)
+    {
+        (*pBuffer)[fill] = (std::int32_t)fill;
+    }
+
+    timespec timestamp;
+    timestamp.tv_sec = 10;
+    timestamp.tv_nsec = 20;
+    pDevice->m_variableIn1.push(timestamp, std::shared_ptr<const std::vector<std::int32_t> >(pBuffer));
+
+    // The interface must have received our buffer, not a copy
+    //////////////////////////////////////////////////////////
+    EXPECT_EQ(pBuffer.get(), pInterface->getLastSharedBuffer());
+
+    const std::vector<std::int32_t>* pPushedValues;
+    const timespec* pPushedTimestamp;
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.variableIn1", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(10, pPushedTimestamp->tv_sec);
+    EXPECT_EQ(20, pPushedTimestamp->tv_nsec);
+    EXPECT_EQ(*pBuffer, *pPushedValues);
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testDifferentialPush)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    pDevice->m_variableIn1.setDifferentialPush(true);
+
+    std::vector<std::int32_t> table(1000);
+    for(size_t fill(0); fill != table.size(); ++fill)
+    {
+        table[fill] = (std::int32_t)fill;
+    }
+
+    // The first array is pushed whole
+    //////////////////////////////////
+    timespec timestamp = {1, 0};
+    pDevice->m_variableIn1.push(timestamp, table);
+    EXPECT_TRUE(pInterface->getLastChangedRanges().empty());
+
+    // Then only the changed elements are listed, adjacent ones in one range
+    /////////////////////////////////////////////////////////////////////////
+    table[3] = -1;
+    table[500] = -1;
+    table[501] = -1;
+    table[999] = -1;
+    timestamp.tv_sec = 2;
+    pDevice->m_variableIn1.push(timestamp, table);
+
+    const nds::changedRanges_t& changedRanges(pInterface->getLastChangedRanges());
+    ASSERT_EQ(3u, changedRanges.size());
+    EXPECT_EQ(std::make_pair((size_t)3, (size_t)1), changedRanges[0]);
+    EXPECT_EQ(std::make_pair((size_t)500, (size_t)2), changedRanges[1]);
+    EXPECT_EQ(std::make_pair((size_t)999, (size_t)1), changedRanges[2]);
+
+    // The interface still receives the whole array
+    ///////////////////////////////////////////////
+    const std::vector<std::int32_t>* pPushedValues;
+    const timespec* pPushedTimestamp;
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.variableIn1", pPushedTimestamp, pPushedValues);
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.variableIn1", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(2, pPushedTimestamp->tv_sec);
+    EXPECT_EQ(table, *pPushedValues);
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testMovePush)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    std::vector<std::int32_t> values(1000);
+    for(size_t fill(0); fill != values.size(); ++fill)
+    {
+        values[fill] = (std::int32_t)fill * 2;
+    }
+    const std::vector<std::int32_t> expectedValues(values);
+    const std::int32_t* pMovedData(values.data());
+
+    timespec timestamp = {11, 21};
+    pDevice->m_variableIn1.push(timestamp, std::move(values));
+
+    // The interface must have received the moved elements, not a copy
+    ///////////////////////////////////////////////////////////////////
+    EXPECT_EQ(pMovedData, pInterface->getLastSharedData());
+
+    const std::vector<std::int32_t>* pPushedValues;
+    const timespec* pPushedTimestamp;
+    pInterface->getPushedVectorInt32("/rootNode-Channel1.variableIn1", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(11, pPushedTimestamp->tv_sec);
+    EXPECT_EQ(21, pPushedTimestamp->tv_nsec);
+    EXPECT_EQ(expectedValues, *pPushedValues);
+
+    // A moved value reaches the variable and its subscribers
+    /////////////////////////////////////////////////////////
+    nds::parameters_t parameters;
+    parameters.push_back("rootNode-Channel1-testVariableIn");
+    nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("subscribe", "rootNode-Channel1-testVariableOut", parameters);
+
+    timespec setTimestamp = {12, 22};
+    pDevice->m_testVariableIn.setValue(setTimestamp, std::string("Moved string"));
+
+    std::string readValue;
+    timespec readTimestamp;
+    pInterface->readCSValue("/rootNode-Channel1.readTestVariableOut", &readTimestamp, &readValue);
+    EXPECT_EQ("Moved string", readValue);
+    EXPECT_EQ(12, readTimestamp.tv_sec);
+    EXPECT_EQ(22, readTimestamp.tv_nsec);
+
+    pInterface->readCSValue("/rootNode-Channel1.testVariableIn", &readTimestamp, &readValue);
+    EXPECT_EQ("Moved string", readValue);
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testSubscribeWhilePushing)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    // Keep writing the input PV while the output PV is subscribed and
+    //  unsubscribed
+    //////////////////////////////////////////////////////////////////
+    std::atomic<bool> bStop(false);
+    std::atomic<std::uint32_t> numWrites(0);
+    std::thread writeThread([&]()
+    {
+        while(!bStop.load())
+        {
+            pDevice->m_testVariableIn.setValue(std::string("Written while subscribing"));
+            ++numWrites;
+        }
+    });
+    while(numWrites.load() == 0)
+    {
+        std::this_thread::yield();
+    }
+
+    for(size_t cycle(0); cycle != 1000; ++cycle)
+    {
+        factory.subscribe("rootNode-Channel1-testVariableIn", "rootNode-Channel1-testVariableOut");
+        factory.unsubscribe("rootNode-Channel1-testVariableOut");
+    }
+
+    bStop.store(true);
+    writeThread.join();
+    EXPECT_NE(0u, numWrites.load());
+
+    // After unsubscribe() the output PV does not receive any value
+    ///////////////////////////////////////////////////////////////
+    timespec timestamp = {13, 23};
+    pDevice->m_testVariableIn.setValue(timestamp, std::string("Not subscribed"));
+
+    std::string readValue;
+    timespec readTimestamp;
+    pInterface->readCSValue("/rootNode-Channel1.readTestVariableOut", &readTimestamp, &readValue);
+    EXPECT_NE("Not subscribed", readValue);
+
+    factory.subscribe("rootNode-Channel1-testVariableIn", "rootNode-Channel1-testVariableOut");
+    pDevice->m_testVariableIn.setValue(timestamp, std::string("Subscribed"));
+    pInterface->readCSValue("/rootNode-Channel1.readTestVariableOut", &readTimestamp, &readValue);
+    EXPECT_EQ("Subscribed", readValue);
+    EXPECT_EQ(13, readTimestamp.tv_sec);
+
+    // A receiver can unsubscribe itself while it receives a value
+    //////////////////////////////////////////////////////////////
+    factory.subscribe("rootNode-Channel1-testVariableIn", "rootNode-Channel1-delegateOut");
+    pDevice->m_writeDelegateHook = [&](const std::string&)
+    {
+        factory.unsubscribe("rootNode-Channel1-delegateOut");
+    };
+    pDevice->m_testVariableIn.setValue(timestamp, std::string("Unsubscribe"));
+    pDevice->m_writeDelegateHook = std::function<void(const std::string&)>();
+
+    pDevice->m_testVariableIn.setValue(timestamp, std::string("After unsubscribe"));
+    pInterface->readCSValue("/rootNode-Channel1.delegateIn", &readTimestamp, &readValue);
+    EXPECT_EQ("Unsubscribe", readValue);
+
+    // Also a scalar receiver, which gets a copy of the value: via push()
+    //  and via setValue(). The removal doesn't wait for the delivery that
+    //  is calling it
+    /////////////////////////////////////////////////////////////////////
+    std::vector<std::int32_t> receivedValues;
+    pDevice->m_writeInt32DelegateHook = [&](const std::int32_t& value)
+    {
+        receivedValues.push_back(value);
+        factory.unsubscribe("rootNode-Channel1-delegateOutInt32");
+    };
+    std::chrono::steady_clock::time_point startPush(std::chrono::steady_clock::now());
+    factory.subscribe("rootNode-Channel1-variableIn0", "rootNode-Channel1-delegateOutInt32");
+    pDevice->m_variableIn0.push(timestamp, 1);
+    pDevice->m_variableIn0.push(timestamp, 2);
+    factory.subscribe("rootNode-Channel1-variableIn0", "rootNode-Channel1-delegateOutInt32");
+    pDevice->m_variableIn0.setValue(timestamp, 3);
+    pDevice->m_variableIn0.setValue(timestamp, 4);
+    EXPECT_GT(500, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startPush).count());
+    pDevice->m_writeInt32DelegateHook = std::function<void(const std::int32_t&)>();
+
+    ASSERT_EQ(2u, receivedValues.size());
+    EXPECT_EQ(1, receivedValues[0]);
+    EXPECT_EQ(3, receivedValues[1]);
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testScalarReadWhileWriting)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    // Each value is written with a timestamp equal to the value: a reader
+    //  must never see the value of a write and the timestamp of another
+    //////////////////////////////////////////////////////////////////////
+    const std::int32_t numValues(200000);
+    std::thread writeThread([&]()
+    {
+        for(std::int32_t value(1); value <= numValues; ++value)
+        {
+            timespec timestamp = {value, value};
+            pInterface->writeCSValue("/rootNode-Channel1.numAcquisitions", timestamp, value);
+            pDevice->m_variableIn0.setValue(timestamp, value);
+        }
+    });
+
+    std::int32_t lastOutputValue(0);
+    std::int32_t lastInputValue(0);
+    size_t numInconsistentReads(0);
+    while(lastOutputValue != numValues || lastInputValue != numValues)
+    {
+        timespec readTimestamp;
+        std::int32_t readValue;
+
+        pDevice->m_numberAcquisitions.getValue(&readTimestamp, &readValue);
+        if(readValue != readTimestamp.tv_sec || readValue != readTimestamp.tv_nsec || readValue < lastOutputValue)
+        {
+            ++numInconsistentReads;
+        }
+        lastOutputValue = readValue;
+
+        pInterface->readCSValue("/rootNode-Channel1.variableIn0", &readTimestamp, &readValue);
+        if(readValue != readTimestamp.tv_sec || readValue != readTimestamp.tv_nsec || readValue < lastInputValue)
+        {
+            ++numInconsistentReads;
+        }
+        lastInputValue = readValue;
+    }
+    writeThread.join();
+    EXPECT_EQ(0u, numInconsistentReads);
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testArraySnapshots)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    // A view is not modified by the following writes
+    /////////////////////////////////////////////////
+    timespec timestamp = {3, 4};
+    pDevice->m_variableIn1.setValue(timestamp, std::vector<std::int32_t>(1000, 1));
+
+    timespec snapshotTimestamp;
+    std::shared_ptr<const std::vector<std::int32_t> > pSnapshot(pDevice->m_variableIn1.getSnapshot(&snapshotTimestamp));
+    EXPECT_EQ(3, snapshotTimestamp.tv_sec);
+
+    timestamp.tv_sec = 5;
+    pDevice->m_variableIn1.setValue(timestamp, std::vector<std::int32_t>(1000, 2));
+    EXPECT_EQ(std::vector<std::int32_t>(1000, 1), *pSnapshot);
+
+    std::vector<std::int32_t> readValue;
+    timespec readTimestamp;
+    pInterface->readCSValue("/rootNode-Channel1.variableIn1", &readTimestamp, &readValue);
+    EXPECT_EQ(std::vector<std::int32_t>(1000, 2), readValue);
+    EXPECT_EQ(5, readTimestamp.tv_sec);
+
+    timestamp.tv_sec = 6;
+    pInterface->writeCSValue("/rootNode-Channel1.testVariableOut", timestamp, std::string("First value"));
+    std::shared_ptr<const std::string> pStringSnapshot(pDevice->m_testVariableOut.getSnapshot(&snapshotTimestamp));
+    pInterface->writeCSValue("/rootNode-Channel1.testVariableOut", timestamp, std::string("Second value"));
+    EXPECT_EQ("First value", *pStringSnapshot);
+    EXPECT_EQ("Second value", pDevice->m_testVariableOut.getValue());
+
+    // The readers always see a whole array, with its own timestamp
+    ///////////////////////////////////////////////////////////////
+    timestamp.tv_sec = 0;
+    pDevice->m_variableIn1.setValue(timestamp, std::vector<std::int32_t>(1000, 0));
+
+    const std::int32_t numValues(2000);
+    std::atomic<bool> bStop(false);
+    std::thread writeThread([&]()
+    {
+        for(std::int32_t value(1); value <= numValues; ++value)
+        {
+            timespec writeTimestamp = {value, 0};
+            pDevice->m_variableIn1.setValue(writeTimestamp, std::vector<std::int32_t>(1000, value));
+        }
+        bStop.store(true);
+    });
+
+    size_t numInconsistentReads(0);
+    while(!bStop.load())
+    {
+        pInterface->readCSValue("/rootNode-Channel1.variableIn1", &readTimestamp, &readValue);
+        if(readValue != std::vector<std::int32_t>(1000, (std::int32_t)readTimestamp.tv_sec))
+        {
+            ++numInconsistentReads;
+        }
+    }
+    writeThread.join();
+    EXPECT_EQ(0u, numInconsistentReads);
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testReadIntoBuffer)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    // Arrays are truncated to the buffer capacity
+    //////////////////////////////////////////////
+    timespec timestamp = {7, 8};
+    std::vector<std::int32_t> value(10);
+    for(size_t fillValue(0); fillValue != value.size(); ++fillValue)
+    {
+        value[fillValue] = (std::int32_t)fillValue;
+    }
+    pDevice->m_variableIn1.setValue(timestamp, value);
+
+    std::int32_t buffer[16] = {0};
+    timespec readTimestamp;
+    EXPECT_EQ(10u, pInterface->readCSBuffer("/rootNode-Channel1.variableIn1", &readTimestamp, buffer, 16));
+    EXPECT_EQ(std::vector<std::int32_t>(buffer, buffer + 10), value);
+    EXPECT_EQ(7, readTimestamp.tv_sec);
+    EXPECT_EQ(8, readTimestamp.tv_nsec);
+
+    EXPECT_EQ(4u, pInterface->readCSBuffer("/rootNode-Channel1.variableIn1", &readTimestamp, buffer, 4));
+
+    // Scalars are read as one element
+    //////////////////////////////////
+    pDevice->m_variableIn0.setValue(timestamp, 42);
+    EXPECT_EQ(1u, pInterface->readCSBuffer("/rootNode-Channel1.variableIn0", &readTimestamp, buffer, 16));
+    EXPECT_EQ(42, buffer[0]);
+
+    // Strings are read as arrays of bytes, also from the delegate PVs
+    //////////////////////////////////////////////////////////////////
+    std::uint8_t stringBuffer[32];
+    pInterface->writeCSValue("/rootNode-Channel1.testVariableOut", timestamp, std::string("buffer test"));
+    ASSERT_EQ(11u, pInterface->readCSBuffer("/rootNode-Channel1.testVariableOut", &readTimestamp, stringBuffer, 32));
+    EXPECT_EQ("buffer test", std::string((const char*)stringBuffer, 11));
+
+    ASSERT_EQ(6u, pInterface->readCSBuffer("/rootNode-Channel1.readTestVariableOut", &readTimestamp, stringBuffer, 6));
+    EXPECT_EQ("buffer", std::string((const char*)stringBuffer, 6));
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testAsyncPush)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-AsyncChannel");
+
+    // Push more values than the queue can hold
+    ///////////////////////////////////////////
+    for(std::int32_t pushValue(0); pushValue != 200; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+    }
+
+    std::shared_ptr<const std::vector<std::int32_t> > pBuffer(std::make_shared<std::vector<std::int32_t> >(100, 7));
+    timespec bufferTimestamp = {300, 10};
+    pDevice->m_asyncVariableIn1.push(bufferTimestamp, pBuffer);
+
+    // Let the dispatcher thread deliver the values
+    ///////////////////////////////////////////////
+    ::sleep(1);
+
+    const std::int32_t* pPushedValue;
+    const timespec* pPushedTimestamp;
+    for(std::int32_t pushValue(0); pushValue != 200; ++pushValue)
+    {
+        pInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue);
+        EXPECT_EQ(pushValue, pPushedTimestamp->tv_sec);
+        EXPECT_EQ(pushValue, *pPushedValue);
+    }
+
+    // The queue carries the shared buffer, not a copy
+    //////////////////////////////////////////////////
+    EXPECT_EQ(pBuffer.get(), pInterface->getLastSharedBuffer());
+    const std::vector<std::int32_t>* pPushedValues;
+    pInterface->getPushedVectorInt32("/rootNode-AsyncChannel.asyncVariableIn1", pPushedTimestamp, pPushedValues);
+    EXPECT_EQ(300, pPushedTimestamp->tv_sec);
+    EXPECT_EQ(10, pPushedTimestamp->tv_nsec);
+    EXPECT_EQ(*pBuffer, *pPushedValues);
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testMultiProducerPush)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-AsyncChannel");
+
+    pDevice->m_asyncVariableIn0.setMultiProducer(true);
+    pDevice->m_asyncVariableIn0.setDecimation(2);
+
+    // Several threads push into the same PV, each with its own timestamps
+    //////////////////////////////////////////////////////////////////////
+    const std::int32_t numProducers(4);
+    const std::int32_t numValues(500);
+    std::vector<std::thread> producers;
+    for(std::int32_t producer(0); producer != numProducers; ++producer)
+    {
+        producers.push_back(std::thread([pDevice, producer, numValues]()
+        {
+            for(std::int32_t pushValue(0); pushValue != numValues; ++pushValue)
+            {
+                timespec timestamp = {producer, pushValue};
+                pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+            }
+        }));
+    }
+    for(std::vector<std::thread>::iterator scanProducers(producers.begin()); scanProducers != producers.end(); ++scanProducers)
+    {
+        scanProducers->join();
+    }
+
+    // Let the dispatcher thread deliver the values
+    ///////////////////////////////////////////////
+    ::sleep(1);
+
+    // The decimation is counted across the producers and the values of each
+    //  producer keep their order
+    /////////////////////////////////////////////////////////////////////////
+    std::vector<std::int32_t> lastValues(numProducers, -1);
+    const std::int32_t* pPushedValue;
+    const timespec* pPushedTimestamp;
+    for(std::int32_t delivered(0); delivered != numProducers * numValues / 2; ++delivered)
+    {
+        pInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue);
+        ASSERT_LT(pPushedTimestamp->tv_sec, numProducers);
+        EXPECT_LT(lastValues[pPushedTimestamp->tv_sec], *pPushedValue);
+        lastValues[pPushedTimestamp->tv_sec] = *pPushedValue;
+    }
+    EXPECT_THROW(pInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue), std::runtime_error);
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testMultiProducerReplication)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    pDevice->m_asyncVariableIn0.setMultiProducer(true);
+
+    // The producers push without locks while the replication is set up:
+    //  all the values pushed after replicate() returns reach the destination
+    /////////////////////////////////////////////////////////////////////////
+    const std::int32_t numProducers(4);
+    const std::int32_t numValues(100);
+    std::atomic<bool> bReplicating(false);
+    std::vector<std::thread> producers;
+    for(std::int32_t producer(0); producer != numProducers; ++producer)
+    {
+        producers.push_back(std::thread([pDevice, producer, numValues, &bReplicating]()
+        {
+            timespec timestamp = {producer, 0};
+            while(!bReplicating.load())
+            {
+                pDevice->m_asyncVariableIn0.push(timestamp, -1);
+                ::usleep(100);
+            }
+            for(std::int32_t pushValue(0); pushValue != numValues; ++pushValue)
+            {
+                pDevice->m_asyncVariableIn0.push(timestamp, producer * numValues + pushValue);
+            }
+        }));
+    }
+    ::usleep(10000);
+    factory.replicate("rootNode-AsyncChannel-asyncVariableIn0", "rootNode-Channel1-variableIn0");
+    bReplicating.store(true);
+    for(std::vector<std::thread>::iterator scanProducers(producers.begin()); scanProducers != producers.end(); ++scanProducers)
+    {
+        scanProducers->join();
+    }
+
+    std::vector<bool> replicated(numProducers * numValues, false);
+    const std::int32_t* pPushedValue;
+    const timespec* pPushedTimestamp;
+    try
+    {
+        for(;;)
+        {
+            pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+            if(*pPushedValue >= 0)
+            {
+                ASSERT_LT(*pPushedValue, numProducers * numValues);
+                replicated[*pPushedValue] = true;
+            }
+        }
+    }
+    catch(const std::runtime_error&)
+    {
+    }
+    EXPECT_EQ(replicated.end(), std::find(replicated.begin(), replicated.end(), false));
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testPushPolicies)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-AsyncChannel");
+
+    // Slow control system: the queue (16 slots) overflows
+    //////////////////////////////////////////////////////
+    pInterface->setPushDelay(2000);
+
+    const std::int32_t* pPushedValue;
+    const timespec* pPushedTimestamp;
+
+    // Drop newest: the values that find the queue full are discarded
+    /////////////////////////////////////////////////////////////////
+    nds::parameters_t parameters;
+    parameters.push_back("dropNewest");
+    nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("pushPolicy", "rootNode-AsyncChannel-asyncVariableIn0", parameters);
+    for(std::int32_t pushValue(0); pushValue != 100; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+    }
+    ::sleep(1);
+
+    EXPECT_EQ(100u, pDevice->m_asyncVariableIn0.getEnqueuedCount());
+    EXPECT_LT(0u, pDevice->m_asyncVariableIn0.getDroppedCount());
+    EXPECT_EQ(100u, pDevice->m_asyncVariableIn0.getDeliveredCount() + pDevice->m_asyncVariableIn0.getDroppedCount());
+
+    std::int32_t previousValue(-1);
+    for(std::uint64_t readValues(0); readValues != pDevice->m_asyncVariableIn0.getDeliveredCount(); ++readValues)
+    {
+        pInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue);
+        EXPECT_LT(previousValue, *pPushedValue);
+        previousValue = *pPushedValue;
+    }
+
+    // Keep latest: the last pushed value is always delivered
+    /////////////////////////////////////////////////////////
+    pDevice->m_asyncVariableIn0.setPushPolicy(nds::pushPolicy_t::keepLatest);
+    const std::uint64_t deliveredBefore(pDevice->m_asyncVariableIn0.getDeliveredCount());
+    const std::uint64_t droppedBefore(pDevice->m_asyncVariableIn0.getDroppedCount());
+    for(std::int32_t pushValue(1000); pushValue != 1100; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+    }
+    ::sleep(1);
+
+    const std::uint64_t delivered(pDevice->m_asyncVariableIn0.getDeliveredCount() - deliveredBefore);
+    EXPECT_LT(0u, pDevice->m_asyncVariableIn0.getDroppedCount() - droppedBefore);
+    EXPECT_EQ(100u, delivered + pDevice->m_asyncVariableIn0.getDroppedCount() - droppedBefore);
+    for(std::uint64_t readValues(0); readValues != delivered; ++readValues)
+    {
+        pInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue);
+    }
+    EXPECT_EQ(1099, *pPushedValue);
+
+    // The statistics are available to the control system
+    //////////////////////////////////////////////////////
+    nds::parameters_t noParameters;
+    nds::parameters_t statistics = nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("pushStatistics", "rootNode-AsyncChannel-asyncVariableIn0", noParameters);
+    ASSERT_EQ(3u, statistics.size());
+    EXPECT_EQ("200", statistics[0]);
+    EXPECT_EQ(std::to_string(pDevice->m_asyncVariableIn0.getDeliveredCount()), statistics[1]);
+    EXPECT_EQ(std::to_string(pDevice->m_asyncVariableIn0.getDroppedCount()), statistics[2]);
+
+    // Drop oldest: the latest values are delivered
+    ///////////////////////////////////////////////
+    pDevice->m_asyncVariableIn0.setPushPolicy(nds::pushPolicy_t::dropOldest);
+    const std::uint64_t deliveredBeforeDropOldest(pDevice->m_asyncVariableIn0.getDeliveredCount());
+    const std::uint64_t droppedBeforeDropOldest(pDevice->m_asyncVariableIn0.getDroppedCount());
+    for(std::int32_t pushValue(2000); pushValue != 2100; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+    }
+    ::sleep(1);
+
+    const std::uint64_t deliveredDropOldest(pDevice->m_asyncVariableIn0.getDeliveredCount() - deliveredBeforeDropOldest);
+    EXPECT_LT(0u, pDevice->m_asyncVariableIn0.getDroppedCount() - droppedBeforeDropOldest);
+    EXPECT_EQ(100u, deliveredDropOldest + pDevice->m_asyncVariableIn0.getDroppedCount() - droppedBeforeDropOldest);
+    for(std::uint64_t readValues(0); readValues != deliveredDropOldest; ++readValues)
+    {
+        pInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue);
+    }
+    EXPECT_EQ(2099, *pPushedValue);
+
+    // Block: nothing is lost
+    /////////////////////////
+    pDevice->m_asyncVariableIn0.setPushPolicy(nds::pushPolicy_t::block);
+    const std::uint64_t droppedBeforeBlock(pDevice->m_asyncVariableIn0.getDroppedCount());
+    for(std::int32_t pushValue(0); pushValue != 50; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+    }
+    ::sleep(1);
+    EXPECT_EQ(droppedBeforeBlock, pDevice->m_asyncVariableIn0.getDroppedCount());
+    for(std::int32_t pushValue(0); pushValue != 50; ++pushValue)
+    {
+        pInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue);
+        EXPECT_EQ(pushValue, *pPushedValue);
+    }
+
+    // A queue full of values that cannot be discarded doesn't stall the
+    //  lossy PVs: drop oldest discards its own value, keep latest waits
+    //  outside of the queue
+    ////////////////////////////////////////////////////////////////////
+    pInterface->setPushDelay(20000);
+    const std::uint64_t deliveredBeforeFull(pDevice->m_asyncVariableIn0.getDeliveredCount());
+    const std::uint64_t droppedBeforeFull(pDevice->m_asyncVariableIn0.getDroppedCount());
+    std::thread blockingThread([pDevice]()
+    {
+        for(std::int32_t pushValue(0); pushValue != 40; ++pushValue)
+        {
+            timespec timestamp = {pushValue, 0};
+            pDevice->m_asyncVariableIn1.push(timestamp, std::vector<std::int32_t>(1, pushValue));
+        }
+    });
+    ::usleep(50000);
+
+    pDevice->m_asyncVariableIn0.setPushPolicy(nds::pushPolicy_t::dropOldest);
+    std::chrono::steady_clock::time_point startPush(std::chrono::steady_clock::now());
+    for(std::int32_t pushValue(3000); pushValue != 3020; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+    }
+    EXPECT_GT(100, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startPush).count());
+    EXPECT_LT(0u, pDevice->m_asyncVariableIn0.getDroppedCount() - droppedBeforeFull);
+
+    pDevice->m_asyncVariableIn0.setPushPolicy(nds::pushPolicy_t::keepLatest);
+    startPush = std::chrono::steady_clock::now();
+    for(std::int32_t pushValue(4000); pushValue != 4020; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+    }
+    EXPECT_GT(100, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startPush).count());
+
+    blockingThread.join();
+    ::sleep(2);
+
+    const std::uint64_t deliveredFull(pDevice->m_asyncVariableIn0.getDeliveredCount() - deliveredBeforeFull);
+    EXPECT_EQ(40u, deliveredFull + pDevice->m_asyncVariableIn0.getDroppedCount() - droppedBeforeFull);
+    for(std::uint64_t readValues(0); readValues != deliveredFull; ++readValues)
+    {
+        pInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue);
+    }
+    EXPECT_EQ(4019, *pPushedValue);
+
+    pInterface->setPushDelay(0);
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testPushReachesOwnPort)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+    nds::tests::TestControlSystemInterfaceImpl* pAsyncInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-AsyncChannel");
+
+    // Each PV pushes through the port resolved during the initialization,
+    //  also when the pushes of PVs on different ports are interleaved
+    ///////////////////////////////////////////////////////////////////////
+    for(std::int32_t pushValue(0); pushValue != 100; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_variableIn0.push(timestamp, pushValue);
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue + 1000);
+    }
+    ::usleep(100000);
+
+    const std::int32_t* pPushedValue;
+    const timespec* pPushedTimestamp;
+    for(std::int32_t pushValue(0); pushValue != 100; ++pushValue)
+    {
+        pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+        EXPECT_EQ(pushValue, *pPushedValue);
+        pAsyncInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue);
+        EXPECT_EQ(pushValue + 1000, *pPushedValue);
+    }
+    EXPECT_THROW(pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue), std::runtime_error);
+    EXPECT_THROW(pInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue), std::runtime_error);
+    EXPECT_THROW(pAsyncInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue), std::runtime_error);
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testConflation)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-AsyncChannel");
+
+    // Slow control system: the pushing thread never waits and each dispatcher
+    //  pass delivers only the latest value
+    //////////////////////////////////////////////////////////////////////////
+    pInterface->setPushDelay(2000);
+
+    nds::parameters_t parameters;
+    parameters.push_back("conflate");
+    nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("pushPolicy", "rootNode-AsyncChannel-asyncVariableIn0", parameters);
+    for(std::int32_t pushValue(0); pushValue != 1000; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+    }
+    ::sleep(1);
+
+    const std::uint64_t delivered(pDevice->m_asyncVariableIn0.getDeliveredCount());
+    EXPECT_EQ(1000u, pDevice->m_asyncVariableIn0.getEnqueuedCount());
+    EXPECT_GT(100u, delivered);
+    EXPECT_EQ(1000u, delivered + pDevice->m_asyncVariableIn0.getDroppedCount());
+    EXPECT_EQ(1000u, pDevice->m_asyncVariableIn0.getLastDeliveredSequence());
+
+    const std::int32_t* pPushedValue;
+    const timespec* pPushedTimestamp;
+    std::int32_t previousValue(-1);
+    for(std::uint64_t readValues(0); readValues != delivered; ++readValues)
+    {
+        pInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue);
+        EXPECT_LT(previousValue, *pPushedValue);
+        previousValue = *pPushedValue;
+    }
+    EXPECT_EQ(999, previousValue);
+
+    pInterface->setPushDelay(0);
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testAdaptiveDecimation)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-AsyncChannel");
+
+    nds::parameters_t parameters;
+    parameters.push_back("16");
+    nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("adaptiveDecimation", "rootNode-AsyncChannel-asyncVariableIn0", parameters);
+
+    // Slow control system: the queue fills up and the decimation rises
+    ///////////////////////////////////////////////////////////////////
+    pInterface->setPushDelay(2000);
+    for(std::int32_t pushValue(0); pushValue != 200; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+    }
+    EXPECT_LT(1u, pDevice->m_asyncVariableIn0.getEffectiveDecimation());
+    EXPECT_GE(16u, pDevice->m_asyncVariableIn0.getEffectiveDecimation());
+    EXPECT_LT(0u, pDevice->m_asyncVariableIn0.getDecimatedCount());
+
+    // Fast control system: the decimation falls back to the selected one
+    /////////////////////////////////////////////////////////////////////
+    pInterface->setPushDelay(0);
+    ::sleep(1);
+    for(std::int32_t pushValue(0); pushValue != 40; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+        ::usleep(1000);
+    }
+    EXPECT_EQ(1u, pDevice->m_asyncVariableIn0.getEffectiveDecimation());
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testPushDiagnostics)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-AsyncChannel");
+
+    // Half of the values are decimated, the queue overflows with the other half
+    ////////////////////////////////////////////////////////////////////////////
+    pInterface->setPushDelay(2000);
+    pDevice->m_asyncVariableIn0.setDecimation(2);
+    pDevice->m_asyncVariableIn0.setPushPolicy(nds::pushPolicy_t::dropOldest);
+    for(std::int32_t pushValue(0); pushValue != 100; ++pushValue)
+    {
+        timespec timestamp = {pushValue, 0};
+        pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+    }
+    ::sleep(1);
+
+    EXPECT_EQ(100u, pDevice->m_asyncVariableIn0.getPushedCount());
+    EXPECT_EQ(50u, pDevice->m_asyncVariableIn0.getDecimatedCount());
+    EXPECT_EQ(0u, pDevice->m_asyncVariableIn0.getFilteredCount());
+    EXPECT_EQ(50u, pDevice->m_asyncVariableIn0.getEnqueuedCount());
+    EXPECT_LT(0u, pDevice->m_asyncVariableIn0.getDroppedCount());
+
+    // The oldest values have been dropped: each one left a gap in the sequence
+    ///////////////////////////////////////////////////////////////////////////
+    EXPECT_EQ(50u, pDevice->m_asyncVariableIn0.getLastDeliveredSequence());
+    EXPECT_EQ(pDevice->m_asyncVariableIn0.getDroppedCount(), pDevice->m_asyncVariableIn0.getGapCount());
+
+    nds::parameters_t noParameters;
+    nds::parameters_t diagnostics = nds::tests::TestControlSystemFactoryImpl::getInstance()->executeCommand("pushDiagnostics", "rootNode-AsyncChannel-asyncVariableIn0", noParameters);
+    ASSERT_EQ(9u, diagnostics.size());
+    EXPECT_EQ("100", diagnostics[0]);
+    EXPECT_EQ("50", diagnostics[1]);
+    EXPECT_EQ("0", diagnostics[2]);
+    EXPECT_EQ("0", diagnostics[3]);
+    EXPECT_EQ("0", diagnostics[4]);
+    EXPECT_EQ("50", diagnostics[5]);
+    EXPECT_EQ(std::to_string(pDevice->m_asyncVariableIn0.getDroppedCount()), diagnostics[6]);
+    EXPECT_EQ(std::to_string(pDevice->m_asyncVariableIn0.getDeliveredCount()), diagnostics[7]);
+    EXPECT_EQ(diagnostics[6], diagnostics[8]);
+
+    pInterface->setPushDelay(0);
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testPVs, testPushBatch)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    const std::int32_t* pPushedValue;
+    const timespec* pPushedTimestamp;
+
+    {
+        nds::PushBatch batch;
+        for(std::int32_t pushValue(0); pushValue != 5; ++pushValue)
+        {
+            timespec timestamp = {pushValue, 0};
+            pDevice->m_variableIn0.push(timestamp, pushValue);
+        }
+
+        // Nested batches are collected by the outer one
+        ////////////////////////////////////////////////
+        {
+            nds::PushBatch nestedBatch;
+            timespec timestamp = {5, 0};
+            pDevice->m_variableIn0.push(timestamp, (std::int32_t)5);
+        }
+
+        // Nothing delivered yet
+        ////////////////////////
+        EXPECT_THROW(pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue), std::runtime_error);
+    }
+
+    // All the values delivered in one call
+    ///////////////////////////////////////
+    EXPECT_EQ(6u, pInterface->getLastBatchSize());
+    for(std::int32_t pushValue(0); pushValue != 6; ++pushValue)
+    {
+        pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+        EXPECT_EQ(pushValue, pPushedTimestamp->tv_sec);
+        EXPECT_EQ(pushValue, *pPushedValue);
+    }
+    EXPECT_EQ(6u, pDevice->m_variableIn0.getDeliveredCount());
+
+    // On a synchronous port the errors of the control system reach the
+    //  pushing thread as they do without a batch
+    ////////////////////////////////////////////////////////////////////
+    pInterface->setPushError(true);
+    timespec errorTimestamp = {20, 0};
+    EXPECT_THROW(pDevice->m_variableIn0.push(errorTimestamp, (std::int32_t)20), std::runtime_error);
+    {
+        nds::PushBatch batch;
+        pDevice->m_variableIn0.push(errorTimestamp, (std::int32_t)21);
+        EXPECT_THROW(batch.flush(), std::runtime_error);
+
+        // The batch keeps collecting after the error
+        /////////////////////////////////////////////
+        pInterface->setPushError(false);
+        pDevice->m_variableIn0.push(errorTimestamp, (std::int32_t)22);
+        EXPECT_THROW(pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue), std::runtime_error);
+    }
+    pInterface->getPushedInt32("/rootNode-Channel1.variableIn0", pPushedTimestamp, pPushedValue);
+    EXPECT_EQ(22, *pPushedValue);
+
+    // The destructor logs the errors instead of throwing
+    /////////////////////////////////////////////////////
+    pInterface->setPushError(true);
+    EXPECT_NO_THROW(
+    {
+        nds::PushBatch batch;
+        pDevice->m_variableIn0.push(errorTimestamp, (std::int32_t)23);
+    });
+    pInterface->setPushError(false);
+
+    // Batches are also used by the asynchronous dispatcher
+    ///////////////////////////////////////////////////////
+    nds::tests::TestControlSystemInterfaceImpl* pAsyncInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-AsyncChannel");
+    {
+        nds::PushBatch batch;
+        for(std::int32_t pushValue(0); pushValue != 10; ++pushValue)
+        {
+            timespec timestamp = {pushValue, 0};
+            pDevice->m_asyncVariableIn0.push(timestamp, pushValue);
+        }
+    }
+    ::sleep(1);
+    for(std::int32_t pushValue(0); pushValue != 10; ++pushValue)
+    {
+        pAsyncInterface->getPushedInt32("/rootNode-AsyncChannel.asyncVariableIn0", pPushedTimestamp, pPushedValue);
+        EXPECT_EQ(pushValue, *pPushedValue);
+    }
+
+    factory.destroyDevice("rootNode");
+}
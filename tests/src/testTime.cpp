@@ -1,4 +1,8 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <time.h>
 #include <nds3/nds.h>
 #include "testDevice.h"
 #include "ndsTestInterface.h"
@@ -39,3 +43,124 @@ TEST(testTime, testDelegate)
     factory.destroyDevice("rootNode");
 
 }
+
+namespace
+{
+
+timespec getFixedTime()
+{
+    timespec time = {1000, 20};
+    return time;
+}
+
+double secondsBetween(const timespec& first, const timespec& second)
+{
+    return (double)(second.tv_sec - first.tv_sec) + (double)(second.tv_nsec - first.tv_nsec) / 1e9;
+}
+
+}
+
+TEST(testTime, testClockSources)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+    nds::tests::TestControlSystemInterfaceImpl* pInterface = nds::tests::TestControlSystemInterfaceImpl::getInstance("rootNode-Channel1");
+
+    // The PV uses the delegate declared by Channel1
+    ////////////////////////////////////////////////
+    timespec timestamp = {0, 0};
+    pInterface->writeCSValue("/rootNode-Channel1.setCurrentTime", timestamp, (std::int32_t)500);
+    timestamp = pDevice->m_variableIn0.getTimestamp();
+    EXPECT_EQ(500, timestamp.tv_sec);
+    EXPECT_EQ(510, timestamp.tv_nsec);
+
+    // The built-in clocks return the UNIX epoch
+    ////////////////////////////////////////////
+    timespec systemTime;
+    clock_gettime(CLOCK_REALTIME, &systemTime);
+
+    pDevice->m_variableIn0.setTimestampClock(nds::timestampClock_t::realtime);
+    EXPECT_GT(1.0, std::abs(secondsBetween(systemTime, pDevice->m_variableIn0.getTimestamp())));
+
+    pDevice->m_variableIn0.setTimestampClock(nds::timestampClock_t::monotonicRaw);
+    EXPECT_GT(1.0, std::abs(secondsBetween(systemTime, pDevice->m_variableIn0.getTimestamp())));
+
+    pDevice->m_variableIn0.setTimestampClock(nds::timestampClock_t::realtimeCoarse);
+    EXPECT_GT(1.0, std::abs(secondsBetween(systemTime, pDevice->m_variableIn0.getTimestamp())));
+
+    // TAI is ahead of UTC by the leap seconds, if the system knows them
+    ////////////////////////////////////////////////////////////////////
+    pDevice->m_variableIn0.setTimestampClock(nds::timestampClock_t::tai);
+    EXPECT_GT(60.0, std::abs(secondsBetween(systemTime, pDevice->m_variableIn0.getTimestamp())));
+
+    // An empty delegate restores the parent's source
+    /////////////////////////////////////////////////
+    pDevice->m_variableIn0.setTimestampDelegate(nds::getTimestampPlugin_t());
+    timestamp = pDevice->m_variableIn0.getTimestamp();
+    EXPECT_EQ(500, timestamp.tv_sec);
+    EXPECT_EQ(510, timestamp.tv_nsec);
+
+    // A delegate set on an initialized node reaches its children
+    /////////////////////////////////////////////////////////////
+    const timespec* pStateMachineSwitchTime;
+    const std::int32_t* pStateMachineState;
+    pInterface->getPushedInt32("/rootNode-Channel1.data.StateMachine.getState", pStateMachineSwitchTime, pStateMachineState);
+    EXPECT_EQ((std::int32_t)nds::state_t::off, *pStateMachineState);
+
+    pDevice->m_dataAcquisition.setTimestampDelegate(getFixedTime);
+    pInterface->writeCSValue("/rootNode-Channel1.data.StateMachine.setState", timestamp, (std::int32_t)nds::state_t::on);
+
+    pInterface->getPushedInt32("/rootNode-Channel1.data.StateMachine.getState", pStateMachineSwitchTime, pStateMachineState);
+    EXPECT_EQ((std::int32_t)nds::state_t::initializing, *pStateMachineState);
+    EXPECT_EQ(1000, pStateMachineSwitchTime->tv_sec);
+    EXPECT_EQ(20, pStateMachineSwitchTime->tv_nsec);
+
+    // Wait for the switch on state (it should take one second)
+    ///////////////////////////////////////////////////////////
+    ::sleep(2);
+
+    factory.destroyDevice("rootNode");
+}
+
+TEST(testTime, testChangeSourceWhileReading)
+{
+    nds::Factory factory("test");
+
+    factory.createDevice("testDevice", "rootNode", nds::namedParameters_t());
+
+    TestDevice* pDevice = TestDevice::getInstance("rootNode");
+
+    // A thread reads the timestamps while the source of the node changes
+    /////////////////////////////////////////////////////////////////////
+    pDevice->m_dataAcquisition.setTimestampClock(nds::timestampClock_t::realtime);
+    std::atomic<bool> bReading(true);
+    size_t wrongTimestamps(0);
+    std::thread readThread([&]()
+    {
+        timespec systemTime;
+        clock_gettime(CLOCK_REALTIME, &systemTime);
+        while(bReading.load())
+        {
+            const timespec timestamp(pDevice->m_dataAcquisition.getTimestamp());
+            const bool bFixedTime(timestamp.tv_sec == 1000 && timestamp.tv_nsec == 20);
+            if(!bFixedTime && std::abs(secondsBetween(systemTime, timestamp)) > 60.0)
+            {
+                ++wrongTimestamps;
+            }
+        }
+    });
+
+    for(size_t changeSource(0); changeSource != 10000; ++changeSource)
+    {
+        pDevice->m_dataAcquisition.setTimestampDelegate(getFixedTime);
+        pDevice->m_dataAcquisition.setTimestampClock(nds::timestampClock_t::realtime);
+    }
+    bReading.store(false);
+    readThread.join();
+    EXPECT_EQ(0u, wrongTimestamps);
+
+    factory.destroyDevice("rootNode");
+}